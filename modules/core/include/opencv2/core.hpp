@@ -2009,6 +2009,29 @@ stores the indices of sorted elements in the output array. For example:
 */
 CV_EXPORTS_W void sortIdx(InputArray src, OutputArray dst, int flags);
 
+/** @brief Finds the k largest (or smallest) elements of each row or each column of a matrix.
+
+The function cv::topK selects the k first elements of each matrix row or column in the order
+given by the flags, without sorting the whole row or column. The selected elements are
+stored in the sorted order, equal elements keep the order of their indices. For example:
+@code
+    Mat scores(1000, 100000, CV_32F), values, indices;
+    randu(scores, 0, 1);
+    // the 100 best scores of each row and their column indices
+    topK(scores, values, indices, 100, SORT_EVERY_ROW + SORT_DESCENDING);
+@endcode
+@param src input single-channel array.
+@param values output array of the same type as src with k columns (#SORT_EVERY_ROW)
+or k rows (#SORT_EVERY_COLUMN). Can be omitted with noArray() if only the indices are needed.
+@param indices output integer (CV_32S) array of the same size as values with the indices of the
+selected elements inside of the row or column. Can be omitted with noArray().
+@param k number of the elements to select, 0 < k <= length of the row (column).
+@param flags operation flags, a combination of #SortFlags
+@sa sort, sortIdx
+*/
+CV_EXPORTS_W void topK(InputArray src, OutputArray values, OutputArray indices, int k,
+                       int flags = SORT_EVERY_ROW + SORT_DESCENDING);
+
 /** @brief Finds the real roots of a cubic equation.
 
 The function solveCubic finds the real roots of a cubic equation:
@@ -2387,6 +2410,76 @@ as getOptimalDFTSize((vecsize+1)/2)\*2.
 */
 CV_EXPORTS_W int getOptimalDFTSize(int vecsize);
 
+/** @brief Reusable plan of a discrete Fourier transform of a fixed size, type and flags.
+
+cv::dft has to factorize the transform length, compute the twiddle factor tables and allocate
+scratch buffers on every call. When many transforms of the same geometry are computed (e.g. in
+phase correlation or template matching loops), this setup can take a noticeable part of the time.
+The class performs it once, in the constructor, and then applies the transform to any number of
+arrays of the matching size and type:
+@code
+    DFTPlan fwd(img.size(), CV_32FC1, DFT_COMPLEX_OUTPUT);
+    DFTPlan inv(img.size(), CV_32FC2, DFT_INVERSE | DFT_SCALE | DFT_REAL_OUTPUT);
+    for (...)
+    {
+        fwd.apply(frame, spectrum);
+        mulSpectrums(spectrum, templSpectrum, spectrum, 0, true);
+        inv.apply(spectrum, response);
+    }
+@endcode
+The results are identical to the ones of dft called with the same flags. Both the row and the
+column passes of the transform are split between the available threads for large enough arrays.
+
+A plan object keeps scratch buffers, so it must not be used from several threads simultaneously;
+create a plan per thread instead.
+@sa dft, idft, mulSpectrums, getOptimalDFTSize
+*/
+class CV_EXPORTS DFTPlan
+{
+public:
+    /** @brief Creates an empty plan. Call DFTPlan::create before use. */
+    DFTPlan();
+
+    /** @overload
+    @param size size of the input (and output) arrays.
+    @param type type of the input arrays: CV_32FC1, CV_32FC2, CV_64FC1 or CV_64FC2.
+    @param flags transformation flags, the same as in dft (see #DftFlags).
+    @param nonzeroRows the same as in dft.
+    */
+    DFTPlan(Size size, int type, int flags = 0, int nonzeroRows = 0);
+
+    /** @brief Initializes the plan for the given transform geometry (see the constructor). */
+    void create(Size size, int type, int flags = 0, int nonzeroRows = 0);
+
+    /** @brief Computes the planned transform of src.
+    @param src input array of the planned size and type.
+    @param dst output array; it is reallocated if needed to the planned size and DFTPlan::dstType.
+    The transform can be done in-place.
+    */
+    void apply(InputArray src, OutputArray dst);
+
+    /** @brief Computes the planned transform of each array in a batch.
+    @param src vector of input arrays, each of the planned size and type.
+    @param dst vector of output arrays of the same length as src.
+    */
+    void applyBatch(InputArrayOfArrays src, OutputArrayOfArrays dst);
+
+    /** @brief Returns true if the plan has not been created. */
+    bool empty() const;
+    /** @brief Returns the planned input size. */
+    Size size() const;
+    /** @brief Returns the planned input type. */
+    int type() const;
+    /** @brief Returns the type of the transform output. */
+    int dstType() const;
+    /** @brief Returns the transformation flags the plan was created with. */
+    int flags() const;
+
+    struct Impl;
+protected:
+    Ptr<Impl> p;
+};
+
 /** @brief Returns the default random number generator.
 
 The function cv::theRNG returns the default random number generator. For each thread, there is a
@@ -3118,6 +3211,66 @@ CV_EXPORTS_W double kmeans( InputArray data, int K, InputOutputArray bestLabels,
                             TermCriteria criteria, int attempts,
                             int flags, OutputArray centers = noArray() );
 
+/** @brief Mini-batch k-means clustering of a data stream.
+
+The class implements the mini-batch variant of k-means (D. Sculley, "Web-scale k-means clustering",
+2010). Samples are fed in chunks with update(), so the whole data set never needs to be in memory.
+Every sample of a chunk is assigned to the nearest center, and the center is then moved towards it
+with the per-center learning rate 1/n, where n is the number of samples assigned to that center so
+far. The centers are initialized from the first chunk, with k-means++ (#KMEANS_PP_CENTERS) or
+uniformly at random (#KMEANS_RANDOM_CENTERS).
+@code
+    MiniBatchKMeans mbk(1000);
+    for (;;)
+    {
+        Mat descriptors = readNextChunk(); // CV_32F, one descriptor per row
+        if (descriptors.empty())
+            break;
+        mbk.update(descriptors);
+    }
+    Mat vocabulary = mbk.centers();
+@endcode
+@sa kmeans
+*/
+class CV_EXPORTS MiniBatchKMeans
+{
+public:
+    /** @brief Creates an empty object. */
+    MiniBatchKMeans();
+
+    /** @brief Creates the clusterer.
+    @param K Number of clusters.
+    @param flags Centers initialization, #KMEANS_PP_CENTERS or #KMEANS_RANDOM_CENTERS.
+    */
+    explicit MiniBatchKMeans(int K, int flags = KMEANS_PP_CENTERS);
+
+    /** @brief Updates the centers with a chunk of samples.
+    @param batch Samples in the same layouts as accepted by cv::kmeans. The first batch must contain
+    at least K samples; all batches must have the same dimensionality.
+    */
+    void update(InputArray batch);
+
+    /** @brief Assigns the samples to the nearest centers.
+    @param data Samples to label.
+    @param labels Output CV_32SC1 column of center indices.
+    @return The compactness measure of the samples with respect to the current centers.
+    */
+    double predict(InputArray data, OutputArray labels) const;
+
+    /** @brief Returns the current centers, one row per center (CV_32F). Empty before the first update(). */
+    Mat centers() const;
+
+    /** @brief Returns the number of samples consumed by update() so far. */
+    int64 samplesSeen() const;
+
+    /** @brief Returns true if the object was default-constructed. */
+    bool empty() const;
+
+    struct Impl;
+protected:
+    Ptr<Impl> p;
+};
+
 //! @} core_cluster
 
 //! @addtogroup core_basic
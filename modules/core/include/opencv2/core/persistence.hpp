@@ -319,6 +319,20 @@ public:
 
         BASE64      = 64,     //!< flag, write rawdata in Base64 by default. (consider using WRITE_BASE64)
         WRITE_BASE64 = BASE64 | WRITE, //!< flag, enable both WRITE and BASE64
+        MEMORY_MAPPED = 128,  /**< flag, read the file through a memory mapping instead of buffered
+                                   I/O. Base64-encoded sequences (e.g. the data of matrices written with
+                                   BASE64) are not expanded into nodes while parsing: they are decoded
+                                   on access, directly into the destination when read with
+                                   FileNode::readRaw or as a Mat. The mapping is kept until the storage
+                                   is released. Only Base64 blocks are loaded lazily: plain-text
+                                   sequences and maps are still parsed eagerly (the mapping merely
+                                   replaces the file reads). Ignored for writing, for compressed files
+                                   and on platforms without filesystem support. */
+        BINARY_SIDECAR = 256, /**< flag, write raw data (e.g. the data of matrices) uncompressed into the
+                                   binary file `<filename>.bin` next to the storage, the storage itself keeps
+                                   Base64-encoded references to the 64-byte aligned blocks of it. Implies
+                                   BASE64, not compatible with MEMORY. The sidecar file is located by the
+                                   name of the storage when reading, with MEMORY_MAPPED it is mapped too. */
     };
     enum State
     {
@@ -62,6 +62,34 @@ private:
     FileLock& operator=(const FileLock&); // disabled
 };
 
+
+/**
+ * Read-only memory mapping of a whole file.
+ *
+ * The mapped pages are shared with the OS page cache (and other processes mapping the same file),
+ * so the file content is not copied into the process heap. The mapped memory must not be written to.
+ * Platform dependent.
+ *
+ * The mapping is released in destructor: pointers obtained via data() must not be used after that.
+ */
+class CV_EXPORTS MappedFile {
+public:
+    explicit MappedFile(const char* fname); ///< maps the file, check isOpened() for the result
+    ~MappedFile();
+
+    bool isOpened() const;
+    const uchar* data() const; ///< start of the mapped file content
+    size_t size() const; ///< size of the file in bytes
+
+    struct Impl;
+protected:
+    Impl* pImpl;
+
+private:
+    MappedFile(const MappedFile&); // disabled
+    MappedFile& operator=(const MappedFile&); // disabled
+};
+
 }}} // namespace
 #endif
 #endif // OPENCV_UTILS_FILESYSTEM_PRIVATE_HPP
@@ -36,6 +36,27 @@ PERF_TEST_P(Size_MatType_FlagsType_NzeroRows, dft, TEST_MATS_DFT)
     SANITY_CHECK(dst, 1e-5, ERROR_RELATIVE);
 }
 
+PERF_TEST_P(Size_MatType_FlagsType_NzeroRows, dft_plan, TEST_MATS_DFT)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    int flags = get<2>(GetParam());
+    bool isNzeroRows = get<3>(GetParam());
+
+    int nonzero_rows = isNzeroRows ? sz.height/2 : 0;
+
+    Mat src(sz, type);
+    Mat dst(sz, type);
+
+    declare.in(src, WARMUP_RNG).time(60);
+
+    DFTPlan plan(sz, type, flags, nonzero_rows);
+
+    TEST_CYCLE() plan.apply(src, dst);
+
+    SANITY_CHECK_NOTHING();
+}
+
 ///////////////////////////////////////////////////////dct//////////////////////////////////////////////////////
 
 CV_ENUM(DCT_FlagsType, 0, DCT_INVERSE , DCT_ROWS, DCT_INVERSE|DCT_ROWS)
@@ -47,4 +47,25 @@ PERF_TEST_P(sortIdxFixture, sorIdx, TYPICAL_MATS_SORT)
     SANITY_CHECK_NOTHING();
 }
 
+typedef tuple<Size, MatType, int> topKParams;
+typedef TestBaseWithParam<topKParams> topKFixture;
+
+PERF_TEST_P(topKFixture, topK, testing::Combine(
+                testing::Values(Size(100000, 64), Size(1000, 1000)),
+                testing::Values(CV_32FC1, CV_8UC1),
+                testing::Values(10, 100)))
+{
+    const topKParams params = GetParam();
+    const Size sz = get<0>(params);
+    const int type = get<1>(params), k = get<2>(params);
+
+    cv::Mat a(sz, type), values, indices;
+
+    declare.in(a, WARMUP_RNG).out(values, indices);
+
+    TEST_CYCLE() cv::topK(a, values, indices, k, SORT_EVERY_ROW | SORT_DESCENDING);
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
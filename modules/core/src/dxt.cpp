@@ -1259,11 +1259,16 @@ RealDFT(const OcvDftOptions & c, const T* src, T* dst)
         T scale2 = scale*(T)0.5;
         int n2 = n >> 1;
 
-        c.factors[0] >>= 1;
+        // work on a private copy of the factor table so that the same
+        // context can be applied concurrently (see rowDft/colDft)
+        int sub_factors[34];
+        CV_DbgAssert( c.nf <= 34 );
+        memcpy(sub_factors, c.factors, c.nf*sizeof(sub_factors[0]));
+        sub_factors[0] >>= 1;
 
         OcvDftOptions sub_c = c;
-        sub_c.factors += (c.factors[0] == 1);
-        sub_c.nf -= (c.factors[0] == 1);
+        sub_c.factors = sub_factors + (sub_factors[0] == 1);
+        sub_c.nf -= (sub_factors[0] == 1);
         sub_c.isComplex = false;
         sub_c.isInverse = false;
         sub_c.noPermute = false;
@@ -1272,8 +1277,6 @@ RealDFT(const OcvDftOptions & c, const T* src, T* dst)
 
         DFT(sub_c, (Complex<T>*)src, (Complex<T>*)dst);
 
-        c.factors[0] <<= 1;
-
         t = dst[0] - dst[1];
         dst[0] = (dst[0] + dst[1])*scale;
         dst[1] = t*scale;
@@ -1474,11 +1477,16 @@ CCSIDFT(const OcvDftOptions & c, const T* src, T* dst)
             }
         }
 
-        c.factors[0] >>= 1;
+        // work on a private copy of the factor table so that the same
+        // context can be applied concurrently (see rowDft/colDft)
+        int sub_factors[34];
+        CV_DbgAssert( c.nf <= 34 );
+        memcpy(sub_factors, c.factors, c.nf*sizeof(sub_factors[0]));
+        sub_factors[0] >>= 1;
 
         OcvDftOptions sub_c = c;
-        sub_c.factors += (c.factors[0] == 1);
-        sub_c.nf -= (c.factors[0] == 1);
+        sub_c.factors = sub_factors + (sub_factors[0] == 1);
+        sub_c.nf -= (sub_factors[0] == 1);
         sub_c.isComplex = false;
         sub_c.isInverse = false;
         sub_c.noPermute = !inplace;
@@ -1487,8 +1495,6 @@ CCSIDFT(const OcvDftOptions & c, const T* src, T* dst)
 
         DFT(sub_c, (Complex<T>*)dst, (Complex<T>*)dst);
 
-        c.factors[0] <<= 1;
-
         for( j = 0; j < n; j += 2 )
         {
             t0 = dst[j]*scale;
@@ -2778,6 +2784,15 @@ inline DftDims determineDims(int rows, int cols, bool isRowWise, bool isContinuo
     return InvalidDim;
 }
 
+class OcvDftBasicImpl;
+
+// true if the 1D context is the built-in implementation, which keeps no state in apply()
+// and therefore can be invoked concurrently from several threads
+static bool isReentrantDft1D(const hal::DFT1D* ctx);
+
+// minimal number of processed elements to split row/column passes between threads
+static const int DFT_PARALLEL_MIN_ELEMS = 1 << 14;
+
 class OcvDftImpl CV_FINAL : public hal::DFT2D
 {
 protected:
@@ -2800,11 +2815,14 @@ protected:
     bool useIpp;
     int src_channels;
     int dst_channels;
+    bool parallelA;
+    bool parallelB;
 
     AutoBuffer<uchar> tmp_bufA;
     AutoBuffer<uchar> tmp_bufB;
     AutoBuffer<uchar> buf0;
     AutoBuffer<uchar> buf1;
+    AutoBuffer<uchar> stripe_buf; // per-stripe scratch of the parallel row/column passes
 
 public:
     OcvDftImpl()
@@ -2825,6 +2843,8 @@ public:
         useIpp = false;
         src_channels = 0;
         dst_channels = 0;
+        parallelA = false;
+        parallelB = false;
     }
 
     void init(int _width, int _height, int _depth, int _src_channels, int _dst_channels, int flags, int _nonzero_rows)
@@ -2933,6 +2953,8 @@ public:
                 contextA = hal::DFT1D::create(len, count, depth, f, &needBufferA);
                 if (needBufferA)
                     tmp_bufA.allocate(len * complex_elem_size);
+                parallelA = count > 1 && (int64)len * count >= DFT_PARALLEL_MIN_ELEMS &&
+                            isReentrantDft1D(contextA.get());
             }
             else
             {
@@ -2946,6 +2968,8 @@ public:
 
                 buf0.allocate(len * complex_elem_size);
                 buf1.allocate(len * complex_elem_size);
+                parallelB = count > 4 && (int64)len * count >= DFT_PARALLEL_MIN_ELEMS &&
+                            isReentrantDft1D(contextB.get());
             }
         }
     }
@@ -3058,31 +3082,168 @@ protected:
         if( nz <= 0 || nz > count )
             nz = count;
 
-        int i;
-        for( i = 0; i < nz; i++ )
+        int nstripes = parallelA ? dftStripes(nz, (int64)len*nz) : 1;
+        if( nstripes > 1 )
+        {
+            size_t bufsize = needBufferA ? (size_t)len*complex_elem_size : 0;
+            RowDftInvoker body(this, src_data, src_step, dst_data, dst_step, nz, nstripes,
+                               dptr_offset, dst_full_len, stripeBuffers(nstripes, bufsize), bufsize);
+            parallel_for_(Range(0, nstripes), body, nstripes);
+        }
+        else
+            rowDftRange(src_data, src_step, dst_data, dst_step, 0, nz,
+                        dptr_offset, dst_full_len, tmp_bufA.data());
+
+        for( int i = nz; i < count; i++ )
+        {
+            uchar* dptr0 = dst_data + dst_step * i;
+            memset( dptr0, 0, dst_full_len );
+        }
+        if(isLastStage &&  mode == FwdRealToComplex)
+            complementComplexOutput(depth, dst_data, dst_step, len, nz, 1);
+    }
+
+    void rowDftRange(const uchar* src_data, size_t src_step, uchar* dst_data, size_t dst_step,
+                     int i0, int i1, int dptr_offset, int dst_full_len, uchar* tmpbuf) const
+    {
+        for( int i = i0; i < i1; i++ )
         {
             const uchar* sptr = src_data + src_step * i;
             uchar* dptr0 = dst_data + dst_step * i;
             uchar* dptr = dptr0;
 
             if( needBufferA )
-                dptr = tmp_bufA.data();
+                dptr = tmpbuf;
 
             contextA->apply(sptr, dptr);
 
             if( needBufferA )
                 memcpy( dptr0, dptr + dptr_offset, dst_full_len );
         }
+    }
 
-        for( ; i < count; i++ )
+    // transforms the column pairs [k0, k1) starting at sptr0/dptr0 (see colDft);
+    // b0 and b1 hold one column each, tb is the out-of-place output buffer (if needBufferB)
+    void colDftPairs(const uchar* sptr0, size_t src_step, uchar* dptr0, size_t dst_step,
+                     int k0, int k1, int ncols, uchar* b0, uchar* b1, uchar* tb) const
+    {
+        int len = height;
+        uchar *dbuf0 = b0, *dbuf1 = b1;
+        if( needBufferB )
         {
-            uchar* dptr0 = dst_data + dst_step * i;
-            memset( dptr0, 0, dst_full_len );
+            dbuf1 = tb;
+            dbuf0 = b1;
+        }
+
+        sptr0 += (size_t)k0*2*complex_elem_size;
+        dptr0 += (size_t)k0*2*complex_elem_size;
+        for( int k = k0; k < k1; k++ )
+        {
+            bool pair = 2*k + 1 < ncols;
+            if( pair )
+            {
+                CopyFrom2Columns( sptr0, src_step, b0, b1, len, complex_elem_size );
+                contextB->apply(b1, dbuf1);
+            }
+            else
+                CopyColumn( sptr0, src_step, b0, complex_elem_size, len, complex_elem_size );
+
+            contextB->apply(b0, dbuf0);
+
+            if( pair )
+                CopyTo2Columns( dbuf0, dbuf1, dptr0, dst_step, len, complex_elem_size );
+            else
+                CopyColumn( dbuf0, complex_elem_size, dptr0, dst_step, len, complex_elem_size );
+            sptr0 += 2*complex_elem_size;
+            dptr0 += 2*complex_elem_size;
         }
-        if(isLastStage &&  mode == FwdRealToComplex)
-            complementComplexOutput(depth, dst_data, dst_step, len, nz, 1);
     }
 
+    // the number of stripes to split `count` independent 1D transforms into
+    static int dftStripes(int count, int64 total_elems)
+    {
+        if( count < 2 || total_elems < DFT_PARALLEL_MIN_ELEMS )
+            return 1;
+        int nstripes = (int)std::min<int64>(total_elems / DFT_PARALLEL_MIN_ELEMS, (int64)count);
+        return std::max(std::min(nstripes, getNumThreads()), 1);
+    }
+
+    // returns nstripes consecutive scratch buffers of bufsize bytes each;
+    // the storage is kept between calls, so repeated transforms do not reallocate
+    uchar* stripeBuffers(int nstripes, size_t bufsize)
+    {
+        size_t total = (size_t)nstripes*bufsize;
+        if( stripe_buf.size() < total )
+            stripe_buf.allocate(total);
+        return stripe_buf.data();
+    }
+
+    // stripe s transforms rows [count*s/nstripes, count*(s+1)/nstripes)
+    class RowDftInvoker : public ParallelLoopBody
+    {
+    public:
+        RowDftInvoker(const OcvDftImpl* _impl, const uchar* _src, size_t _src_step,
+                      uchar* _dst, size_t _dst_step, int _count, int _nstripes,
+                      int _dptr_offset, int _dst_full_len, uchar* _buf, size_t _bufsize) :
+            impl(_impl), src(_src), src_step(_src_step), dst(_dst), dst_step(_dst_step),
+            count(_count), nstripes(_nstripes), dptr_offset(_dptr_offset),
+            dst_full_len(_dst_full_len), buf(_buf), bufsize(_bufsize) {}
+
+        void operator()(const Range& range) const CV_OVERRIDE
+        {
+            for( int s = range.start; s < range.end; s++ )
+            {
+                int i0 = (int)((int64)count*s/nstripes), i1 = (int)((int64)count*(s+1)/nstripes);
+                impl->rowDftRange(src, src_step, dst, dst_step, i0, i1,
+                                  dptr_offset, dst_full_len, buf + bufsize*s);
+            }
+        }
+
+    private:
+        const OcvDftImpl* impl;
+        const uchar* src;
+        size_t src_step;
+        uchar* dst;
+        size_t dst_step;
+        int count, nstripes, dptr_offset, dst_full_len;
+        uchar* buf;
+        size_t bufsize;
+    };
+
+    // stripe s transforms column pairs [npairs*s/nstripes, npairs*(s+1)/nstripes)
+    class ColDftInvoker : public ParallelLoopBody
+    {
+    public:
+        ColDftInvoker(const OcvDftImpl* _impl, const uchar* _src, size_t _src_step,
+                      uchar* _dst, size_t _dst_step, int _ncols, int _nstripes,
+                      uchar* _buf, size_t _colsize) :
+            impl(_impl), src(_src), src_step(_src_step), dst(_dst), dst_step(_dst_step),
+            ncols(_ncols), nstripes(_nstripes), buf(_buf), colsize(_colsize) {}
+
+        void operator()(const Range& range) const CV_OVERRIDE
+        {
+            int npairs = (ncols + 1)/2;
+            size_t bufsize = colsize*(impl->needBufferB ? 3 : 2);
+            for( int s = range.start; s < range.end; s++ )
+            {
+                int k0 = (int)((int64)npairs*s/nstripes), k1 = (int)((int64)npairs*(s+1)/nstripes);
+                uchar* b0 = buf + bufsize*s;
+                impl->colDftPairs(src, src_step, dst, dst_step, k0, k1, ncols,
+                                  b0, b0 + colsize, b0 + colsize*2);
+            }
+        }
+
+    private:
+        const OcvDftImpl* impl;
+        const uchar* src;
+        size_t src_step;
+        uchar* dst;
+        size_t dst_step;
+        int ncols, nstripes;
+        uchar* buf;
+        size_t colsize;
+    };
+
     void colDft(const uchar* src_data, size_t src_step, uchar* dst_data, size_t dst_step, int stage_src_channels, int stage_dst_channels, bool isLastStage)
     {
         int len = height;
@@ -3186,25 +3347,19 @@ protected:
             }
         }
 
-        for(int i = a; i < b; i += 2 )
+        // the remaining columns are processed in pairs, each pair independently of the others
+        int ncols = b - a, npairs = (ncols + 1)/2;
+        int nstripes = parallelB ? dftStripes(npairs, (int64)len*ncols) : 1;
+        if( nstripes > 1 )
         {
-            if( i+1 < b )
-            {
-                CopyFrom2Columns( sptr0, src_step, buf0.data(), buf1.data(), len, complex_elem_size );
-                contextB->apply(buf1.data(), dbuf1);
-            }
-            else
-                CopyColumn( sptr0, src_step, buf0.data(), complex_elem_size, len, complex_elem_size );
-
-            contextB->apply(buf0.data(), dbuf0);
-
-            if( i+1 < b )
-                CopyTo2Columns( dbuf0, dbuf1, dptr0, dst_step, len, complex_elem_size );
-            else
-                CopyColumn( dbuf0, complex_elem_size, dptr0, dst_step, len, complex_elem_size );
-            sptr0 += 2*complex_elem_size;
-            dptr0 += 2*complex_elem_size;
+            size_t colsize = (size_t)len*complex_elem_size;
+            ColDftInvoker body(this, sptr0, src_step, dptr0, dst_step, ncols, nstripes,
+                               stripeBuffers(nstripes, colsize*(needBufferB ? 3 : 2)), colsize);
+            parallel_for_(Range(0, nstripes), body, nstripes);
         }
+        else if( npairs > 0 )
+            colDftPairs(sptr0, src_step, dptr0, dst_step, 0, npairs, ncols,
+                        buf0.data(), buf1.data(), tmp_bufB.data());
         if(isLastStage && mode == FwdRealToComplex)
             complementComplexOutput(depth, dst_data, dst_step, count, len, 2);
     }
@@ -3373,6 +3528,13 @@ public:
     void free() {}
 };
 
+static bool isReentrantDft1D(const hal::DFT1D* ctx)
+{
+    // the built-in kernels only read the context; IPP contexts share a single work buffer
+    const OcvDftBasicImpl* impl = dynamic_cast<const OcvDftBasicImpl*>(ctx);
+    return impl != 0 && !impl->opt.useIpp;
+}
+
 struct ReplacementDFT1D : public hal::DFT1D
 {
     cvhalDFT *context;
@@ -3483,6 +3645,48 @@ Ptr<DFT2D> DFT2D::create(int width, int height, int depth,
 } // cv::
 
 
+namespace cv {
+
+static int dftDstType(int type, int flags)
+{
+    bool inv = (flags & DFT_INVERSE) != 0;
+    int depth = CV_MAT_DEPTH(type), cn = CV_MAT_CN(type);
+
+    CV_Assert( type == CV_32FC1 || type == CV_32FC2 || type == CV_64FC1 || type == CV_64FC2 );
+
+    // Fail if DFT_COMPLEX_INPUT is specified, but src is not 2 channels.
+    CV_Assert( !((flags & DFT_COMPLEX_INPUT) && cn != 2) );
+
+    if( !inv && cn == 1 && (flags & DFT_COMPLEX_OUTPUT) )
+        return CV_MAKETYPE(depth, 2);
+    if( inv && cn == 2 && (flags & DFT_REAL_OUTPUT) )
+        return depth;
+    return type;
+}
+
+static int dftHalFlags(bool isContinuous, bool isInplace, int flags)
+{
+    int f = 0;
+    if (isContinuous)
+        f |= CV_HAL_DFT_IS_CONTINUOUS;
+    if (flags & DFT_INVERSE)
+        f |= CV_HAL_DFT_INVERSE;
+    if (flags & DFT_ROWS)
+        f |= CV_HAL_DFT_ROWS;
+    if (flags & DFT_SCALE)
+        f |= CV_HAL_DFT_SCALE;
+    if (isInplace)
+        f |= CV_HAL_DFT_IS_INPLACE;
+    return f;
+}
+
+static int dftHalFlags(const Mat& src, const Mat& dst, int flags)
+{
+    return dftHalFlags(src.isContinuous() && dst.isContinuous(), src.data == dst.data, flags);
+}
+
+}
+
 void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
 {
     CV_INSTRUMENT_REGION();
@@ -3499,35 +3703,13 @@ void cv::dft( InputArray _src0, OutputArray _dst, int flags, int nonzero_rows )
 #endif
 
     Mat src0 = _src0.getMat(), src = src0;
-    bool inv = (flags & DFT_INVERSE) != 0;
-    int type = src.type();
     int depth = src.depth();
 
-    CV_Assert( type == CV_32FC1 || type == CV_32FC2 || type == CV_64FC1 || type == CV_64FC2 );
-
-    // Fail if DFT_COMPLEX_INPUT is specified, but src is not 2 channels.
-    CV_Assert( !((flags & DFT_COMPLEX_INPUT) && src.channels() != 2) );
-
-    if( !inv && src.channels() == 1 && (flags & DFT_COMPLEX_OUTPUT) )
-        _dst.create( src.size(), CV_MAKETYPE(depth, 2) );
-    else if( inv && src.channels() == 2 && (flags & DFT_REAL_OUTPUT) )
-        _dst.create( src.size(), depth );
-    else
-        _dst.create( src.size(), type );
+    _dst.create( src.size(), dftDstType(src.type(), flags) );
 
     Mat dst = _dst.getMat();
 
-    int f = 0;
-    if (src.isContinuous() && dst.isContinuous())
-        f |= CV_HAL_DFT_IS_CONTINUOUS;
-    if (inv)
-        f |= CV_HAL_DFT_INVERSE;
-    if (flags & DFT_ROWS)
-        f |= CV_HAL_DFT_ROWS;
-    if (flags & DFT_SCALE)
-        f |= CV_HAL_DFT_SCALE;
-    if (src.data == dst.data)
-        f |= CV_HAL_DFT_IS_INPLACE;
+    int f = dftHalFlags(src, dst, flags);
     Ptr<hal::DFT2D> c = hal::DFT2D::create(src.cols, src.rows, depth, src.channels(), dst.channels(), f, nonzero_rows);
     c->apply(src.data, src.step, dst.data, dst.step);
 }
@@ -3540,6 +3722,133 @@ void cv::idft( InputArray src, OutputArray dst, int flags, int nonzero_rows )
     dft( src, dst, flags | DFT_INVERSE, nonzero_rows );
 }
 
+//================== DFTPlan ======================
+
+namespace cv {
+
+struct DFTPlan::Impl
+{
+    Size size;
+    int type;
+    int dstType;
+    int flags;
+    int nonzeroRows;
+
+    // the transform context depends on the memory layout of the actual arguments,
+    // so it is (re)created lazily for the layout that was seen last
+    Ptr<hal::DFT2D> context;
+    int contextHalFlags;
+
+    Impl(Size _size, int _type, int _flags, int _nonzeroRows) :
+        size(_size), type(_type), dstType(dftDstType(_type, _flags)),
+        flags(_flags), nonzeroRows(_nonzeroRows), contextHalFlags(-1)
+    {
+        CV_Assert( size.width > 0 && size.height > 0 );
+        CV_Assert( nonzeroRows >= 0 );
+    }
+
+    void apply(const Mat& src, Mat& dst)
+    {
+        int f = dftHalFlags(src, dst, flags);
+        if( !context || f != contextHalFlags )
+        {
+            context = hal::DFT2D::create(size.width, size.height, CV_MAT_DEPTH(type),
+                                         CV_MAT_CN(type), CV_MAT_CN(dstType), f, nonzeroRows);
+            contextHalFlags = f;
+        }
+        context->apply(src.data, src.step, dst.data, dst.step);
+    }
+};
+
+DFTPlan::DFTPlan()
+{
+}
+
+DFTPlan::DFTPlan(Size size, int type, int flags, int nonzeroRows)
+{
+    create(size, type, flags, nonzeroRows);
+}
+
+void DFTPlan::create(Size size, int type, int flags, int nonzeroRows)
+{
+    CV_INSTRUMENT_REGION();
+
+    p = makePtr<Impl>(size, type, flags, nonzeroRows);
+
+    // build the factorization and twiddle tables now rather than on the first apply(),
+    // assuming the most common case of continuous out-of-place arrays
+    int f = dftHalFlags(true, false, flags);
+    p->context = hal::DFT2D::create(size.width, size.height, CV_MAT_DEPTH(type),
+                                    CV_MAT_CN(type), CV_MAT_CN(p->dstType), f, nonzeroRows);
+    p->contextHalFlags = f;
+}
+
+bool DFTPlan::empty() const
+{
+    return !p;
+}
+
+Size DFTPlan::size() const
+{
+    return p ? p->size : Size();
+}
+
+int DFTPlan::type() const
+{
+    return p ? p->type : -1;
+}
+
+int DFTPlan::dstType() const
+{
+    return p ? p->dstType : -1;
+}
+
+int DFTPlan::flags() const
+{
+    return p ? p->flags : 0;
+}
+
+void DFTPlan::apply(InputArray _src, OutputArray _dst)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( !empty() );
+    CV_Assert( _src.dims() <= 2 && _src.size() == p->size && _src.type() == p->type );
+
+    if( _dst.isUMat() )
+    {
+        // OpenCL transforms keep their own plan cache
+        dft(_src, _dst, p->flags, p->nonzeroRows);
+        return;
+    }
+
+    Mat src = _src.getMat();
+    _dst.create(p->size, p->dstType);
+    Mat dst = _dst.getMat();
+    p->apply(src, dst);
+}
+
+void DFTPlan::applyBatch(InputArrayOfArrays _src, OutputArrayOfArrays _dst)
+{
+    CV_INSTRUMENT_REGION();
+
+    CV_Assert( !empty() );
+    CV_Assert( _src.isMatVector() || _src.isUMatVector() || _src.isVector() );
+
+    int n = (int)_src.total();
+    _dst.create(n, 1, p->dstType, -1, true);
+    for( int i = 0; i < n; i++ )
+    {
+        Mat src = _src.getMat(i);
+        CV_Assert( src.dims <= 2 && src.size() == p->size && src.type() == p->type );
+        _dst.create(p->size, p->dstType, i, true);
+        Mat dst = _dst.getMat(i);
+        p->apply(src, dst);
+    }
+}
+
+} // cv::
+
 #ifdef HAVE_OPENCL
 
 namespace cv {
@@ -59,23 +59,35 @@ static void generateRandomCenter(int dims, const Vec2f* box, float* center, RNG&
         center[j] = ((float)rng*(1.f+margin*2.f)-margin)*(box[j][1] - box[j][0]) + box[j][0];
 }
 
+// k-means++ works with the samples split into fixed stripes (independent of the number of threads,
+// so that the result is reproducible), the sums of the distances are kept per stripe
+static const int KMEANS_PP_STRIPE_SIZE = 4096;
+
 class KMeansPPDistanceComputer : public ParallelLoopBody
 {
 public:
-    KMeansPPDistanceComputer(float *tdist2_, const Mat& data_, const float *dist_, int ci_) :
-        tdist2(tdist2_), data(data_), dist(dist_), ci(ci_)
+    KMeansPPDistanceComputer(float *tdist2_, double *tsum2_, const Mat& data_, const float *dist_, int ci_) :
+        tdist2(tdist2_), tsum2(tsum2_), data(data_), dist(dist_), ci(ci_)
     { }
 
     void operator()( const cv::Range& range ) const CV_OVERRIDE
     {
         CV_TRACE_FUNCTION();
-        const int begin = range.start;
-        const int end = range.end;
+        const int N = data.rows;
         const int dims = data.cols;
 
-        for (int i = begin; i<end; i++)
+        for (int s = range.start; s < range.end; s++)
         {
-            tdist2[i] = std::min(hal::normL2Sqr_(data.ptr<float>(i), data.ptr<float>(ci), dims), dist[i]);
+            const int begin = s*KMEANS_PP_STRIPE_SIZE;
+            const int end = std::min(begin + KMEANS_PP_STRIPE_SIZE, N);
+            double sum = 0;
+            for (int i = begin; i < end; i++)
+            {
+                float d = hal::normL2Sqr_(data.ptr<float>(i), data.ptr<float>(ci), dims);
+                tdist2[i] = dist ? std::min(d, dist[i]) : d;
+                sum += tdist2[i];
+            }
+            tsum2[s] = sum;
         }
     }
 
@@ -83,8 +95,9 @@ private:
     KMeansPPDistanceComputer& operator=(const KMeansPPDistanceComputer&); // = delete
 
     float *tdist2;
+    double *tsum2;
     const Mat& data;
-    const float *dist;
+    const float *dist; // distances to the closest chosen center or NULL for the first center
     const int ci;
 };
 
@@ -97,19 +110,23 @@ static void generateCentersPP(const Mat& data, Mat& _out_centers,
 {
     CV_TRACE_FUNCTION();
     const int dims = data.cols, N = data.rows;
+    const int nstripes = divUp(N, KMEANS_PP_STRIPE_SIZE);
+    const double nstripesHint = (double)divUp((size_t)(dims * N), CV_KMEANS_PARALLEL_GRANULARITY);
     cv::AutoBuffer<int, 64> _centers(K);
     int* centers = &_centers[0];
     cv::AutoBuffer<float, 0> _dist(N*3);
     float* dist = &_dist[0], *tdist = dist + N, *tdist2 = tdist + N;
+    cv::AutoBuffer<double, 64> _sums(nstripes*3);
+    double* sums = &_sums[0], *tsums = sums + nstripes, *tsums2 = tsums + nstripes;
     double sum0 = 0;
 
     centers[0] = (unsigned)rng % N;
 
-    for (int i = 0; i < N; i++)
-    {
-        dist[i] = hal::normL2Sqr_(data.ptr<float>(i), data.ptr<float>(centers[0]), dims);
-        sum0 += dist[i];
-    }
+    parallel_for_(Range(0, nstripes),
+                  KMeansPPDistanceComputer(dist, sums, data, NULL, centers[0]),
+                  std::min((double)nstripes, nstripesHint));
+    for (int s = 0; s < nstripes; s++)
+        sum0 += sums[s];
 
     for (int k = 1; k < K; k++)
     {
@@ -118,29 +135,37 @@ static void generateCentersPP(const Mat& data, Mat& _out_centers,
 
         for (int j = 0; j < trials; j++)
         {
+            // sample the next center with probability proportional to dist:
+            // find the stripe first, then the sample within it
             double p = (double)rng*sum0;
-            int ci = 0;
-            for (; ci < N - 1; ci++)
+            int s = 0;
+            for (; s < nstripes - 1; s++)
+            {
+                if (p <= sums[s])
+                    break;
+                p -= sums[s];
+            }
+            int ci = s*KMEANS_PP_STRIPE_SIZE;
+            for (int end = std::min(ci + KMEANS_PP_STRIPE_SIZE, N); ci < end - 1; ci++)
             {
                 p -= dist[ci];
                 if (p <= 0)
                     break;
             }
 
-            parallel_for_(Range(0, N),
-                          KMeansPPDistanceComputer(tdist2, data, dist, ci),
-                          (double)divUp((size_t)(dims * N), CV_KMEANS_PARALLEL_GRANULARITY));
-            double s = 0;
-            for (int i = 0; i < N; i++)
-            {
-                s += tdist2[i];
-            }
+            parallel_for_(Range(0, nstripes),
+                          KMeansPPDistanceComputer(tdist2, tsums2, data, dist, ci),
+                          std::min((double)nstripes, nstripesHint));
+            double sum = 0;
+            for (s = 0; s < nstripes; s++)
+                sum += tsums2[s];
 
-            if (s < bestSum)
+            if (sum < bestSum)
             {
-                bestSum = s;
+                bestSum = sum;
                 bestCenter = ci;
                 std::swap(tdist, tdist2);
+                std::swap(tsums, tsums2);
             }
         }
         if (bestCenter < 0)
@@ -148,6 +173,7 @@ static void generateCentersPP(const Mat& data, Mat& _out_centers,
         centers[k] = bestCenter;
         sum0 = bestSum;
         std::swap(dist, tdist);
+        std::swap(sums, tsums);
     }
 
     for (int k = 0; k < K; k++)
@@ -223,6 +249,196 @@ private:
     const Mat& centers;
 };
 
+/*
+Labels assignment with the triangle inequality pruning:
+G. Hamerly (2010) Making k-means even faster.
+upper[i] bounds the distance from the sample to its center from above, lower[i] bounds the distance
+to any other center from below. Each pass first moves the bounds by the center shifts of the last update,
+the sample keeps its label without computing any distance if the upper bound does not exceed the lower one
+or a half of the distance from its center to the closest other center (halfGap).
+With init == true all the distances are computed and the bounds are initialized.
+*/
+class KMeansHamerlyAssigner : public ParallelLoopBody
+{
+public:
+    KMeansHamerlyAssigner(int *labels_, double *upper_, double *lower_,
+                          const double *shift_, const double *halfGap_,
+                          const Mat& data_, const Mat& centers_, bool init_)
+        : labels(labels_), upper(upper_), lower(lower_), shift(shift_), halfGap(halfGap_),
+          data(data_), centers(centers_), init(init_), maxShiftIdx(0), maxShift(0), maxShift2(0)
+    {
+        if (!init)
+        {
+            for (int k = 0; k < centers.rows; k++)
+            {
+                if (shift[k] > maxShift)
+                {
+                    maxShift2 = maxShift;
+                    maxShift = shift[k];
+                    maxShiftIdx = k;
+                }
+                else
+                    maxShift2 = std::max(maxShift2, shift[k]);
+            }
+        }
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        const int K = centers.rows;
+        const int dims = centers.cols;
+
+        for (int i = range.start; i < range.end; ++i)
+        {
+            const float *sample = data.ptr<float>(i);
+            if (!init)
+            {
+                int a = labels[i];
+                upper[i] += shift[a];
+                lower[i] -= a == maxShiftIdx ? maxShift2 : maxShift;
+
+                double m = std::max(halfGap[a], lower[i]);
+                if (upper[i] <= m)
+                    continue;
+                upper[i] = std::sqrt((double)hal::normL2Sqr_(sample, centers.ptr<float>(a), dims));
+                if (upper[i] <= m)
+                    continue;
+            }
+
+            int k_best = 0;
+            double min_dist = DBL_MAX, min_dist2 = DBL_MAX;
+            for (int k = 0; k < K; k++)
+            {
+                const double dist = hal::normL2Sqr_(sample, centers.ptr<float>(k), dims);
+                if (min_dist > dist)
+                {
+                    min_dist2 = min_dist;
+                    min_dist = dist;
+                    k_best = k;
+                }
+                else if (min_dist2 > dist)
+                    min_dist2 = dist;
+            }
+            labels[i] = k_best;
+            upper[i] = std::sqrt(min_dist);
+            lower[i] = std::sqrt(min_dist2);
+        }
+    }
+
+private:
+    KMeansHamerlyAssigner& operator=(const KMeansHamerlyAssigner&); // = delete
+
+    int *labels;
+    double *upper;
+    double *lower;
+    const double *shift;
+    const double *halfGap;
+    const Mat& data;
+    const Mat& centers;
+    const bool init;
+    int maxShiftIdx;
+    double maxShift, maxShift2;
+};
+
+// halfGap[k] = 0.5 * (distance from the center k to the closest other center)
+class KMeansCenterGapComputer : public ParallelLoopBody
+{
+public:
+    KMeansCenterGapComputer(double *halfGap_, const Mat& centers_)
+        : halfGap(halfGap_), centers(centers_)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        const int K = centers.rows;
+        const int dims = centers.cols;
+        for (int k = range.start; k < range.end; k++)
+        {
+            double min_dist = DBL_MAX;
+            for (int k1 = 0; k1 < K; k1++)
+            {
+                if (k1 != k)
+                    min_dist = std::min(min_dist, (double)hal::normL2Sqr_(centers.ptr<float>(k), centers.ptr<float>(k1), dims));
+            }
+            halfGap[k] = 0.5*std::sqrt(min_dist);
+        }
+    }
+
+private:
+    KMeansCenterGapComputer& operator=(const KMeansCenterGapComputer&); // = delete
+
+    double *halfGap;
+    const Mat& centers;
+};
+
+// The samples are accumulated into the centers in parallel over the blocks of dimensions:
+// every element of the centers is summed in the same order as in the serial loop.
+static const int KMEANS_DIMS_BLOCK = 16;
+
+class KMeansCenterAccumulator : public ParallelLoopBody
+{
+public:
+    // eta == NULL: centers[labels[i]] += data[i],
+    // otherwise centers[labels[i]] += (data[i] - centers[labels[i]])*eta[i] (mini-batch update)
+    KMeansCenterAccumulator(Mat& centers_, const Mat& data_, const int *labels_, const float *eta_)
+        : centers(centers_), data(data_), labels(labels_), eta(eta_)
+    {
+    }
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        CV_TRACE_FUNCTION();
+        const int N = data.rows;
+        const int j0 = range.start*KMEANS_DIMS_BLOCK;
+        const int j1 = std::min(range.end*KMEANS_DIMS_BLOCK, data.cols);
+
+        for (int i = 0; i < N; i++)
+        {
+            const float* sample = data.ptr<float>(i);
+            float* center = centers.ptr<float>(labels[i]);
+            if (!eta)
+            {
+                for (int j = j0; j < j1; j++)
+                    center[j] += sample[j];
+            }
+            else
+            {
+                const float e = eta[i];
+                for (int j = j0; j < j1; j++)
+                    center[j] += (sample[j] - center[j])*e;
+            }
+        }
+    }
+
+private:
+    KMeansCenterAccumulator& operator=(const KMeansCenterAccumulator&); // = delete
+
+    Mat& centers;
+    const Mat& data;
+    const int *labels;
+    const float *eta;
+};
+
+static void accumulateCenters(Mat& centers, const Mat& data, const int* labels, const float* eta)
+{
+    const int nblocks = divUp(data.cols, KMEANS_DIMS_BLOCK);
+    parallel_for_(Range(0, nblocks), KMeansCenterAccumulator(centers, data, labels, eta),
+                  std::min((double)nblocks, (double)divUp((size_t)data.cols * data.rows, CV_KMEANS_PARALLEL_GRANULARITY)));
+}
+
+// N x dims CV_32F header of the samples (one sample per row or per element of a single row)
+static Mat getKMeansSamples(InputArray _data)
+{
+    Mat data0 = _data.getMat();
+    const bool isrow = data0.rows == 1;
+    const int N = isrow ? data0.cols : data0.rows;
+    const int dims = (isrow ? 1 : data0.cols)*data0.channels();
+    CV_Assert( data0.dims <= 2 && data0.depth() == CV_32F );
+    return Mat(N, dims, CV_32F, data0.ptr(), isrow ? dims * sizeof(float) : static_cast<size_t>(data0.step));
+}
+
 }
 
 double cv::kmeans( InputArray _data, int K,
@@ -232,18 +448,15 @@ double cv::kmeans( InputArray _data, int K,
 {
     CV_INSTRUMENT_REGION();
     const int SPP_TRIALS = 3;
-    Mat data0 = _data.getMat();
-    const bool isrow = data0.rows == 1;
-    const int N = isrow ? data0.cols : data0.rows;
-    const int dims = (isrow ? 1 : data0.cols)*data0.channels();
-    const int type = data0.depth();
+    Mat data = getKMeansSamples(_data);
+    const int N = data.rows;
+    const int dims = data.cols;
+    const int type = data.depth();
 
     attempts = std::max(attempts, 1);
-    CV_Assert( data0.dims <= 2 && type == CV_32F && K > 0 );
+    CV_Assert( K > 0 );
     CV_CheckGE(N, K, "There can't be more clusters than elements");
 
-    Mat data(N, dims, CV_32F, data0.ptr(), isrow ? dims * sizeof(float) : static_cast<size_t>(data0.step));
-
     _bestLabels.create(N, 1, CV_32S, -1, true);
 
     Mat _labels, best_labels = _bestLabels.getMat();
@@ -276,6 +489,9 @@ double cv::kmeans( InputArray _data, int K,
     Mat centers(K, dims, type), old_centers(K, dims, type), temp(1, dims, type);
     cv::AutoBuffer<int, 64> counters(K);
     cv::AutoBuffer<double, 64> dists(N);
+    // bounds of the distances for the pruned labels assignment (see KMeansHamerlyAssigner)
+    cv::AutoBuffer<double, 64> upper(N), lower(N), shift(K), halfGap(K);
+    bool boundsValid = false;
     RNG& rng = theRNG();
 
     if (criteria.type & TermCriteria::EPS)
@@ -326,6 +542,9 @@ double cv::kmeans( InputArray _data, int K,
 
             swap(centers, old_centers);
 
+            if (iter == 0)
+                boundsValid = false;
+
             if (iter == 0 && (a > 0 || !(flags & KMEANS_USE_INITIAL_LABELS)))
             {
                 if (flags & KMEANS_PP_CENTERS)
@@ -344,14 +563,8 @@ double cv::kmeans( InputArray _data, int K,
                     counters[k] = 0;
 
                 for (int i = 0; i < N; i++)
-                {
-                    const float* sample = data.ptr<float>(i);
-                    int k = labels[i];
-                    float* center = centers.ptr<float>(k);
-                    for (int j = 0; j < dims; j++)
-                        center[j] += sample[j];
-                    counters[k]++;
-                }
+                    counters[labels[i]]++;
+                accumulateCenters(centers, data, labels, NULL);
 
                 for (int k = 0; k < K; k++)
                 {
@@ -394,6 +607,7 @@ double cv::kmeans( InputArray _data, int K,
                     counters[max_k]--;
                     counters[k]++;
                     labels[farthest_i] = k;
+                    lower[farthest_i] = 0; // the sample has to be re-assigned by the full search
 
                     const float* sample = data.ptr<float>(farthest_i);
                     float* cur_center = centers.ptr<float>(k);
@@ -423,6 +637,7 @@ double cv::kmeans( InputArray _data, int K,
                             dist += t*t;
                         }
                         max_center_shift = std::max(max_center_shift, dist);
+                        shift[k] = std::sqrt(dist);
                     }
                 }
             }
@@ -439,7 +654,12 @@ double cv::kmeans( InputArray _data, int K,
             else
             {
                 // assign labels
-                parallel_for_(Range(0, N), KMeansDistanceComputer<false>(dists.data(), labels, data, centers), (double)divUp((size_t)(dims * N * K), CV_KMEANS_PARALLEL_GRANULARITY));
+                parallel_for_(Range(0, K), KMeansCenterGapComputer(halfGap.data(), centers),
+                              (double)divUp((size_t)(dims * K * K), CV_KMEANS_PARALLEL_GRANULARITY));
+                parallel_for_(Range(0, N), KMeansHamerlyAssigner(labels, upper.data(), lower.data(), shift.data(),
+                                                                 halfGap.data(), data, centers, !boundsValid),
+                              (double)divUp((size_t)(dims * N * K), CV_KMEANS_PARALLEL_GRANULARITY));
+                boundsValid = true;
             }
         }
 
@@ -459,3 +679,123 @@ double cv::kmeans( InputArray _data, int K,
 
     return best_compactness;
 }
+
+////////////////////////////////////// mini-batch kmeans //////////////////////////////////////
+
+namespace cv
+{
+
+struct MiniBatchKMeans::Impl
+{
+    Impl(int K_, int flags_) : K(K_), flags(flags_), seen(0)
+    {
+        CV_Assert( K > 0 );
+    }
+
+    void init(const Mat& data)
+    {
+        const int N = data.rows, dims = data.cols;
+        CV_CheckGE(N, K, "The first batch must contain at least K samples");
+        RNG& rng = theRNG();
+        centers.create(K, dims, CV_32F);
+        if (flags & KMEANS_PP_CENTERS)
+            generateCentersPP(data, centers, K, rng, 3);
+        else
+        {
+            cv::AutoBuffer<Vec2f, 64> box(dims);
+            for (int j = 0; j < dims; j++)
+                box[j] = Vec2f(FLT_MAX, -FLT_MAX);
+            for (int i = 0; i < N; i++)
+            {
+                const float* sample = data.ptr<float>(i);
+                for (int j = 0; j < dims; j++)
+                {
+                    box[j][0] = std::min(box[j][0], sample[j]);
+                    box[j][1] = std::max(box[j][1], sample[j]);
+                }
+            }
+            for (int k = 0; k < K; k++)
+                generateRandomCenter(dims, box.data(), centers.ptr<float>(k), rng);
+        }
+        counts.assign(K, 0);
+    }
+
+    double assign(const Mat& data, int* labels) const
+    {
+        const int N = data.rows, dims = data.cols;
+        cv::AutoBuffer<double, 64> dists(N);
+        parallel_for_(Range(0, N), KMeansDistanceComputer<false>(dists.data(), labels, data, centers),
+                      (double)divUp((size_t)(dims * N * K), CV_KMEANS_PARALLEL_GRANULARITY));
+        double compactness = 0;
+        for (int i = 0; i < N; i++)
+            compactness += dists[i];
+        return compactness;
+    }
+
+    int K;
+    int flags;
+    Mat centers;
+    std::vector<int64> counts;
+    int64 seen;
+};
+
+MiniBatchKMeans::MiniBatchKMeans() {}
+
+MiniBatchKMeans::MiniBatchKMeans(int K, int flags)
+{
+    p = makePtr<Impl>(K, flags);
+}
+
+void MiniBatchKMeans::update(InputArray batch)
+{
+    CV_INSTRUMENT_REGION();
+    CV_Assert( !empty() );
+
+    Mat data = getKMeansSamples(batch);
+    const int N = data.rows;
+    if (N == 0)
+        return;
+    if (p->centers.empty())
+        p->init(data);
+    CV_CheckEQ(data.cols, p->centers.cols, "The samples dimensionality has changed");
+
+    // the per-center learning rate is 1/(number of samples assigned to the center so far),
+    // so that every center is the running mean of its samples (Sculley, 2010)
+    cv::AutoBuffer<int, 64> labels(N);
+    cv::AutoBuffer<float, 64> eta(N);
+    p->assign(data, labels.data());
+    for (int i = 0; i < N; i++)
+        eta[i] = (float)(1./(double)(++p->counts[labels[i]]));
+    accumulateCenters(p->centers, data, labels.data(), eta.data());
+    p->seen += N;
+}
+
+double MiniBatchKMeans::predict(InputArray _data, OutputArray _labels) const
+{
+    CV_INSTRUMENT_REGION();
+    CV_Assert( !empty() && !p->centers.empty() );
+
+    Mat data = getKMeansSamples(_data);
+    CV_CheckEQ(data.cols, p->centers.cols, "The samples dimensionality doesn't match the centers");
+    _labels.create(data.rows, 1, CV_32S);
+    Mat labels = _labels.getMat();
+    CV_Assert( labels.isContinuous() );
+    return data.rows > 0 ? p->assign(data, labels.ptr<int>()) : 0.;
+}
+
+Mat MiniBatchKMeans::centers() const
+{
+    return p ? p->centers : Mat();
+}
+
+int64 MiniBatchKMeans::samplesSeen() const
+{
+    return p ? p->seen : 0;
+}
+
+bool MiniBatchKMeans::empty() const
+{
+    return !p;
+}
+
+}
@@ -969,53 +969,219 @@ void cv::reduce(InputArray _src, OutputArray _dst, int dim, int op, int dtype)
 namespace cv
 {
 
-template<typename T> static void sort_( const Mat& src, Mat& dst, int flags )
+// Order-preserving mapping of the sort keys onto unsigned integers, so that
+// long lines can be sorted with a stable LSD radix sort instead of std::sort.
+template<typename T> struct SortKey;
+
+template<> struct SortKey<uchar>
 {
-    AutoBuffer<T> buf;
-    int n, len;
-    bool sortRows = (flags & 1) == SORT_EVERY_ROW;
-    bool inplace = src.data == dst.data;
-    bool sortDescending = (flags & SORT_DESCENDING) != 0;
+    typedef uchar type;
+    static inline type get(uchar v) { return v; }
+    static inline uchar restore(type k) { return k; }
+};
 
-    if( sortRows )
-        n = src.rows, len = src.cols;
-    else
+template<> struct SortKey<schar>
+{
+    typedef uchar type;
+    static inline type get(schar v) { return (uchar)(v ^ 0x80); }
+    static inline schar restore(type k) { return (schar)(k ^ 0x80); }
+};
+
+template<> struct SortKey<ushort>
+{
+    typedef ushort type;
+    static inline type get(ushort v) { return v; }
+    static inline ushort restore(type k) { return k; }
+};
+
+template<> struct SortKey<short>
+{
+    typedef ushort type;
+    static inline type get(short v) { return (ushort)(v ^ 0x8000); }
+    static inline short restore(type k) { return (short)(k ^ 0x8000); }
+};
+
+template<> struct SortKey<int>
+{
+    typedef unsigned type;
+    static inline type get(int v) { return (unsigned)v ^ 0x80000000u; }
+    static inline int restore(type k) { return (int)(k ^ 0x80000000u); }
+};
+
+template<> struct SortKey<float>
+{
+    typedef unsigned type;
+    static inline type get(float v)
+    {
+        Cv32suf u; u.f = v;
+        // negative values: flip all bits, positive values: flip the sign bit
+        return (unsigned)u.i ^ ((unsigned)(u.i >> 31) | 0x80000000u);
+    }
+    static inline float restore(type k)
     {
-        n = src.cols, len = src.rows;
-        buf.allocate(len);
+        Cv32suf u; u.u = (k & 0x80000000u) ? (k ^ 0x80000000u) : ~k;
+        return u.f;
     }
-    T* bptr = buf.data();
+};
 
-    for( int i = 0; i < n; i++ )
+template<> struct SortKey<double>
+{
+    typedef uint64 type;
+    static inline type get(double v)
     {
-        T* ptr = bptr;
-        if( sortRows )
+        Cv64suf u; u.f = v;
+        return (uint64)u.i ^ ((uint64)(u.i >> 63) | CV_BIG_UINT(0x8000000000000000));
+    }
+    static inline double restore(type k)
+    {
+        Cv64suf u; u.u = (k & CV_BIG_UINT(0x8000000000000000)) ? (k ^ CV_BIG_UINT(0x8000000000000000)) : ~k;
+        return u.f;
+    }
+};
+
+// Lines shorter than this are sorted with std::sort: the histogram passes
+// of the radix sort do not pay off there.
+enum { RADIX_SORT_MIN_LEN = 256 };
+
+// Stable LSD radix sort of 'len' keys (and, optionally, the attached indices)
+// by bytes. kbuf/ibuf are scratch buffers of the same size. Passes where all
+// keys share the same digit are skipped, so narrow value ranges are cheap.
+template<typename K> static void radixSort_( K* keys, int* idx, K* kbuf, int* ibuf, int len )
+{
+    const int npasses = (int)sizeof(K);
+    int hist[sizeof(K)][256];
+    memset(hist, 0, sizeof(hist));
+
+    for( int i = 0; i < len; i++ )
+    {
+        K k = keys[i];
+        for( int p = 0; p < npasses; p++ )
+            hist[p][(k >> (p*8)) & 255]++;
+    }
+
+    K* src = keys, *dst = kbuf;
+    int* isrc = idx, *idst = ibuf;
+    for( int p = 0; p < npasses; p++ )
+    {
+        int* h = hist[p];
+        int shift = p*8;
+        if( h[(src[0] >> shift) & 255] == len )
+            continue;
+        for( int b = 0, sum = 0; b < 256; b++ )
         {
-            T* dptr = dst.ptr<T>(i);
-            if( !inplace )
+            int c = h[b];
+            h[b] = sum;
+            sum += c;
+        }
+        if( isrc )
+        {
+            for( int i = 0; i < len; i++ )
             {
-                const T* sptr = src.ptr<T>(i);
-                memcpy(dptr, sptr, sizeof(T) * len);
+                K k = src[i];
+                int pos = h[(k >> shift) & 255]++;
+                dst[pos] = k;
+                idst[pos] = isrc[i];
             }
-            ptr = dptr;
         }
         else
         {
-            for( int j = 0; j < len; j++ )
-                ptr[j] = src.ptr<T>(j)[i];
+            for( int i = 0; i < len; i++ )
+            {
+                K k = src[i];
+                dst[h[(k >> shift) & 255]++] = k;
+            }
         }
+        std::swap(src, dst);
+        std::swap(isrc, idst);
+    }
+
+    if( src != keys )
+    {
+        memcpy(keys, src, len*sizeof(K));
+        if( idx )
+            memcpy(idx, isrc, len*sizeof(int));
+    }
+}
 
-        std::sort( ptr, ptr + len );
-        if( sortDescending )
+template<typename T> class SortInvoker : public ParallelLoopBody
+{
+public:
+    SortInvoker( const Mat& _src, Mat& _dst, int _flags )
+        : src(_src), dst(_dst), flags(_flags)
+    {}
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        typedef typename SortKey<T>::type K;
+        bool sortRows = (flags & 1) == SORT_EVERY_ROW;
+        bool inplace = src.data == dst.data;
+        bool sortDescending = (flags & SORT_DESCENDING) != 0;
+        int len = sortRows ? src.cols : src.rows;
+        bool useRadix = len >= RADIX_SORT_MIN_LEN;
+
+        AutoBuffer<T> buf(sortRows ? 1 : len);
+        AutoBuffer<K> kbuf(useRadix ? len*2 : 1);
+        T* bptr = buf.data();
+        K* keys = kbuf.data();
+
+        for( int i = range.start; i < range.end; i++ )
         {
-            for( int j = 0; j < len/2; j++ )
-                std::swap(ptr[j], ptr[len-1-j]);
-        }
+            T* ptr = bptr;
+            if( sortRows )
+            {
+                T* dptr = dst.ptr<T>(i);
+                if( !inplace )
+                {
+                    const T* sptr = src.ptr<T>(i);
+                    memcpy(dptr, sptr, sizeof(T) * len);
+                }
+                ptr = dptr;
+            }
+            else
+            {
+                for( int j = 0; j < len; j++ )
+                    ptr[j] = src.ptr<T>(j)[i];
+            }
 
-        if( !sortRows )
-            for( int j = 0; j < len; j++ )
-                dst.ptr<T>(j)[i] = ptr[j];
+            if( useRadix )
+            {
+                for( int j = 0; j < len; j++ )
+                    keys[j] = SortKey<T>::get(ptr[j]);
+                radixSort_(keys, (int*)0, keys + len, (int*)0, len);
+                if( sortDescending )
+                    for( int j = 0; j < len; j++ )
+                        ptr[j] = SortKey<T>::restore(keys[len-1-j]);
+                else
+                    for( int j = 0; j < len; j++ )
+                        ptr[j] = SortKey<T>::restore(keys[j]);
+            }
+            else
+            {
+                std::sort( ptr, ptr + len );
+                if( sortDescending )
+                {
+                    for( int j = 0; j < len/2; j++ )
+                        std::swap(ptr[j], ptr[len-1-j]);
+                }
+            }
+
+            if( !sortRows )
+                for( int j = 0; j < len; j++ )
+                    dst.ptr<T>(j)[i] = ptr[j];
+        }
     }
+
+private:
+    const Mat& src;
+    Mat& dst;
+    int flags;
+};
+
+template<typename T> static void sort_( const Mat& src, Mat& dst, int flags )
+{
+    bool sortRows = (flags & 1) == SORT_EVERY_ROW;
+    int n = sortRows ? src.rows : src.cols;
+    parallel_for_(Range(0, n), SortInvoker<T>(src, dst, flags), src.total()/(double)(1<<16));
 }
 
 #ifdef HAVE_IPP
@@ -1114,56 +1280,94 @@ public:
     const _Tp* arr;
 };
 
-template<typename T> static void sortIdx_( const Mat& src, Mat& dst, int flags )
+template<typename T> class SortIdxInvoker : public ParallelLoopBody
 {
-    AutoBuffer<T> buf;
-    AutoBuffer<int> ibuf;
-    bool sortRows = (flags & 1) == SORT_EVERY_ROW;
-    bool sortDescending = (flags & SORT_DESCENDING) != 0;
-
-    CV_Assert( src.data != dst.data );
-
-    int n, len;
-    if( sortRows )
-        n = src.rows, len = src.cols;
-    else
-    {
-        n = src.cols, len = src.rows;
-        buf.allocate(len);
-        ibuf.allocate(len);
-    }
-    T* bptr = buf.data();
-    int* _iptr = ibuf.data();
+public:
+    SortIdxInvoker( const Mat& _src, Mat& _dst, int _flags )
+        : src(_src), dst(_dst), flags(_flags)
+    {}
 
-    for( int i = 0; i < n; i++ )
+    void operator()( const Range& range ) const CV_OVERRIDE
     {
-        T* ptr = bptr;
-        int* iptr = _iptr;
-
-        if( sortRows )
-        {
-            ptr = (T*)(src.data + src.step*i);
-            iptr = dst.ptr<int>(i);
-        }
-        else
+        typedef typename SortKey<T>::type K;
+        bool sortRows = (flags & 1) == SORT_EVERY_ROW;
+        bool sortDescending = (flags & SORT_DESCENDING) != 0;
+        int len = sortRows ? src.cols : src.rows;
+        bool useRadix = len >= RADIX_SORT_MIN_LEN;
+
+        AutoBuffer<T> buf(sortRows ? 1 : len);
+        AutoBuffer<int> ibuf(useRadix ? len*2 : len);
+        AutoBuffer<K> kbuf(useRadix ? len*2 : 1);
+        T* bptr = buf.data();
+        int* _iptr = ibuf.data();
+        K* keys = kbuf.data();
+
+        for( int i = range.start; i < range.end; i++ )
         {
+            const T* ptr = bptr;
+            int* iptr = _iptr;
+
+            if( sortRows )
+            {
+                ptr = src.ptr<T>(i);
+                if( !useRadix )
+                    iptr = dst.ptr<int>(i);
+            }
+            else
+            {
+                for( int j = 0; j < len; j++ )
+                    bptr[j] = src.ptr<T>(j)[i];
+            }
             for( int j = 0; j < len; j++ )
-                ptr[j] = src.ptr<T>(j)[i];
-        }
-        for( int j = 0; j < len; j++ )
-            iptr[j] = j;
+                iptr[j] = j;
 
-        std::sort( iptr, iptr + len, LessThanIdx<T>(ptr) );
-        if( sortDescending )
-        {
-            for( int j = 0; j < len/2; j++ )
-                std::swap(iptr[j], iptr[len-1-j]);
-        }
+            if( useRadix )
+            {
+                for( int j = 0; j < len; j++ )
+                    keys[j] = SortKey<T>::get(ptr[j]);
+                radixSort_(keys, iptr, keys + len, iptr + len, len);
+            }
+            else
+                std::sort( iptr, iptr + len, LessThanIdx<T>(ptr) );
 
-        if( !sortRows )
-            for( int j = 0; j < len; j++ )
-                dst.ptr<int>(j)[i] = iptr[j];
+            if( sortRows )
+            {
+                int* dptr = dst.ptr<int>(i);
+                if( dptr == iptr )
+                {
+                    if( sortDescending )
+                        for( int j = 0; j < len/2; j++ )
+                            std::swap(iptr[j], iptr[len-1-j]);
+                }
+                else if( sortDescending )
+                {
+                    for( int j = 0; j < len; j++ )
+                        dptr[j] = iptr[len-1-j];
+                }
+                else
+                    memcpy(dptr, iptr, len*sizeof(int));
+            }
+            else
+            {
+                for( int j = 0; j < len; j++ )
+                    dst.ptr<int>(j)[i] = iptr[sortDescending ? len-1-j : j];
+            }
+        }
     }
+
+private:
+    const Mat& src;
+    Mat& dst;
+    int flags;
+};
+
+template<typename T> static void sortIdx_( const Mat& src, Mat& dst, int flags )
+{
+    CV_Assert( src.data != dst.data );
+
+    bool sortRows = (flags & 1) == SORT_EVERY_ROW;
+    int n = sortRows ? src.rows : src.cols;
+    parallel_for_(Range(0, n), SortIdxInvoker<T>(src, dst, flags), src.total()/(double)(1<<16));
 }
 
 #ifdef HAVE_IPP
@@ -1247,6 +1451,94 @@ static bool ipp_sortIdx( const Mat& src, Mat& dst, int flags )
 #endif
 
 typedef void (*SortFunc)(const Mat& src, Mat& dst, int flags);
+
+template<typename T> struct TopKLess
+{
+    TopKLess( const T* _arr, bool _descending ) : arr(_arr), descending(_descending) {}
+    bool operator()(int a, int b) const
+    {
+        T va = arr[a], vb = arr[b];
+        if( va != vb )
+            return descending ? va > vb : va < vb;
+        return a < b;  // equal values keep their original order
+    }
+    const T* arr;
+    bool descending;
+};
+
+template<typename T> class TopKInvoker : public ParallelLoopBody
+{
+public:
+    TopKInvoker( const Mat& _src, Mat& _values, Mat& _indices, int _k, int _flags )
+        : src(_src), values(_values), indices(_indices), k(_k), flags(_flags)
+    {}
+
+    void operator()( const Range& range ) const CV_OVERRIDE
+    {
+        bool sortRows = (flags & 1) == SORT_EVERY_ROW;
+        bool sortDescending = (flags & SORT_DESCENDING) != 0;
+        int len = sortRows ? src.cols : src.rows;
+
+        AutoBuffer<T> buf(sortRows ? 1 : len);
+        AutoBuffer<int> ibuf(len);
+        T* bptr = buf.data();
+        int* iptr = ibuf.data();
+
+        for( int i = range.start; i < range.end; i++ )
+        {
+            const T* ptr = bptr;
+            if( sortRows )
+                ptr = src.ptr<T>(i);
+            else
+            {
+                for( int j = 0; j < len; j++ )
+                    bptr[j] = src.ptr<T>(j)[i];
+            }
+            for( int j = 0; j < len; j++ )
+                iptr[j] = j;
+
+            TopKLess<T> less(ptr, sortDescending);
+            if( k < len )
+                std::nth_element(iptr, iptr + k, iptr + len, less);
+            std::sort(iptr, iptr + k, less);
+
+            for( int j = 0; j < k; j++ )
+            {
+                int idx = iptr[j];
+                if( sortRows )
+                {
+                    if( !values.empty() )
+                        values.ptr<T>(i)[j] = ptr[idx];
+                    if( !indices.empty() )
+                        indices.ptr<int>(i)[j] = idx;
+                }
+                else
+                {
+                    if( !values.empty() )
+                        values.ptr<T>(j)[i] = ptr[idx];
+                    if( !indices.empty() )
+                        indices.ptr<int>(j)[i] = idx;
+                }
+            }
+        }
+    }
+
+private:
+    const Mat& src;
+    Mat& values;
+    Mat& indices;
+    int k;
+    int flags;
+};
+
+template<typename T> static void topK_( const Mat& src, Mat& values, Mat& indices, int k, int flags )
+{
+    bool sortRows = (flags & 1) == SORT_EVERY_ROW;
+    int n = sortRows ? src.rows : src.cols;
+    parallel_for_(Range(0, n), TopKInvoker<T>(src, values, indices, k, flags), src.total()/(double)(1<<16));
+}
+
+typedef void (*TopKFunc)(const Mat& src, Mat& values, Mat& indices, int k, int flags);
 }
 
 void cv::sort( InputArray _src, OutputArray _dst, int flags )
@@ -1293,3 +1585,41 @@ void cv::sortIdx( InputArray _src, OutputArray _dst, int flags )
     CV_Assert( func != 0 );
     func( src, dst, flags );
 }
+
+void cv::topK( InputArray _src, OutputArray _values, OutputArray _indices, int k, int flags )
+{
+    CV_INSTRUMENT_REGION();
+
+    Mat src = _src.getMat();
+    CV_Assert( src.dims <= 2 && src.channels() == 1 );
+    CV_Assert( _values.needed() || _indices.needed() );
+
+    bool sortRows = (flags & 1) == SORT_EVERY_ROW;
+    int len = sortRows ? src.cols : src.rows;
+    CV_CheckGT(k, 0, "");
+    CV_CheckLE(k, len, "k must not exceed the row (column) length");
+    Size dsize = sortRows ? Size(k, src.rows) : Size(src.cols, k);
+
+    Mat values, indices;
+    if( _values.needed() )
+    {
+        _values.create( dsize, src.type() );
+        values = _values.getMat();
+        CV_Assert( values.data != src.data );
+    }
+    if( _indices.needed() )
+    {
+        _indices.create( dsize, CV_32S );
+        indices = _indices.getMat();
+        CV_Assert( indices.data != src.data );
+    }
+
+    static TopKFunc tab[CV_DEPTH_MAX] =
+    {
+        topK_<uchar>, topK_<schar>, topK_<ushort>, topK_<short>,
+        topK_<int>, topK_<float>, topK_<double>, 0
+    };
+    TopKFunc func = tab[src.depth()];
+    CV_Assert( func != 0 );
+    func( src, values, indices, k, flags );
+}
@@ -307,13 +307,6 @@ int decodeSimpleFormat( const char* dt )
 
 }
 
-#if defined __i386__ || defined(_M_IX86) || defined __x86_64__ || defined(_M_X64) || \
-    (defined (__LITTLE_ENDIAN__) && __LITTLE_ENDIAN__)
-#define CV_LITTLE_ENDIAN_MEM_ACCESS 1
-#else
-#define CV_LITTLE_ENDIAN_MEM_ACCESS 0
-#endif
-
 static inline int readInt(const uchar* p)
 {
     // On little endian CPUs, both branches produce the same result. On big endian, only the else branch does.
@@ -398,12 +391,18 @@ void FileStorage::Impl::init() {
     fmt = 0;
     file = 0;
     gzfile = 0;
+    sidecar_file = 0;
+    sidecar_size = 0;
     empty_stream = true;
 
     strbufv.clear();
     strbuf = 0;
-    strbufsize = strbufpos = 0;
+    strbufsize = strbufpos = strbuflinepos = 0;
     roots.clear();
+#if OPENCV_HAVE_FILESYSTEM_SUPPORT
+    mapped_file.release();
+    sidecar_mapping.release();
+#endif
 
     fs_data.clear();
     fs_data_ptrs.clear();
@@ -446,6 +445,8 @@ void FileStorage::Impl::release(String *out) {
             *out = cv::String(outbuf.begin(), outbuf.end());
         }
     }
+    if (sidecar_file)
+        fclose(sidecar_file);
     closeFile();
     init();
 }
@@ -485,6 +486,7 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
 
     write_mode = (_flags & 3) != 0;
     bool write_base64 = (write_mode || append) && (_flags & FileStorage::BASE64) != 0;
+    bool write_sidecar = (write_mode || append) && (_flags & FileStorage::BINARY_SIDECAR) != 0;
 
     bool isGZ = false;
     size_t fnamelen = 0;
@@ -507,6 +509,12 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
     if (mem_mode && append)
         CV_Error(cv::Error::StsBadFlag, "FileStorage::APPEND and FileStorage::MEMORY are not currently compatible");
 
+    if (write_sidecar) {
+        if (mem_mode)
+            CV_Error(cv::Error::StsBadFlag, "FileStorage::BINARY_SIDECAR and FileStorage::MEMORY are not compatible");
+        write_base64 = true;
+    }
+
     flags = _flags;
 
     if (!mem_mode) {
@@ -525,11 +533,28 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
         }
 
         if (!isGZ) {
-            file = fopen(filename.c_str(), !write_mode ? "rt" : !append ? "wt" : "a+t");
-            if (!file)
+#if OPENCV_HAVE_FILESYSTEM_SUPPORT
+            if (!write_mode && (flags & FileStorage::MEMORY_MAPPED) != 0) {
+                mapped_file = makePtr<utils::fs::MappedFile>(filename.c_str());
+                if (!mapped_file->isOpened())
+                {
+                    CV_LOG_ERROR(NULL, "Can't map file: '" << filename << "' in read mode");
+                    mapped_file.release();
+                    return false;
+                }
+                // there is nothing to map in an empty file, let the regular reader report it
+                if (mapped_file->size() == 0)
+                    mapped_file.release();
+            }
+            if (!mapped_file)
+#endif
             {
-                CV_LOG_ERROR(NULL, "Can't open file: '" << filename << "' in " << (!write_mode ? "read" : !append ? "write" : "append") << " mode");
-                return false;
+                file = fopen(filename.c_str(), !write_mode ? "rt" : !append ? "wt" : "a+t");
+                if (!file)
+                {
+                    CV_LOG_ERROR(NULL, "Can't open file: '" << filename << "' in " << (!write_mode ? "read" : !append ? "write" : "append") << " mode");
+                    return false;
+                }
             }
         } else {
 #if USE_ZLIB
@@ -544,6 +569,17 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
             CV_Error(cv::Error::StsNotImplemented, "There is no compressed file storage support in this configuration");
 #endif
         }
+
+        if (write_sidecar) {
+            sidecar_file = fopen(sidecarName().c_str(), append ? "ab" : "wb");
+            if (!sidecar_file)
+            {
+                CV_LOG_ERROR(NULL, "Can't open binary sidecar file: '" << sidecarName() << "'");
+                return false;
+            }
+            fseek(sidecar_file, 0, SEEK_END);
+            sidecar_size = (size_t)ftell(sidecar_file);
+        }
     }
 
     // FIXIT release() must do that, use CV_Assert() here instead
@@ -699,6 +735,12 @@ bool FileStorage::Impl::open(const char *filename_or_buf, int _flags, const char
             strbuf = (char *) filename_or_buf;
             strbufsize = strlen(strbuf);
         }
+#if OPENCV_HAVE_FILESYSTEM_SUPPORT
+        else if (mapped_file) {
+            strbuf = (char *) mapped_file->data();
+            strbufsize = mapped_file->size();
+        }
+#endif
 
         const char *yaml_signature = "%YAML";
         const char *json_signature = "{";
@@ -824,6 +866,7 @@ char *FileStorage::Impl::gets(size_t maxCount) {
         buffer.resize(std::max(buffer.size(), maxCount + 8));
         memcpy(&buffer[0], instr + strbufpos, maxCount);
         buffer[maxCount] = '\0';
+        strbuflinepos = strbufpos;
         strbufpos = i;
         return maxCount > 0 ? &buffer[0] : 0;
     }
@@ -1765,7 +1808,106 @@ bool FileStorage::Impl::Base64Decoder::endOfStream() const { return eos; }
 char *FileStorage::Impl::Base64Decoder::getPtr() const { return ptr; }
 
 
+// Layout of a lazy sequence node (the tag has CV_FS_LAZY_SEQ bit set, the type is SEQ):
+//   tag, [name], raw_size, nelems, block_ofs (8), block_len (8), seq_block (4), seq_ofs (4), dt ('\0'-terminated)
+// where [block_ofs, block_ofs + block_len) is the base64 text in the mapped file,
+// and (seq_block, seq_ofs) points to the materialized sequence (or -1 if it has not been created yet).
+enum { LAZY_SEQ_DESC_SIZE = 8 + 8 + 4 + 4 };
+
+static const uchar* lazySeqDesc(const uchar* p)
+{
+    return p + 1 + ((*p & FileNode::NAMED) ? 4 : 0) + 8;
+}
+
+static inline size_t readSize(const uchar* p)
+{
+    return (size_t)(unsigned)readInt(p) | ((size_t)(unsigned)readInt(p + 4) << 16 << 16);
+}
+
+static inline void writeSize(uchar* p, size_t sz)
+{
+    writeInt(p, (int)(unsigned)sz);
+    writeInt(p + 4, (int)(unsigned)(sz >> 16 >> 16));
+}
+
+struct Base64DecodeTab
+{
+    Base64DecodeTab()
+    {
+        memset(tab, -1, sizeof(tab));
+        for (int i = 0; i < 64; i++)
+            tab[base64::base64_mapping[i]] = (schar)i;
+    }
+    schar tab[256];
+};
+
+// Decodes bytes [skip, skip + count) of the base64 text, ignoring any characters outside of
+// the base64 alphabet (line breaks, indentation). Returns the number of decoded bytes.
+static size_t decodeBase64Block(const char* src, size_t srclen, size_t skip, uchar* dst, size_t count)
+{
+    static const Base64DecodeTab decodeTab;
+    const schar* tab = decodeTab.tab;
+    const char* end = src + srclen;
+    unsigned acc = 0;
+    int nbits = 0;
+    size_t pos = 0, written = 0;
+    for (; src < end && written < count; src++)
+    {
+        int v = tab[(uchar)*src];
+        if (v < 0)
+        {
+            if (*src == '=')
+                break;
+            continue;
+        }
+        acc = (acc << 6) | (unsigned)v;
+        nbits += 6;
+        if (nbits >= 8)
+        {
+            nbits -= 8;
+            if (pos >= skip)
+                dst[written++] = (uchar)(acc >> nbits);
+            pos++;
+        }
+    }
+    return written;
+}
+
+// The number of elements of type dt in nbytes of packed data;
+// the trailing incomplete structure contributes its complete elements only.
+static size_t rawDataElemCount(FileStorage_API* fs, const char* dt, size_t nbytes)
+{
+    int fmt_pairs[CV_FS_MAX_FMT_PAIRS * 2];
+    int fmt_pair_count = cv::fs::decodeFormat(dt, fmt_pairs, CV_FS_MAX_FMT_PAIRS);
+    size_t struct_size = 0, struct_elems = 0;
+    for (int k = 0; k < fmt_pair_count; k++) {
+        struct_size += (size_t)fmt_pairs[k * 2] * CV_ELEM_SIZE(fmt_pairs[k * 2 + 1]);
+        struct_elems += fmt_pairs[k * 2];
+    }
+    if (fmt_pair_count == 0 || struct_size == 0)
+        CV_PARSE_ERROR_CPP("Invalid Base64 header");
+
+    size_t nelems = nbytes / struct_size * struct_elems;
+    nbytes %= struct_size;
+    for (int k = 0; k < fmt_pair_count; k++) {
+        size_t elem_size = CV_ELEM_SIZE(fmt_pairs[k * 2 + 1]);
+        size_t n = std::min((size_t)fmt_pairs[k * 2], nbytes / elem_size);
+        nelems += n;
+        nbytes -= n * elem_size;
+        if (n < (size_t)fmt_pairs[k * 2])
+            break;
+    }
+    if (nelems >= (size_t)INT_MAX)
+        CV_PARSE_ERROR_CPP("Too many elements in Base64 data");
+    return nelems;
+}
+
 char *FileStorage::Impl::parseBase64(char *ptr, int indent, FileNode &collection) {
+#if OPENCV_HAVE_FILESYSTEM_SUPPORT
+    if (mapped_file && strbuf)
+        return parseBase64Lazy(ptr, indent, collection);
+#endif
+
     const int BASE64_HDR_SIZE = 24;
     char dt[BASE64_HDR_SIZE + 1] = {0};
     base64decoder.init(parser_do_not_use_direct_dereference, ptr, indent);
@@ -1781,6 +1923,19 @@ char *FileStorage::Impl::parseBase64(char *ptr, int indent, FileNode &collection
 
     CV_Assert(!base64decoder.endOfStream());
 
+    if (dt[0] == ::base64::SIDECAR_MARK) {
+        uchar ref[::base64::SIDECAR_REF_SIZE];
+        for (i = 0; i < ::base64::SIDECAR_REF_SIZE; i++)
+            ref[i] = base64decoder.getUInt8();
+        while (!base64decoder.endOfStream())
+            base64decoder.getUInt8();
+        size_t data_ofs = readSize(ref), data_len = readSize(ref + 8);
+        addRawDataNodes(collection, dt + 1, getSidecarData(data_ofs, data_len), data_len,
+                        rawDataElemCount(this, dt + 1, data_len));
+        finalizeCollection(collection);
+        return base64decoder.getPtr();
+    }
+
     int fmt_pairs[CV_FS_MAX_FMT_PAIRS * 2];
     int fmt_pair_count = fs::decodeFormat(dt, fmt_pairs, CV_FS_MAX_FMT_PAIRS);
     int ival = 0;
@@ -1842,6 +1997,239 @@ char *FileStorage::Impl::parseBase64(char *ptr, int indent, FileNode &collection
     return base64decoder.getPtr();
 }
 
+char *FileStorage::Impl::parseBase64Lazy(char *ptr, int indent, FileNode &collection) {
+#if OPENCV_HAVE_FILESYSTEM_SUPPORT
+    FileStorage_API *fs = this;
+    const int BASE64_HDR_SIZE = 24;
+    const int BASE64_HDR_CHARS = BASE64_HDR_SIZE / 3 * 4;
+
+    size_t block_ofs = 0, block_end = 0, totalchars = 0;
+    char hdr[BASE64_HDR_CHARS];
+    int hdrchars = 0;
+    char last[2] = {0, 0};
+
+    // scan the rows without decoding them, just to find the block boundaries
+    for (bool first = true;; first = false) {
+        char *beg = 0, *end = 0;
+        bool ok = getParser().getBase64Row(ptr, indent, beg, end);
+        ptr = end;
+        if (!ok || beg == end)
+            break;
+        // the current line is copied from strbuf to the beginning of buffer
+        if (first)
+            block_ofs = strbuflinepos + (size_t)(beg - bufferStart());
+        block_end = strbuflinepos + (size_t)(end - bufferStart());
+        for (const char* c = beg; c < end && hdrchars < BASE64_HDR_CHARS; c++)
+            hdr[hdrchars++] = *c;
+        totalchars += end - beg;
+        if (end - beg >= 2)
+            last[0] = end[-2], last[1] = end[-1];
+        else
+            last[0] = last[1], last[1] = beg[0];
+    }
+
+    // the same number of bytes as the streaming decoder produces (see Base64Decoder::readMore)
+    size_t nbytes = totalchars / 4 * 3;
+    if (totalchars % 4 == 0 && last[1] == '=')
+        nbytes -= last[0] == '=' ? 2 : 1;
+    if (hdrchars < BASE64_HDR_CHARS || nbytes <= (size_t)BASE64_HDR_SIZE)
+        CV_PARSE_ERROR_CPP("Invalid Base64 data");
+
+    char dt[BASE64_HDR_SIZE + 1] = {0};
+    decodeBase64Block(hdr, hdrchars, 0, (uchar*)dt, BASE64_HDR_SIZE);
+    int i;
+    for (i = 0; i < BASE64_HDR_SIZE; i++)
+        if (isspace(dt[i]) || dt[i] == '\0')
+            break;
+    dt[i] = '\0';
+
+    size_t nelems;
+    if (dt[0] == ::base64::SIDECAR_MARK) {
+        // the block only refers to the data in the binary sidecar, keep the reference instead
+        uchar ref[BASE64_HDR_SIZE + ::base64::SIDECAR_REF_SIZE];
+        if (decodeBase64Block((const char*)mapped_file->data() + block_ofs, block_end - block_ofs,
+                              0, ref, sizeof(ref)) != sizeof(ref))
+            CV_PARSE_ERROR_CPP("Invalid binary sidecar reference");
+        block_ofs = readSize(ref + BASE64_HDR_SIZE);
+        block_end = block_ofs + readSize(ref + BASE64_HDR_SIZE + 8);
+        getSidecarData(block_ofs, block_end - block_ofs);
+        nelems = rawDataElemCount(fs, dt + 1, block_end - block_ofs);
+    }
+    else
+        nelems = rawDataElemCount(fs, dt, nbytes - BASE64_HDR_SIZE);
+
+    bool named = collection.isNamed();
+    size_t dtlen = strlen(dt) + 1;
+    uchar *p = reserveNodeSpace(collection, 1 + (named ? 4 : 0) + 8 + LAZY_SEQ_DESC_SIZE + dtlen);
+    *p++ = (uchar) (FileNode::SEQ | CV_FS_LAZY_SEQ | (named ? FileNode::NAMED : 0));
+    // name has been copied automatically
+    if (named)
+        p += 4;
+    writeInt(p, (int)(4 + LAZY_SEQ_DESC_SIZE + dtlen));
+    writeInt(p + 4, (int)nelems);
+    p += 8;
+    writeSize(p, block_ofs);
+    writeSize(p + 8, block_end - block_ofs);
+    writeInt(p + 16, -1);
+    writeInt(p + 20, -1);
+    memcpy(p + LAZY_SEQ_DESC_SIZE, dt, dtlen);
+    return ptr;
+#else
+    CV_UNUSED(indent); CV_UNUSED(collection);
+    return ptr;
+#endif
+}
+
+FileNode FileStorage::Impl::materializeLazySeq(const FileNode& node) {
+#if OPENCV_HAVE_FILESYSTEM_SUPPORT
+    const int BASE64_HDR_SIZE = 24;
+    const uchar* desc = lazySeqDesc(node.ptr());
+    int seq_block = readInt(desc + 16), seq_ofs = readInt(desc + 20);
+    if (seq_block >= 0)
+        return FileNode(fs_ext, (size_t)seq_block, (size_t)seq_ofs);
+
+    // several readers may iterate over the same lazy node concurrently;
+    // only one of them decodes it, the others reuse the result
+    AutoLock lock(lazy_seq_mutex);
+    seq_block = readInt(desc + 16);
+    seq_ofs = readInt(desc + 20);
+    if (seq_block >= 0)
+        return FileNode(fs_ext, (size_t)seq_block, (size_t)seq_ofs);
+
+    CV_Assert(mapped_file);
+    size_t block_ofs = readSize(desc), block_len = readSize(desc + 8);
+    std::string dt((const char*)desc + LAZY_SEQ_DESC_SIZE);
+
+    FileNode seq(fs_ext, fs_data_ptrs.size() - 1, freeSpaceOfs);
+    uchar *p = reserveNodeSpace(seq, 1 + 8);
+    *p = (uchar) FileNode::SEQ;
+    writeInt(p + 1, 4);
+    writeInt(p + 5, 0);
+
+    if (dt[0] == ::base64::SIDECAR_MARK) {
+        addRawDataNodes(seq, dt.c_str() + 1, getSidecarData(block_ofs, block_len), block_len, node.size());
+    } else {
+        std::vector<uchar> data(block_len / 4 * 3 + 3);
+        size_t nbytes = decodeBase64Block((const char*)mapped_file->data() + block_ofs, block_len,
+                                          BASE64_HDR_SIZE, data.data(), data.size());
+        addRawDataNodes(seq, dt.c_str(), data.data(), nbytes, node.size());
+    }
+    finalizeCollection(seq);
+
+    uchar* wdesc = (uchar*)lazySeqDesc(node.ptr());
+    writeInt(wdesc + 16, (int)seq.blockIdx);
+    writeInt(wdesc + 20, (int)seq.ofs);
+    return seq;
+#else
+    return node;
+#endif
+}
+
+void FileStorage::Impl::addRawDataNodes(FileNode& seq, const char* dt, const uchar* data,
+                                        size_t nbytes, size_t nelems) {
+    int fmt_pairs[CV_FS_MAX_FMT_PAIRS * 2];
+    int fmt_pair_count = fs::decodeFormat(dt, fmt_pairs, CV_FS_MAX_FMT_PAIRS);
+    const uchar* src = data;
+    const uchar* src_end = src + nbytes;
+    size_t count = 0;
+    int ival = 0;
+    double fval = 0;
+    while (count < nelems) {
+        for (int k = 0; k < fmt_pair_count && count < nelems; k++) {
+            int elem_type = fmt_pairs[k * 2 + 1];
+            int elem_size = CV_ELEM_SIZE(elem_type);
+            for (int i = 0; i < fmt_pairs[k * 2] && count < nelems; i++, count++, src += elem_size) {
+                CV_Assert(src + elem_size <= src_end);
+                int node_type = FileNode::INT;
+                switch (elem_type) {
+                    case CV_8U: ival = src[0]; break;
+                    case CV_8S: ival = (schar)src[0]; break;
+                    case CV_16U: ival = (ushort)(src[0] | (src[1] << 8)); break;
+                    case CV_16S: ival = (short)(src[0] | (src[1] << 8)); break;
+                    case CV_32S: ival = readInt(src); break;
+                    case CV_32F: {
+                        Cv32suf v;
+                        v.i = readInt(src);
+                        fval = v.f;
+                        node_type = FileNode::REAL;
+                    }
+                        break;
+                    case CV_64F:
+                        fval = readReal(src);
+                        node_type = FileNode::REAL;
+                        break;
+                    case CV_16F:
+                        fval = float(hfloatFromBits((ushort)(src[0] | (src[1] << 8))));
+                        node_type = FileNode::REAL;
+                        break;
+                    default:
+                        CV_Error(Error::StsUnsupportedFormat, "Unsupported type");
+                }
+                addNode(seq, std::string(), node_type,
+                        node_type == FileNode::INT ? (void *) &ival : (void *) &fval, -1);
+            }
+        }
+    }
+}
+
+bool FileStorage::Impl::readLazySeqRaw(const FileNode& node, const std::string& fmt_, void* vec, size_t len) const {
+#if OPENCV_HAVE_FILESYSTEM_SUPPORT && CV_LITTLE_ENDIAN_MEM_ACCESS
+    const int BASE64_HDR_SIZE = 24;
+    const uchar* desc = lazySeqDesc(node.ptr());
+    std::string dt((const char*)desc + LAZY_SEQ_DESC_SIZE);
+    bool sidecar = dt[0] == ::base64::SIDECAR_MARK;
+
+    // the payload is stored packed in the machine (little-endian) byte order,
+    // so it can be copied as is when the requested format has the same single element type
+    int fmt_pairs[CV_FS_MAX_FMT_PAIRS * 2], dt_pairs[CV_FS_MAX_FMT_PAIRS * 2];
+    if (fs::decodeFormat(fmt_.c_str(), fmt_pairs, CV_FS_MAX_FMT_PAIRS) != 1 ||
+        fs::decodeFormat(dt.c_str() + (sidecar ? 1 : 0), dt_pairs, CV_FS_MAX_FMT_PAIRS) != 1 ||
+        fmt_pairs[1] != dt_pairs[1])
+        return false;
+
+    size_t elem_size = CV_ELEM_SIZE(fmt_pairs[1]);
+    size_t nbytes = std::min(len, node.size() * elem_size);
+    size_t block_ofs = readSize(desc), block_len = readSize(desc + 8);
+    if (sidecar) {
+        CV_Assert(nbytes <= block_len && sidecar_mapping);
+        memcpy(vec, sidecar_mapping->data() + block_ofs, nbytes);
+        return true;
+    }
+    size_t decoded = decodeBase64Block((const char*)mapped_file->data() + block_ofs, block_len,
+                                       BASE64_HDR_SIZE, (uchar*)vec, nbytes);
+    CV_Assert(decoded == nbytes);
+    return true;
+#else
+    CV_UNUSED(node); CV_UNUSED(fmt_); CV_UNUSED(vec); CV_UNUSED(len);
+    return false;
+#endif
+}
+
+std::string FileStorage::Impl::sidecarName() const {
+    return filename + ".bin";
+}
+
+const uchar* FileStorage::Impl::getSidecarData(size_t ofs, size_t len) {
+#if OPENCV_HAVE_FILESYSTEM_SUPPORT
+    FileStorage_API *fs = this;
+    if (!sidecar_mapping) {
+        if (mem_mode)
+            CV_PARSE_ERROR_CPP("The binary sidecar file can't be located for the storage read from memory");
+        sidecar_mapping = makePtr<utils::fs::MappedFile>(sidecarName().c_str());
+        if (!sidecar_mapping->isOpened()) {
+            sidecar_mapping.release();
+            CV_PARSE_ERROR_CPP("Can't open the binary sidecar file '" + sidecarName() + "'");
+        }
+    }
+    if (ofs > sidecar_mapping->size() || len > sidecar_mapping->size() - ofs)
+        CV_PARSE_ERROR_CPP("The data block is out of the binary sidecar file");
+    return sidecar_mapping->data() + ofs;
+#else
+    CV_UNUSED(ofs); CV_UNUSED(len);
+    CV_Error(Error::StsNotImplemented, "Binary sidecar files are not supported in this configuration");
+#endif
+}
+
 void FileStorage::Impl::parseError(const char *func_name, const std::string &err_msg, const char *source_file,
                                    int source_line) {
     std::string msg = format("%s(%d): %s", filename.c_str(), lineno, err_msg.c_str());
@@ -2338,6 +2726,9 @@ FileNodeIterator FileNode::end() const   { return FileNodeIterator(*this, true);
 
 void FileNode::readRaw( const std::string& fmt, void* vec, size_t len ) const
 {
+    const uchar* tag = ptr();
+    if( tag && (*tag & CV_FS_LAZY_SEQ) && fs->readLazySeqRaw(*this, fmt, vec, len) )
+        return;
     FileNodeIterator it = begin();
     it.readRaw( fmt, vec, len );
 }
@@ -2450,8 +2841,12 @@ FileNodeIterator::FileNodeIterator()
     idx = 0;
 }
 
-FileNodeIterator::FileNodeIterator( const FileNode& node, bool seekEnd )
+FileNodeIterator::FileNodeIterator( const FileNode& _node, bool seekEnd )
 {
+    FileNode node = _node;
+    const uchar* tag = node.ptr();
+    if( tag && (*tag & CV_FS_LAZY_SEQ) )
+        node = node.fs->materializeLazySeq(node);
     fs = node.fs;
     idx = 0;
     if( !fs )
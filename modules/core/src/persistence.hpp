@@ -34,9 +34,14 @@ namespace base64 {
 enum
 {
     HEADER_SIZE         = 24,
-    ENCODED_HEADER_SIZE = 32
+    ENCODED_HEADER_SIZE = 32,
+    SIDECAR_ALIGN       = 64, //!< alignment of the data blocks in the binary sidecar file
+    SIDECAR_REF_SIZE    = 16  //!< offset and size (uint64 each) following the header of a sidecar reference
 };
 
+//! the header type of a Base64 block that refers to the data in the binary sidecar file ("@<dt>")
+static const char SIDECAR_MARK = '@';
+
 } // base64::
 
 //=====================================================================================
@@ -44,6 +49,17 @@ enum
 #define CV_FS_MAX_LEN 4096
 #define CV_FS_MAX_FMT_PAIRS  128
 
+#if defined __i386__ || defined(_M_IX86) || defined __x86_64__ || defined(_M_X64) || \
+    (defined (__LITTLE_ENDIAN__) && __LITTLE_ENDIAN__)
+#define CV_LITTLE_ENDIAN_MEM_ACCESS 1
+#else
+#define CV_LITTLE_ENDIAN_MEM_ACCESS 0
+#endif
+
+// internal FileNode tag bit (in addition to FileNode::TYPE_MASK, FLOW, EMPTY and NAMED):
+// the sequence is a base64 block of a memory-mapped file, which is decoded on access
+#define CV_FS_LAZY_SEQ 64
+
 /****************************************************************************************\
 *                            Common macros and type definitions                          *
 \****************************************************************************************/
@@ -46,6 +46,12 @@ public:
             return *this;
 
         while (beg < end) {
+            if (src_cur == src_beg && static_cast<size_t>(end - beg) >= BULK_MIN_LEN) {
+                /* large payload, encode whole lines directly from the source */
+                beg = write_lines(beg, end);
+                continue;
+            }
+
             /* collect binary data and copy to binary buffer */
             size_t len = std::min(end - beg, src_end - src_cur);
             std::memcpy(src_cur, beg, len);
@@ -115,17 +121,81 @@ public:
         return true;
     }
 
+private:
+    /*
+     * encodes as many whole lines of [beg, end) as fit into one batch and sends them to fs;
+     * the output is the same as of flushing the lines one by one.
+     * returns the beginning of the rest of the data.
+     */
+    const uchar * write_lines(const uchar * beg, const uchar * end)
+    {
+        size_t nlines = std::min(static_cast<size_t>(end - beg) / BUFFER_LEN, BATCH_LINES);
+        CV_DbgAssert(nlines > 0);
+
+        int ident = needs_indent ? file_storage.write_stack.back().indent : 0;
+        size_t line_len = ident + BUFFER_LEN / 3U * 4U + (needs_indent ? 1U : 0U);
+        text_buffer.resize(nlines * line_len + 1U);
+
+        BatchEncoder body(beg, text_buffer.data(), line_len, ident, needs_indent);
+        if (nlines >= PARALLEL_MIN_LINES)
+            parallel_for_(Range(0, static_cast<int>(nlines)), body,
+                          static_cast<double>(nlines) / PARALLEL_MIN_LINES);
+        else
+            body(Range(0, static_cast<int>(nlines)));
+
+        text_buffer[nlines * line_len] = '\0';
+        file_storage.puts(text_buffer.data());
+        if (needs_indent)
+            file_storage.flush();
+
+        return beg + nlines * BUFFER_LEN;
+    }
+
+    class BatchEncoder : public ParallelLoopBody
+    {
+    public:
+        BatchEncoder(const uchar * src_, char * dst_, size_t line_len_, int ident_, bool newline_)
+            : src(src_), dst(dst_), line_len(line_len_), ident(ident_), newline(newline_) {}
+
+        void operator()(const Range& range) const CV_OVERRIDE
+        {
+            uint8_t line[BUFFER_LEN / 3U * 4U + 1U];
+            for (int i = range.start; i < range.end; i++) {
+                char * out = dst + i * line_len;
+                size_t len = base64_encode(src + i * BUFFER_LEN, line, 0U, BUFFER_LEN);
+                memset(out, ' ', ident);
+                memcpy(out + ident, line, len);
+                if (newline)
+                    out[ident + len] = '\n';
+            }
+        }
+
+    private:
+        const uchar * src;
+        char * dst;
+        size_t line_len;
+        int ident;
+        bool newline;
+    };
+
 private:
     /* because of Base64, we must keep its length a multiple of 3 */
     static const size_t BUFFER_LEN = 48U;
     // static_assert(BUFFER_LEN % 3 == 0, "BUFFER_LEN is invalid");
 
+    /* payloads of this size and larger bypass the binary buffer */
+    static const size_t BULK_MIN_LEN = BUFFER_LEN * 16U;
+    /* the number of lines encoded at once, it bounds the memory used for the text */
+    static const size_t BATCH_LINES = 1U << 13;
+    static const size_t PARALLEL_MIN_LINES = 1U << 10;
+
 private:
     cv::FileStorage::Impl& file_storage;
     bool needs_indent;
 
     std::vector<uchar> binary_buffer;
     std::vector<uchar> base64_buffer;
+    std::vector<char> text_buffer;
     uchar * src_beg;
     uchar * src_cur;
     uchar * src_end;
@@ -221,19 +291,86 @@ size_t base64::base64_encode_buffer_size(size_t cnt, bool is_end_with_zero) {
 }
 
 base64::Base64Writer::Base64Writer(cv::FileStorage::Impl& fs, bool can_indent)
-        : emitter(new Base64ContextEmitter(fs, can_indent))
+        : file_storage(fs)
+        , emitter(new Base64ContextEmitter(fs, can_indent))
         , data_type_string()
+        , sidecar_ofs(0)
+        , sidecar_len(0)
 {
     CV_Assert(fs.write_mode);
 }
 
+/* the data of a single element type is packed already, so on little-endian CPUs it can be encoded as is */
+static bool isPackedLayout(const char* dt)
+{
+#if CV_LITTLE_ENDIAN_MEM_ACCESS
+    int fmt_pairs[CV_FS_MAX_FMT_PAIRS * 2];
+    return fs::decodeFormat(dt, fmt_pairs, CV_FS_MAX_FMT_PAIRS) == 1;
+#else
+    CV_UNUSED(dt);
+    return false;
+#endif
+}
+
 void base64::Base64Writer::write(const void* _data, size_t len, const char* dt)
 {
     check_dt(dt);
+    if (file_storage.sidecar_file)
+    {
+        write_sidecar(_data, len);
+        return;
+    }
+    if (isPackedLayout(dt))
+    {
+        const uchar * beg = static_cast<const uchar *>(_data);
+        emitter->write(beg, beg + len);
+        return;
+    }
     RawDataToBinaryConvertor convertor(_data, static_cast<int>(len), data_type_string);
     emitter->write(convertor);
 }
 
+void base64::Base64Writer::write_sidecar(const void* _data, size_t len)
+{
+    FILE* f = file_storage.sidecar_file;
+    if (sidecar_len == 0)
+    {
+        /* every block starts at an aligned offset, so that it can be used in place when mapped */
+        static const uchar zeros[::base64::SIDECAR_ALIGN] = {0};
+        size_t pad = alignSize(file_storage.sidecar_size, ::base64::SIDECAR_ALIGN) - file_storage.sidecar_size;
+        if (pad > 0 && fwrite(zeros, 1, pad, f) != pad)
+            CV_Error(cv::Error::StsError, "Can't write the binary sidecar file");
+        file_storage.sidecar_size += pad;
+        sidecar_ofs = file_storage.sidecar_size;
+    }
+
+    if (len == 0)
+        return;
+    if (isPackedLayout(data_type_string.c_str()))
+    {
+        if (fwrite(_data, 1, len, f) != len)
+            CV_Error(cv::Error::StsError, "Can't write the binary sidecar file");
+    }
+    else
+    {
+        RawDataToBinaryConvertor convertor(_data, static_cast<int>(len), data_type_string);
+        std::vector<uchar> buffer(1024U);
+        len = 0;
+        while (convertor)
+        {
+            uchar * beg = buffer.data();
+            uchar * end = beg;
+            convertor >> end;
+            size_t n = static_cast<size_t>(end - beg);
+            if (fwrite(beg, 1, n, f) != n)
+                CV_Error(cv::Error::StsError, "Can't write the binary sidecar file");
+            len += n;
+        }
+    }
+    sidecar_len += len;
+    file_storage.sidecar_size += len;
+}
+
 template<typename _to_binary_convertor_t> inline
 void base64::Base64Writer::write(_to_binary_convertor_t & convertor, const char* dt)
 {
@@ -243,6 +380,14 @@ void base64::Base64Writer::write(_to_binary_convertor_t & convertor, const char*
 
 base64::Base64Writer::~Base64Writer()
 {
+    if (file_storage.sidecar_file && !data_type_string.empty())
+    {
+        /* the text block only refers to the data: offset and size of it in the sidecar */
+        uchar ref[::base64::SIDECAR_REF_SIZE];
+        to_binary<uint64>(static_cast<uint64>(sidecar_ofs), ref);
+        to_binary<uint64>(static_cast<uint64>(sidecar_len), ref + sizeof(uint64));
+        emitter->write(ref, ref + ::base64::SIDECAR_REF_SIZE);
+    }
     delete emitter;
 }
 
@@ -254,7 +399,8 @@ void base64::Base64Writer::check_dt(const char* dt)
         data_type_string = dt;
 
         /* output header */
-        std::string buffer = make_base64_header(dt);
+        std::string buffer = make_base64_header(file_storage.sidecar_file ?
+                                                (std::string(1, ::base64::SIDECAR_MARK) + dt).c_str() : dt);
         const uchar * beg = reinterpret_cast<const uchar *>(buffer.data());
         const uchar * end = beg + buffer.size();
 
@@ -42,6 +42,7 @@ public:
 
 private:
     void check_dt(const char* dt);
+    void write_sidecar(const void* _data, size_t len);
 
 private:
     // disable copy and assignment
@@ -50,8 +51,11 @@ private:
 
 private:
 
+    cv::FileStorage::Impl& file_storage;
     Base64ContextEmitter * emitter;
     std::string data_type_string;
+    size_t sidecar_ofs; //!< offset of the current block in the binary sidecar
+    size_t sidecar_len; //!< bytes of the current block written to the sidecar so far
 };
 
 size_t base64_encode_buffer_size(size_t cnt, bool is_end_with_zero = true);
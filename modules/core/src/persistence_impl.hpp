@@ -7,6 +7,7 @@
 
 #include "persistence.hpp"
 #include "persistence_base64_encoding.hpp"
+#include "opencv2/core/utils/filesystem.private.hpp"
 #include <unordered_map>
 #include <iterator>
 
@@ -173,6 +174,23 @@ public:
 
     char* parseBase64(char* ptr, int indent, FileNode& collection);
 
+    // MEMORY_MAPPED mode: records the position of the base64 block in the mapped file
+    // instead of decoding it into nodes
+    char* parseBase64Lazy(char* ptr, int indent, FileNode& collection);
+
+    // decodes the whole lazy sequence into regular nodes (once) and returns the resulting sequence
+    FileNode materializeLazySeq(const FileNode& node);
+
+    // decodes the lazy sequence straight into the user buffer if the format allows that
+    bool readLazySeqRaw(const FileNode& node, const std::string& fmt_, void* vec, size_t len) const;
+
+    // appends the elements of the packed little-endian data of type dt to the sequence
+    void addRawDataNodes(FileNode& seq, const char* dt, const uchar* data, size_t nbytes, size_t nelems);
+
+    // BINARY_SIDECAR mode: the name of the sidecar and [ofs, ofs + len) block of it (mapped on the first use)
+    std::string sidecarName() const;
+    const uchar* getSidecarData(size_t ofs, size_t len);
+
     void parseError( const char* func_name, const std::string& err_msg, const char* source_file, int source_line );
 
     const uchar* getNodePtr(size_t blockIdx, size_t ofs) const;
@@ -189,6 +207,8 @@ public:
 
     FILE* file;
     gzFile gzfile;
+    FILE* sidecar_file; //!< the binary sidecar in BINARY_SIDECAR write mode
+    size_t sidecar_size; //!< the number of bytes written to sidecar_file
 
     bool is_opened;
     bool dummy_eof;
@@ -241,7 +261,14 @@ public:
     char* strbuf;
     size_t strbufsize;
     size_t strbufpos;
+    size_t strbuflinepos; //!< position of the line currently held in buffer (when reading from strbuf)
     int lineno;
+
+#if OPENCV_HAVE_FILESYSTEM_SUPPORT
+    Ptr<utils::fs::MappedFile> mapped_file; //!< the file content in MEMORY_MAPPED mode
+    Mutex lazy_seq_mutex; //!< serializes materializeLazySeq()
+    Ptr<utils::fs::MappedFile> sidecar_mapping; //!< the binary sidecar when reading
+#endif
 };
 
 }
@@ -40,6 +40,7 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <errno.h>
+#include <sys/mman.h>
 #endif
 
 #endif // OPENCV_HAVE_FILESYSTEM_SUPPORT
@@ -426,6 +427,111 @@ void FileLock::lock_shared() { CV_Assert(pImpl->lock_shared()); }
 void FileLock::unlock_shared() { CV_Assert(pImpl->unlock_shared()); }
 
 
+#ifdef _WIN32
+
+struct MappedFile::Impl
+{
+    Impl(const char* fname)
+        : ptr(NULL), size(0), opened(false)
+    {
+        HANDLE file = ::CreateFileA(fname, GENERIC_READ, FILE_SHARE_READ, NULL,
+                                    OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (INVALID_HANDLE_VALUE == file)
+            return;
+        LARGE_INTEGER fsize;
+        if (::GetFileSizeEx(file, &fsize))
+        {
+            size = (size_t)fsize.QuadPart;
+            opened = true;
+            if (size > 0)
+            {
+                HANDLE mapping = ::CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+                if (mapping != NULL)
+                {
+                    ptr = (const uchar*)::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                    ::CloseHandle(mapping);  // the view keeps the mapping alive
+                }
+                opened = ptr != NULL;
+            }
+        }
+        ::CloseHandle(file);
+    }
+    ~Impl()
+    {
+        if (ptr)
+            ::UnmapViewOfFile(ptr);
+    }
+
+    const uchar* ptr;
+    size_t size;
+    bool opened;
+
+private:
+    Impl(const Impl&); // disabled
+    Impl& operator=(const Impl&); // disabled
+};
+
+#elif defined __linux__ || defined __APPLE__ || defined __HAIKU__ || defined __FreeBSD__ || defined __GNU__ || defined __EMSCRIPTEN__
+
+struct MappedFile::Impl
+{
+    Impl(const char* fname)
+        : ptr(NULL), size(0), opened(false)
+    {
+        int handle = ::open(fname, O_RDONLY);
+        if (handle == -1)
+            return;
+        struct stat st;
+        if (::fstat(handle, &st) == 0 && S_ISREG(st.st_mode))
+        {
+            size = (size_t)st.st_size;
+            opened = true;
+            if (size > 0)
+            {
+                void* p = ::mmap(NULL, size, PROT_READ, MAP_SHARED, handle, 0);
+                if (p != MAP_FAILED)
+                    ptr = (const uchar*)p;
+                opened = ptr != NULL;
+            }
+        }
+        ::close(handle);  // the mapping stays valid after closing the descriptor
+    }
+    ~Impl()
+    {
+        if (ptr)
+            ::munmap((void*)ptr, size);
+    }
+
+    const uchar* ptr;
+    size_t size;
+    bool opened;
+
+private:
+    Impl(const Impl&); // disabled
+    Impl& operator=(const Impl&); // disabled
+};
+
+#endif
+
+MappedFile::MappedFile(const char* fname)
+    : pImpl(new Impl(fname))
+{
+    if (!pImpl->opened)
+    {
+        CV_LOG_DEBUG(NULL, "Can't map file: " << fname);
+    }
+}
+MappedFile::~MappedFile()
+{
+    delete pImpl;
+    pImpl = NULL;
+}
+
+bool MappedFile::isOpened() const { return pImpl->opened; }
+const uchar* MappedFile::data() const { return pImpl->ptr; }
+size_t MappedFile::size() const { return pImpl->size; }
+
+
 
 cv::String getCacheDirectory(const char* sub_directory_name, const char* configuration_name)
 {
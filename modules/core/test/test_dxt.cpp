@@ -983,4 +983,96 @@ protected:
 TEST(Core_DFT, reverse) { Core_DXTReverseTest test(Core_DXTReverseTest::ModeDFT); test.safe_run(); }
 TEST(Core_DCT, reverse) { Core_DXTReverseTest test(Core_DXTReverseTest::ModeDCT); test.safe_run(); }
 
+typedef testing::TestWithParam<tuple<Size, perf::MatType, int> > Core_DFTPlan;
+
+TEST_P(Core_DFTPlan, same_as_dft)
+{
+    Size sz = get<0>(GetParam());
+    int type = get<1>(GetParam());
+    int flags = get<2>(GetParam());
+    if ((flags & DFT_INVERSE) && CV_MAT_CN(type) == 1)
+        flags &= ~DFT_REAL_OUTPUT;
+
+    DFTPlan plan(sz, type, flags);
+    for (int iter = 0; iter < 3; iter++)
+    {
+        Mat src(sz, type);
+        randu(src, -1., 1.);
+
+        Mat ref, dst;
+        cv::dft(src, ref, flags);
+        plan.apply(src, dst);
+        ASSERT_EQ(ref.type(), plan.dstType());
+        EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+
+        // in-place and non-continuous arguments use their own transform contexts
+        if (ref.type() == type)
+        {
+            Mat inplace = src.clone();
+            plan.apply(inplace, inplace);
+            EXPECT_EQ(0, cvtest::norm(ref, inplace, NORM_INF));
+        }
+        Mat big(sz.height + 2, sz.width + 3, type);
+        Mat roi = big(Rect(1, 1, sz.width, sz.height));
+        src.copyTo(roi);
+        Mat roi_ref;
+        cv::dft(roi, roi_ref, flags);
+        plan.apply(roi, dst);
+        EXPECT_EQ(0, cvtest::norm(roi_ref, dst, NORM_INF));
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Core_DFTPlan, testing::Combine(
+    testing::Values(Size(1, 33), Size(45, 1), Size(16, 9), Size(255, 130), Size(512, 64)),
+    testing::Values(CV_32FC1, CV_32FC2, CV_64FC1, CV_64FC2),
+    testing::Values(0, (int)DFT_ROWS, (int)DFT_COMPLEX_OUTPUT, (int)(DFT_INVERSE | DFT_SCALE),
+                    (int)(DFT_INVERSE | DFT_REAL_OUTPUT), (int)(DFT_ROWS | DFT_INVERSE))
+));
+
+TEST(Core_DFTPlan_batch, accuracy)
+{
+    Size sz(64, 48);
+    DFTPlan plan(sz, CV_32FC1, DFT_COMPLEX_OUTPUT);
+    std::vector<Mat> src(5), dst;
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        src[i].create(sz, CV_32FC1);
+        randu(src[i], -1., 1.);
+    }
+    plan.applyBatch(src, dst);
+    ASSERT_EQ(src.size(), dst.size());
+    for (size_t i = 0; i < src.size(); i++)
+    {
+        Mat ref;
+        cv::dft(src[i], ref, DFT_COMPLEX_OUTPUT);
+        EXPECT_EQ(0, cvtest::norm(ref, dst[i], NORM_INF));
+    }
+    EXPECT_THROW(plan.apply(Mat(sz, CV_32FC2), dst[0]), cv::Exception);
+}
+
+typedef testing::TestWithParam<tuple<perf::MatType, int> > Core_DFT_parallel;
+
+TEST_P(Core_DFT_parallel, same_as_single_thread)
+{
+    int type = get<0>(GetParam());
+    int flags = get<1>(GetParam());
+    Mat src(300, 301, type);
+    randu(src, -1., 1.);
+
+    int nthreads = getNumThreads();
+    Mat ref, dst;
+    setNumThreads(1);
+    cv::dft(src, ref, flags);
+    setNumThreads(4);
+    cv::dft(src, dst, flags);
+    setNumThreads(nthreads);
+    EXPECT_EQ(0, cvtest::norm(ref, dst, NORM_INF));
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Core_DFT_parallel, testing::Combine(
+    testing::Values(CV_32FC1, CV_64FC1, CV_64FC2),
+    testing::Values(0, (int)DFT_INVERSE, (int)DFT_ROWS, (int)(DFT_ROWS | DFT_INVERSE),
+                    (int)DFT_COMPLEX_OUTPUT)
+));
+
 }} // namespace
@@ -1985,4 +1985,176 @@ INSTANTIATE_TEST_CASE_P( /*nothing*/,
     Core_InputOutput_regression_25073,
     Values("test.json", "test.xml", "test.yml") );
 
+typedef testing::TestWithParam< std::string > Core_InputOutput_memory_mapped;
+
+TEST_P(Core_InputOutput_memory_mapped, read)
+{
+    const std::string fname = cv::tempfile(GetParam().c_str());
+    RNG& rng = theRNG();
+    Mat m8u(37, 11, CV_8UC3), m16s(1, 1001, CV_16SC1), m32f(123, 45, CV_32FC2), m64f(7, 3, CV_64FC1);
+    rng.fill(m8u, RNG::UNIFORM, 0, 256);
+    rng.fill(m16s, RNG::UNIFORM, -30000, 30000);
+    rng.fill(m32f, RNG::UNIFORM, -1, 1);
+    rng.fill(m64f, RNG::UNIFORM, -1, 1);
+    std::vector<int> vec(100);
+    for (size_t i = 0; i < vec.size(); i++)
+        vec[i] = (int)i * 7 - 300;
+    {
+        FileStorage fs(fname, FileStorage::WRITE_BASE64);
+        fs << "m8u" << m8u << "m16s" << m16s;
+        fs << "nested" << "{" << "m32f" << m32f << "name" << "text" << "}";
+        fs << "vec" << vec;
+        fs.release();
+        FileStorage fs_plain(fname, FileStorage::APPEND);
+        fs_plain << "m64f_plain" << m64f;
+    }
+
+    FileStorage fs(fname, FileStorage::READ | FileStorage::MEMORY_MAPPED);
+    ASSERT_TRUE(fs.isOpened());
+    Mat m;
+    fs["m8u"] >> m;
+    EXPECT_EQ(0, cvtest::norm(m, m8u, NORM_INF));
+    fs["m16s"] >> m;
+    EXPECT_EQ(0, cvtest::norm(m, m16s, NORM_INF));
+    fs["nested"]["m32f"] >> m;
+    EXPECT_EQ(0, cvtest::norm(m, m32f, NORM_INF));
+    EXPECT_EQ("text", (std::string)fs["nested"]["name"]);
+    fs["m64f_plain"] >> m;
+    EXPECT_EQ(0, cvtest::norm(m, m64f, NORM_INF));
+
+    // element-wise access to a lazily decoded sequence
+    FileNode data = fs["m16s"]["data"];
+    ASSERT_TRUE(data.isSeq());
+    ASSERT_EQ(m16s.total(), data.size());
+    EXPECT_EQ((int)m16s.at<short>(0, 500), (int)data[500]);
+    int idx = 0;
+    for (FileNodeIterator it = data.begin(); it != data.end(); ++it, ++idx)
+        ASSERT_EQ((int)m16s.at<short>(0, idx), (int)*it);
+    EXPECT_EQ((int)m16s.total(), idx);
+
+    std::vector<int> vec_read;
+    fs["vec"] >> vec_read;
+    EXPECT_EQ(vec, vec_read);
+
+    // conversion to another element type goes through the regular nodes
+    std::vector<double> vec_double;
+    fs["vec"] >> vec_double;
+    ASSERT_EQ(vec.size(), vec_double.size());
+    EXPECT_EQ((double)vec[99], vec_double[99]);
+
+    fs.release();
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+INSTANTIATE_TEST_CASE_P( /*nothing*/,
+    Core_InputOutput_memory_mapped,
+    Values(".json", ".xml", ".yml") );
+
+typedef testing::TestWithParam< std::string > Core_InputOutput_base64_large;
+
+TEST_P(Core_InputOutput_base64_large, parallel_encoding)
+{
+    const std::string fname = cv::tempfile(GetParam().c_str());
+    Mat big(1000, 401, CV_32FC3), small(3, 5, CV_16UC1);
+    struct Mixed { int i; double d; } mixed[2] = {{1, 2.5}, {-3, 4.}};
+    randu(big, -1, 1);
+    randu(small, 0, 65536);
+    Mat roi = big(Rect(3, 5, 300, 200)); // written row by row
+
+    std::string text[2];
+    int nthreads = getNumThreads();
+    for (int k = 0; k < 2; k++)
+    {
+        setNumThreads(k == 0 ? 1 : nthreads);
+        FileStorage fs(fname, FileStorage::WRITE_BASE64);
+        fs << "big" << big << "roi" << roi << "small" << small;
+        fs << "mixed" << "[";
+        fs.writeRaw("id", mixed, sizeof(mixed));
+        fs << "]";
+        fs.release();
+        std::ifstream f(fname.c_str(), std::ios::binary);
+        text[k].assign(std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>());
+    }
+    setNumThreads(nthreads);
+    EXPECT_EQ(text[0], text[1]);
+
+    for (int mapped = 0; mapped < 2; mapped++)
+    {
+        FileStorage fs(fname, FileStorage::READ | (mapped ? FileStorage::MEMORY_MAPPED : 0));
+        ASSERT_TRUE(fs.isOpened());
+        Mat m;
+        fs["big"] >> m;
+        EXPECT_EQ(0, cvtest::norm(m, big, NORM_INF));
+        fs["roi"] >> m;
+        EXPECT_EQ(0, cvtest::norm(m, roi, NORM_INF));
+        fs["small"] >> m;
+        EXPECT_EQ(0, cvtest::norm(m, small, NORM_INF));
+        Mixed mixed_read[2] = {};
+        fs["mixed"].readRaw("id", mixed_read, sizeof(mixed_read));
+        EXPECT_EQ(-3, mixed_read[1].i);
+        EXPECT_EQ(4., mixed_read[1].d);
+    }
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+INSTANTIATE_TEST_CASE_P( /*nothing*/,
+    Core_InputOutput_base64_large,
+    Values(".json", ".xml", ".yml") );
+
+typedef testing::TestWithParam< std::string > Core_InputOutput_binary_sidecar;
+
+TEST_P(Core_InputOutput_binary_sidecar, write_read)
+{
+    const std::string fname = cv::tempfile(GetParam().c_str());
+    const std::string sidecar = fname + ".bin";
+    Mat m8u(37, 11, CV_8UC3), m64f(20, 30, CV_64FC1);
+    randu(m8u, 0, 256);
+    randu(m64f, -1, 1);
+    Mat roi = m64f(Rect(1, 2, 7, 9));
+    struct Mixed { int i; float f; double d; } mixed[3] = {{1, 2.f, 3.}, {-4, 5.5f, 6.25}, {7, -8.f, 9.}};
+    {
+        FileStorage fs(fname, FileStorage::WRITE | FileStorage::BINARY_SIDECAR);
+        ASSERT_TRUE(fs.isOpened());
+        fs << "m8u" << m8u << "roi" << roi;
+        fs << "mixed" << "[";
+        fs.writeRaw("ifd", mixed, sizeof(mixed));
+        fs << "]" << "name" << "text";
+    }
+    std::ifstream f(sidecar.c_str(), std::ios::binary | std::ios::ate);
+    ASSERT_TRUE(f.is_open());
+    // m8u, roi and mixed (packed), each one at 64-byte aligned offset
+    size_t sidecar_size = alignSize(alignSize(m8u.total() * m8u.elemSize(), 64) + roi.total() * roi.elemSize(), 64)
+                          + 3 * (4 + 4 + 8);
+    EXPECT_EQ((std::streamoff)sidecar_size, (std::streamoff)f.tellg());
+    f.close();
+
+    for (int mapped = 0; mapped < 2; mapped++)
+    {
+        FileStorage fs(fname, FileStorage::READ | (mapped ? FileStorage::MEMORY_MAPPED : 0));
+        ASSERT_TRUE(fs.isOpened());
+        Mat m;
+        fs["m8u"] >> m;
+        EXPECT_EQ(0, cvtest::norm(m, m8u, NORM_INF));
+        fs["roi"] >> m;
+        EXPECT_EQ(0, cvtest::norm(m, roi, NORM_INF));
+        FileNode data = fs["roi"]["data"];
+        ASSERT_EQ(roi.total(), data.size());
+        EXPECT_EQ(roi.at<double>(8, 6), (double)data[62]);
+        Mixed mixed_read[3] = {};
+        fs["mixed"].readRaw("ifd", mixed_read, sizeof(mixed_read));
+        EXPECT_EQ(-4, mixed_read[1].i);
+        EXPECT_EQ(5.5f, mixed_read[1].f);
+        EXPECT_EQ(9., mixed_read[2].d);
+        EXPECT_EQ("text", (std::string)fs["name"]);
+    }
+    EXPECT_EQ(0, remove(sidecar.c_str()));
+
+    EXPECT_THROW(FileStorage(fname, FileStorage::READ), cv::Exception);
+    EXPECT_EQ(0, remove(fname.c_str()));
+}
+
+INSTANTIATE_TEST_CASE_P( /*nothing*/,
+    Core_InputOutput_binary_sidecar,
+    Values(".json", ".xml", ".yml") );
+
 }} // namespace
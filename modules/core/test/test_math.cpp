@@ -2977,6 +2977,103 @@ TEST(Core_KMeans, bad_input)
     }
 }
 
+TEST(Core_KMeans, same_as_single_thread)
+{
+    const int N = 20000, dims = 24, K = 16;
+    Mat data(N, dims, CV_32F);
+    RNG rng(12345);
+    rng.fill(data, RNG::NORMAL, 0, 1);
+    for (int i = 0; i < N; i++)
+        data.row(i) += Scalar::all((i % 7)*4.0);
+    const TermCriteria crit(TermCriteria::COUNT + TermCriteria::EPS, 30, 1e-4);
+
+    int nthreads = getNumThreads();
+    Mat labels[2], centers[2];
+    double compactness[2];
+    for (int t = 0; t < 2; t++)
+    {
+        setNumThreads(t == 0 ? 1 : std::max(nthreads, 4));
+        theRNG().state = 0x12345678;
+        compactness[t] = kmeans(data, K, labels[t], crit, 2, KMEANS_PP_CENTERS, centers[t]);
+    }
+    setNumThreads(nthreads);
+
+    EXPECT_EQ(compactness[0], compactness[1]);
+    EXPECT_EQ(0, cvtest::norm(labels[0], labels[1], NORM_INF));
+    EXPECT_EQ(0, cvtest::norm(centers[0], centers[1], NORM_INF));
+
+    // the centers are the means of the clusters
+    Mat sums = Mat::zeros(K, dims, CV_64F);
+    std::vector<int> counts(K, 0);
+    for (int i = 0; i < N; i++)
+    {
+        const int l = labels[0].at<int>(i);
+        ASSERT_TRUE(0 <= l && l < K);
+        Mat row;
+        data.row(i).convertTo(row, CV_64F);
+        sums.row(l) += row;
+        counts[l]++;
+    }
+    for (int k = 0; k < K; k++)
+    {
+        ASSERT_GT(counts[k], 0);
+        Mat mean = sums.row(k) / counts[k], center;
+        centers[0].row(k).convertTo(center, CV_64F);
+        EXPECT_LE(cvtest::norm(mean, center, NORM_INF), 1e-3) << "k=" << k;
+    }
+}
+
+TEST(Core_MiniBatchKMeans, blobs)
+{
+    const int K = 5, dims = 3, batch = 500, nbatches = 20;
+    const float truth[K][dims] = { {0, 0, 0}, {20, 0, 0}, {0, 20, 0}, {0, 0, 20}, {20, 20, 20} };
+    RNG rng(0);
+
+    MiniBatchKMeans mbk(K);
+    EXPECT_FALSE(mbk.empty());
+    EXPECT_TRUE(mbk.centers().empty());
+    for (int b = 0; b < nbatches; b++)
+    {
+        Mat samples(batch, 1, CV_32FC3);
+        rng.fill(samples, RNG::NORMAL, 0, 1);
+        for (int i = 0; i < batch; i++)
+            samples.at<Vec3f>(i) += Vec3f(truth[i % K]);
+        mbk.update(samples);
+    }
+    EXPECT_EQ((int64)batch * nbatches, mbk.samplesSeen());
+
+    Mat centers = mbk.centers();
+    ASSERT_EQ(K, centers.rows);
+    ASSERT_EQ(dims, centers.cols);
+    std::vector<int> matched(K, -1);
+    for (int k = 0; k < K; k++)
+    {
+        Mat c(1, dims, CV_32F, (void*)truth[k]);
+        double best = DBL_MAX;
+        for (int j = 0; j < K; j++)
+        {
+            double d = cvtest::norm(c, centers.row(j), NORM_L2);
+            if (d < best)
+            {
+                best = d;
+                matched[k] = j;
+            }
+        }
+        EXPECT_LT(best, 0.5) << "k=" << k;
+    }
+
+    Mat test(K, dims, CV_32F, (void*)truth), labels;
+    double compactness = mbk.predict(test, labels);
+    EXPECT_LT(compactness, K*0.25);
+    ASSERT_EQ(K, labels.rows);
+    for (int k = 0; k < K; k++)
+        EXPECT_EQ(matched[k], labels.at<int>(k));
+
+    MiniBatchKMeans none;
+    EXPECT_TRUE(none.empty());
+    EXPECT_ANY_THROW(none.update(test));
+}
+
 TEST(CovariationMatrixVectorOfMat, accuracy)
 {
     unsigned int col_problem_size = 8, row_problem_size = 8, vector_size = 16;
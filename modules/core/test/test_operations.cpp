@@ -1528,6 +1528,97 @@ TEST(Core_sortIdx, regression_8941)
         "expected=" << std::endl << expected;
 }
 
+TEST(Core_sort, long_lines)
+{
+    const int depths[] = { CV_8U, CV_8S, CV_16U, CV_16S, CV_32S, CV_32F, CV_64F };
+    RNG& rng = theRNG();
+    for (size_t d = 0; d < sizeof(depths)/sizeof(depths[0]); d++)
+    {
+        for (int flags = 0; flags < 4; flags++)
+        {
+            SCOPED_TRACE(cv::format("depth=%d flags=%d", depths[d], flags));
+            Mat src(300, 600, CV_MAKETYPE(depths[d], 1)), dst;
+            rng.fill(src, RNG::UNIFORM, -1000, 1000);
+            cv::sort(src, dst, flags);
+
+            bool isColumn = (flags & SORT_EVERY_COLUMN) != 0;
+            Mat ref = isColumn ? src.t() : src.clone();
+            ref.convertTo(ref, CV_64F);
+            for (int i = 0; i < ref.rows; i++)
+            {
+                double* ptr = ref.ptr<double>(i);
+                std::sort(ptr, ptr + ref.cols);
+                if (flags & SORT_DESCENDING)
+                    std::reverse(ptr, ptr + ref.cols);
+            }
+            Mat res = isColumn ? dst.t() : dst;
+            res.convertTo(res, CV_64F);
+            EXPECT_EQ(0, cvtest::norm(ref, res, NORM_INF));
+        }
+    }
+}
+
+TEST(Core_topK, accuracy)
+{
+    const int depths[] = { CV_8U, CV_16S, CV_32S, CV_32F, CV_64F };
+    RNG& rng = theRNG();
+    for (size_t d = 0; d < sizeof(depths)/sizeof(depths[0]); d++)
+    {
+        for (int flags = 0; flags < 4; flags++)
+        {
+            SCOPED_TRACE(cv::format("depth=%d flags=%d", depths[d], flags));
+            Mat src(40, 1000, CV_MAKETYPE(depths[d], 1));
+            rng.fill(src, RNG::UNIFORM, -100, 100);
+            bool isColumn = (flags & SORT_EVERY_COLUMN) != 0;
+            if (isColumn)
+                src = src.t();
+
+            const int k = 17;
+            Mat values, indices, sorted;
+            cv::topK(src, values, indices, k, flags);
+            cv::sort(src, sorted, flags);
+            ASSERT_EQ(CV_32S, indices.type());
+            ASSERT_EQ(src.type(), values.type());
+            ASSERT_EQ(isColumn ? Size(src.cols, k) : Size(k, src.rows), values.size());
+            ASSERT_EQ(values.size(), indices.size());
+
+            Mat sortedK = isColumn ? sorted.rowRange(0, k) : sorted.colRange(0, k);
+            EXPECT_EQ(0, cvtest::norm(sortedK, values, NORM_INF));
+
+            // the indices refer to the selected values, ties keep the index order
+            Mat src64, values64;
+            src.convertTo(src64, CV_64F);
+            values.convertTo(values64, CV_64F);
+            if (isColumn)
+            {
+                src64 = src64.t();
+                values64 = values64.t();
+                indices = indices.t();
+            }
+            for (int i = 0; i < src64.rows; i++)
+            {
+                for (int j = 0; j < k; j++)
+                {
+                    int idx = indices.at<int>(i, j);
+                    ASSERT_EQ(src64.at<double>(i, idx), values64.at<double>(i, j));
+                    if (j > 0 && values64.at<double>(i, j) == values64.at<double>(i, j - 1))
+                    {
+                        EXPECT_LT(indices.at<int>(i, j - 1), idx);
+                    }
+                }
+            }
+        }
+    }
+
+    Mat src(3, 10, CV_32F, Scalar(1)), values, indices;
+    cv::topK(src, noArray(), indices, 10);
+    for (int j = 0; j < 10; j++)
+        EXPECT_EQ(j, indices.at<int>(1, j));
+    EXPECT_THROW(cv::topK(src, values, indices, 11), cv::Exception);
+    EXPECT_THROW(cv::topK(src, values, indices, 0), cv::Exception);
+    EXPECT_THROW(cv::topK(src, noArray(), noArray(), 1), cv::Exception);
+}
+
 TEST(Core_Mat, augmentation_operations_9688)
 {
     {
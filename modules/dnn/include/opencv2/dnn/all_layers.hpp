@@ -1146,6 +1146,7 @@ CV__DNN_INLINE_NS_BEGIN
         CV_DEPRECATED_EXTERNAL bool hasBias; // Deprecated, preserve for compatibility
         int axis;
         float epsilon;
+        bool fusedAdd = false; // the residual is passed as the last input and added to X before the normalization
 
         static Ptr<LayerNormLayer> create(const LayerParams& params);
     };
@@ -1162,6 +1163,8 @@ CV__DNN_INLINE_NS_BEGIN
 
     class CV_EXPORTS MatMulLayer : public Layer {
      public:
+        bool fusedAdd = false; // the residual is passed as the last input and added to the output
+
         static Ptr<MatMulLayer> create(const LayerParams &params);
     };
 
@@ -1181,6 +1184,21 @@ CV__DNN_INLINE_NS_BEGIN
     class CV_EXPORTS AttentionLayer : public Layer {
      public:
         static Ptr<AttentionLayer> create(const LayerParams &params);
+
+        /** @brief Enables the key/value cache for the incremental decoding.
+         *
+         * With the cache each forward() appends the keys and values of the input tokens to the cache
+         * and the queries attend to all the cached tokens, so a decoder may pass a single new token
+         * per forward() instead of the whole sequence. Usually it is used with the `unidirectional`
+         * (causal) attention. The cache is reset.
+         */
+        virtual void setUseKVCache(bool use = true) = 0;
+
+        /** @brief Drops the cached keys and values, e.g. before decoding of a new sequence. */
+        virtual void resetKVCache() = 0;
+
+        /** @brief Returns the number of the cached tokens. */
+        virtual int getKVCacheLength() const = 0;
     };
 
     class CV_EXPORTS GroupNormLayer : public Layer {
@@ -43,6 +43,7 @@
 #define OPENCV_DNN_DNN_HPP
 
 #include <vector>
+#include <future>
 #include <opencv2/core.hpp>
 #include "opencv2/core/async.hpp"
 
@@ -104,7 +105,7 @@ CV__DNN_INLINE_NS_BEGIN
         DNN_TARGET_CUDA_FP16,
         DNN_TARGET_HDDL,
         DNN_TARGET_NPU,
-        DNN_TARGET_CPU_FP16, // Only the ARM platform is supported. Low precision computing, accelerate model inference.
+        DNN_TARGET_CPU_FP16, //!< Low precision computing, accelerate model inference. ARMv8: FP16 arithmetic in the convolutions. Other CPUs: the weights are stored in FP16, the computations are done in FP32.
     };
 
     /**
@@ -449,6 +450,12 @@ CV__DNN_INLINE_NS_BEGIN
         virtual int64 getFLOPS(const std::vector<MatShape> &inputs,
                                const std::vector<MatShape> &outputs) const {CV_UNUSED(inputs); CV_UNUSED(outputs); return 0;}
 
+        /** @brief Returns the name of the kernel selected by the layer for the current inputs
+         *  (e.g. "winograd3x3" or "depthwise3x3" for the convolution), reported by Net::dumpProfile().
+         *  Empty by default.
+         */
+        virtual String getKernelName() const;
+
         virtual bool updateMemoryShapes(const std::vector<MatShape> &inputs);
 
         CV_PROP String name; //!< Name of the layer instance, can be used for logging or other internal purposes.
@@ -526,6 +533,19 @@ CV__DNN_INLINE_NS_BEGIN
         */
         CV_WRAP void dumpToPbtxt(CV_WRAP_FILE_PATH const String& path);
 
+        /** @brief Saves the network together with its prepared state into a compiled network file.
+         *  @param path   path to the output file
+         *
+         *  The file keeps the graph, the layer parameters and the weights (aligned, so that they are used
+         *  from the memory mapped file without copying), the backend, target and fusion settings and
+         *  the input shapes. The convolution weights packed for the current CPU are stored as well:
+         *  call the method after forward() to skip the packing when the file is loaded.
+         *  The packed weights are used only on the same OpenCV build and CPU features,
+         *  otherwise they are packed again from the original weights.
+         *  @see readNetFromCompiled()
+         */
+        CV_WRAP void save(CV_WRAP_FILE_PATH const String& path);
+
         /** @brief Adds new layer to the net.
          *  @param name   unique name of the adding layer.
          *  @param type   typename of the adding layer (type must be registered in LayerRegister).
@@ -633,10 +653,24 @@ CV__DNN_INLINE_NS_BEGIN
          *  @details By default runs forward pass for the whole network.
          *
          *  This is an asynchronous version of forward(const String&).
-         *  dnn::DNN_BACKEND_INFERENCE_ENGINE backend is required.
+         *  dnn::DNN_BACKEND_INFERENCE_ENGINE backend or dnn::DNN_BACKEND_OPENCV backend
+         *  with CPU targets is required.
+         *
+         *  With dnn::DNN_BACKEND_OPENCV the inputs are copied into the request, so the next inputs can be set
+         *  right after the call. The requests are processed concurrently by the worker threads (see setAsyncQueueDepth()).
+         *  The call blocks while the number of the incomplete requests reaches the queue depth.
+         *  Re-initialization of the network (new input shape, backend, target, etc.) waits for the incomplete requests.
          */
         CV_WRAP AsyncArray forwardAsync(const String& outputName = String());
 
+        /** @brief Sets the maximal number of the incomplete requests of forwardAsync().
+         *
+         *  Used by dnn::DNN_BACKEND_OPENCV backend with CPU targets. Every in-flight request has
+         *  own buffers of the intermediate blobs, the weights are shared.
+         *  @param depth number of the concurrently processed requests, 2 by default.
+         */
+        CV_WRAP void setAsyncQueueDepth(int depth);
+
         /** @brief Runs forward pass to compute output of layer with name @p outputName.
          *  @param outputBlobs contains all output blobs for specified layer.
          *  @param outputName name for layer which output is needed to get
@@ -713,6 +747,7 @@ CV__DNN_INLINE_NS_BEGIN
          * | DNN_TARGET_CUDA        |                    |                              |                    |                 + |
          * | DNN_TARGET_CUDA_FP16   |                    |                              |                    |                 + |
          * | DNN_TARGET_HDDL        |                    |                            + |                    |                   |
+         * | DNN_TARGET_CPU_FP16    |                  + |                              |                    |                   |
          */
         CV_WRAP void setPreferableTarget(int targetId);
 
@@ -828,6 +863,9 @@ CV__DNN_INLINE_NS_BEGIN
 
         /** @brief Computes bytes number which are required to store
          * all weights and intermediate blobs for model.
+         *
+         * For #DNN_BACKEND_OPENCV with CPU targets the intermediate blobs share the memory
+         * according to their lifetimes, so @p blobs is the planned peak of the activations memory.
          * @param netInputShapes vector of shapes for all net inputs.
          * @param weights output parameter to store resulting bytes for weights.
          * @param blobs output parameter to store resulting bytes for intermediate blobs.
@@ -874,6 +912,45 @@ CV__DNN_INLINE_NS_BEGIN
         */
         CV_WRAP void enableWinograd(bool useWinograd);
 
+        /** @brief Sets the storage type of the constant weights of FullyConnected (InnerProduct), MatMul and Gemm layers.
+         *
+         * The weight-only compression reduces the memory footprint and the memory traffic of the large
+         * matrix multiplications, e.g. in the transformers. The weights are converted back to float32 block by block
+         * during the multiplication, the accumulation and the activations stay in float32.
+         * Used by DNN_BACKEND_OPENCV on CPU targets only.
+         * @param type CV_32F (no compression, default), CV_16F or CV_8S (symmetric quantization per output channel).
+         */
+        CV_WRAP void setWeightsCompression(int type);
+
+        /** @brief Enables or disables concurrent execution of the independent layers.
+         *
+         * The layers are grouped into the levels of the network graph: the layers of the same level
+         * don't depend on each other and run in parallel, each of them in a single thread. The levels
+         * with a single layer use all the threads as usual. This speeds up the networks with many small
+         * parallel branches (Inception-like blocks, feature pyramids, multi-head detectors).
+         * The memory of the intermediate blobs is planned so that the concurrent layers never share it,
+         * so the results are the same as with the sequential execution.
+         *
+         * Supported by #DNN_BACKEND_OPENCV with #DNN_TARGET_CPU and #DNN_TARGET_CPU_FP16 targets.
+         * @param enable true to enable the inter-layer parallelism. The default is false.
+         */
+        CV_WRAP void enableInterLayerParallelism(bool enable);
+
+        /** @brief Enables caching of the execution plans for the different input shapes.
+         *
+         * A change of the input shape makes the network to re-run the shapes inference and
+         * to re-allocate the intermediate blobs. With enabled cache the allocated plans of
+         * the recently used input shapes are kept, so switching back to one of them reuses
+         * the computed shapes and the allocated memory. The least recently used plans are
+         * evicted when the limits are exceeded.
+         *
+         * The cache is used by #DNN_BACKEND_OPENCV with #DNN_TARGET_CPU and #DNN_TARGET_CPU_FP16 targets.
+         * @param maxPlans maximal number of the cached plans. 0 disables the cache (default).
+         * @param maxMemory maximal total size (in bytes) of the memory held by the cached plans,
+         *                  0 means no limit.
+         */
+        CV_WRAP void setPlanCacheLimits(int maxPlans, size_t maxMemory = 0);
+
         /** @brief Returns overall time for inference and timings (in ticks) for layers.
          *
          * Indexes in returned vector correspond to layers ids. Some layers can be fused with others,
@@ -884,6 +961,49 @@ CV__DNN_INLINE_NS_BEGIN
          */
         CV_WRAP int64 getPerfProfile(CV_OUT std::vector<double>& timings);
 
+        /** @brief Enables the per-layer profiling of forward().
+         *
+         * The time of every layer is accumulated over the forward() calls, see dumpProfile().
+         * The call resets the collected profile. Supported by DNN_BACKEND_OPENCV.
+         */
+        CV_WRAP void enableProfiling(bool enable);
+
+        /** @brief Returns the per-layer profile collected since enableProfiling() call.
+         *
+         * For every layer the profile contains the number of calls, the average and minimal time,
+         * the FLOPs (see Layer::getFLOPS()), the bytes read (inputs and weights) and written (outputs),
+         * the achieved GFLOP/s, GB/s (by the average time) and the arithmetic intensity (FLOP/byte),
+         * which place the layer on the roofline of the CPU.
+         * The kernel selected by the layer (see Layer::getKernelName()) and the fusion are reported too:
+         * the layers skipped after the fusion refer to the layer which computes them, their FLOPs are
+         * accounted there. The FLOPs and bytes are computed for the current input shapes.
+         * @param format "json" or "csv".
+         */
+        CV_WRAP String dumpProfile(const String& format = "json");
+
+        /** @brief Writes the profile to the file, the format is selected by the extension (.json or .csv).
+         *  @see dumpProfile()
+         */
+        CV_WRAP void dumpProfileToFile(CV_WRAP_FILE_PATH const String& path);
+
+        /** @brief Creates an execution context of the network.
+         *
+         * The context shares the layers of this network with their weights and prepacked data
+         * (e.g. the packed convolution weights) and owns only the memory of the intermediate blobs.
+         * The network and its contexts can run forward() concurrently from different threads,
+         * while every context is used by a single thread at a time.
+         *
+         * The inputs of the network must be set: the network is allocated (if needed) and run once,
+         * so that the layers finish their initialization before they are shared.
+         * The context inherits the input shapes and the preserved outputs of the network:
+         * setting inputs of another shape or type, requesting outputs which are not preserved
+         * by the network (compute them with the base network before the call) or changing the backend,
+         * target or fusion of the context raises an error. The base network must not be re-initialized
+         * (e.g. run with inputs of another shape) while its contexts are in use.
+         * Only DNN_BACKEND_OPENCV with DNN_TARGET_CPU or DNN_TARGET_CPU_FP16 is supported.
+         */
+        CV_WRAP Net createExecutionContext();
+
 
         struct Impl;
         inline Impl* getImpl() const { return impl.get(); }
@@ -1120,6 +1240,16 @@ CV__DNN_INLINE_NS_BEGIN
      */
     CV_EXPORTS_W Net readNetFromONNX(const std::vector<uchar>& buffer);
 
+    /** @brief Reads a network saved by Net::save().
+     *  @param path path to the compiled network file.
+     *  @returns Network object that ready to do forward, throw an exception in failure cases.
+     *
+     *  The file is memory mapped, the weights are used without copying and the file stays mapped
+     *  while the network exists. The network is restored with its backend, target, fusion settings
+     *  and input shapes.
+     */
+    CV_EXPORTS_W Net readNetFromCompiled(CV_WRAP_FILE_PATH const String& path);
+
     /** @brief Creates blob from .pb file.
      *  @param path to the .pb file with input tensor.
      *  @returns Mat.
@@ -1387,6 +1517,53 @@ CV__DNN_INLINE_NS_BEGIN
                                    const float sigma = 0.5,
                                    SoftNMSMethod method = SoftNMSMethod::SOFTNMS_GAUSSIAN);
 
+    /** @brief Performs multi-class non maximum suppression on the matrices of boxes and class scores.
+     *
+     * It is a faster alternative of NMSBoxesBatched() for the raw outputs of the detection models
+     * with many candidates: the scores are filtered without building the per-box lists, the classes
+     * are processed in parallel and the overlaps are computed with SIMD.
+     * @param bboxes Nx4 matrix of axis-aligned boxes (x, y, width, height) or Nx5 matrix of rotated boxes
+     * (center x, center y, width, height, angle in degrees), CV_32F. [1 x N x K] blobs are accepted as well.
+     * If @p scores is empty, @p bboxes is Nx(4+C) matrix with the axis-aligned boxes in the first 4 columns
+     * followed by the scores of C classes.
+     * @param scores NxC matrix of class scores, CV_32F.
+     * @param score_threshold only the scores greater than the threshold are considered.
+     * @param nms_threshold a threshold used in non maximum suppression.
+     * @param indices the kept rows of @p bboxes sorted by score in descending order.
+     * @param class_ids the classes of the kept boxes.
+     * @param eta a coefficient in adaptive threshold formula: \f$nms\_threshold_{i+1}=eta\cdot nms\_threshold_i\f$.
+     * @param top_k if `>0`, at most @p top_k candidates of each class are processed and at most @p top_k boxes are kept.
+     * @param multi_label if false, a box is a candidate of its best-scored class only,
+     * otherwise it is a candidate of each class with the score above @p score_threshold.
+     */
+    CV_EXPORTS_W void NMSBoxesMultiClass(InputArray bboxes, InputArray scores,
+                                         const float score_threshold, const float nms_threshold,
+                                         CV_OUT std::vector<int>& indices, CV_OUT std::vector<int>& class_ids,
+                                         const float eta = 1.f, const int top_k = 0, bool multi_label = false);
+
+    /** @brief Performs multi-class soft non maximum suppression on the matrices of boxes and class scores.
+     *
+     * See NMSBoxesMultiClass() for the description of the inputs and softNMSBoxes() for the algorithm.
+     * @param bboxes Nx4 or Nx5 matrix of boxes, or Nx(4+C) matrix of boxes and scores.
+     * @param scores NxC matrix of class scores, CV_32F.
+     * @param updated_scores the updated scores of the kept boxes.
+     * @param score_threshold a threshold used to filter boxes by score.
+     * @param nms_threshold a threshold used in non maximum suppression.
+     * @param indices the kept rows of @p bboxes sorted by the updated score in descending order.
+     * @param class_ids the classes of the kept boxes.
+     * @param top_k keep at most @p top_k boxes of each class and in total.
+     * @param sigma parameter of Gaussian weighting.
+     * @param method Gaussian or linear.
+     * @param multi_label if false, a box is a candidate of its best-scored class only.
+     */
+    CV_EXPORTS_W void softNMSBoxesMultiClass(InputArray bboxes, InputArray scores,
+                                             CV_OUT std::vector<float>& updated_scores,
+                                             const float score_threshold, const float nms_threshold,
+                                             CV_OUT std::vector<int>& indices, CV_OUT std::vector<int>& class_ids,
+                                             size_t top_k = 0, const float sigma = 0.5,
+                                             SoftNMSMethod method = SoftNMSMethod::SOFTNMS_GAUSSIAN,
+                                             bool multi_label = false);
+
 
      /** @brief This class is presented high-level API for neural networks.
       *
@@ -1932,6 +2109,97 @@ public:
     CV_WRAP int getMaxCandidates() const;
 };
 
+/** @brief Dynamic batching of the requests of the models.
+ *
+ * The frames are submitted asynchronously (for example, by the threads of the different video streams),
+ * the collector thread combines them into the batches of up to @ref Params::maxBatchSize frames
+ * and runs the network once per batch. A batch is started when it is full or
+ * the oldest queued frame waits for @ref Params::maxDelay milliseconds.
+ * The outputs are split by the batch dimension, postprocessed and returned per frame.
+ *
+ * The frames are resized to the input size of the model (see Model::setInputSize()), which must be set,
+ * and the network must accept the variable batch size.
+ * The network is used by the collector thread only, the model must not be used by the other threads
+ * while the batching front-end exists. The destructor waits for the queued requests.
+ *
+ * @note The batched postprocessing is supported for ClassificationModel and DetectionModel
+ * (DetectionOutput and Region output layers).
+ */
+class CV_EXPORTS BatchingModel
+{
+public:
+    struct CV_EXPORTS Params
+    {
+        Params();
+
+        int maxBatchSize;   //!< the maximal number of the frames in a batch, 8 by default
+        double maxDelay;    //!< the maximal wait of a frame for the batch to be filled (in milliseconds), 5 by default
+        int maxQueueSize;   //!< the submission blocks while there are maxQueueSize queued frames, 0 (default) means unlimited
+        bool padBatch;      //!< pads the partial batches to maxBatchSize, so the network is not reallocated
+                            //!< when the batch size changes, false by default
+    };
+
+    /** @brief The counters since the creation or the last resetStatistics() call.
+     *
+     * The latency of a request is measured from the submission until its result is set,
+     * the queue wait is the part of the latency before the start of its batch.
+     */
+    struct CV_EXPORTS Statistics
+    {
+        Statistics();
+
+        size_t queueDepth;      //!< the current number of the queued frames
+        size_t maxQueueDepth;   //!< the maximal number of the queued frames
+        size_t numRequests;     //!< the number of the completed requests
+        size_t numBatches;      //!< the number of the processed batches
+        double avgBatchSize;
+        double avgQueueWait;    //!< in milliseconds
+        double avgInferenceTime;  //!< the average time of forward() of a batch, in milliseconds
+        double avgLatency;      //!< in milliseconds
+        double maxLatency;      //!< in milliseconds
+    };
+
+    //! The result of DetectionModel::detect() for a frame
+    struct Detections
+    {
+        std::vector<int> classIds;
+        std::vector<float> confidences;
+        std::vector<Rect> boxes;
+    };
+
+    /** @brief Creates the batching front-end of the model.
+     *  @param[in] model The model, it shares the network with the front-end.
+     *  @param[in] params The batching parameters.
+     */
+    explicit BatchingModel(const Model& model, const Params& params = Params());
+    ~BatchingModel();
+
+    /** @brief Queues the frame and returns the outputs of the network for it, see Model::predict().
+     *
+     * The outputs have the batch size 1.
+     */
+    std::future<std::vector<Mat> > predict(InputArray frame);
+
+    /** @brief Queues the frame and returns the top-1 class of it, see ClassificationModel::classify().
+     *
+     * The model must be ClassificationModel.
+     */
+    std::future<std::pair<int, float> > classify(InputArray frame);
+
+    /** @brief Queues the frame and returns the detections of it, see DetectionModel::detect().
+     *
+     * The model must be DetectionModel.
+     */
+    std::future<Detections> detect(InputArray frame, float confThreshold = 0.5f, float nmsThreshold = 0.0f);
+
+    Statistics getStatistics() const;
+    void resetStatistics();
+
+    struct Impl;
+protected:
+    Ptr<Impl> impl;
+};
+
 //! @}
 CV__DNN_INLINE_NS_END
 }
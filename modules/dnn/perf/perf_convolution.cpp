@@ -908,6 +908,7 @@ typedef TestBaseWithParam<ConvTestParam_t> Conv;
 typedef TestBaseWithParam<ConvTestParam_t> Conv_1x1;
 typedef TestBaseWithParam<Conv3x3S1D1TestParam_t> Conv_3x3S1D1;
 typedef TestBaseWithParam<ConvTestParam_t> Conv_Depthwise;
+typedef TestBaseWithParam<ConvParam_t> Conv_Int8;
 
 PERF_TEST_P_(Conv, conv)
 {
@@ -972,6 +973,26 @@ PERF_TEST_P_(Conv_Depthwise, conv)
     SANITY_CHECK_NOTHING();
 }
 
+PERF_TEST_P_(Conv_Int8, conv)
+{
+    const ConvParam_t& params = GetParam();
+    Net net = build_net(params, DNN_BACKEND_OPENCV, DNN_TARGET_CPU);
+
+    Mat input(4, params.shapeIn.dims, CV_32F);
+    randu(input, -1.0f, 1.0f);
+    Net qnet = net.quantize(input, CV_32F, CV_32F);
+    qnet.setPreferableBackend(DNN_BACKEND_OPENCV);
+    qnet.setPreferableTarget(DNN_TARGET_CPU);
+    qnet.setInput(input);
+    Mat output = qnet.forward();  // warmup
+
+    TEST_CYCLE()
+    {
+        Mat res = qnet.forward();
+    }
+    SANITY_CHECK_NOTHING();
+}
+
 ConvParamGenerator conv_params(testConvolution_Configs, sizeof(testConvolution_Configs) / sizeof(testConvolution_Configs[0]));
 INSTANTIATE_TEST_CASE_P(/**/, Conv, Combine(
     conv_params.all(),
@@ -997,4 +1018,8 @@ INSTANTIATE_TEST_CASE_P(/**/, Conv_Depthwise, Combine(
     dnnBackendsAndTargets(false, false)  // defined in ../test/test_common.hpp
 ));
 
+INSTANTIATE_TEST_CASE_P(Conv_3x3S1D1, Conv_Int8, conv_3x3S1D1_params.all());
+INSTANTIATE_TEST_CASE_P(Conv_1x1, Conv_Int8, conv_1x1_params.all());
+INSTANTIATE_TEST_CASE_P(Conv_Depthwise, Conv_Int8, conv_depthwise_params.all());
+
 } // namespace
@@ -402,6 +402,119 @@ PERF_TEST_P_(MatMul, innerproduct)
     SANITY_CHECK_NOTHING();
 }
 
+// weight-only compression of the constant B, small M is typical for the decoders of the language models
+typedef TestBaseWithParam<tuple<std::vector<int>, int> > Gemm_WeightsCompression;
+PERF_TEST_P_(Gemm_WeightsCompression, gemm)
+{
+    const std::vector<int> mnk = get<0>(GetParam());
+    const int type = get<1>(GetParam());
+    const int M = mnk[0], N = mnk[1], K = mnk[2];
+
+    Mat A(M, K, CV_32F);
+    randu(A, -1.0f, 1.0f);
+    Mat B(K, N, CV_32F);
+    randu(B, -1.0f, 1.0f);
+
+    LayerParams lp;
+    lp.type = "Gemm";
+    lp.name = "testLayer";
+    lp.set("constB", true);
+    lp.blobs.push_back(B);
+
+    Net net;
+    net.addLayerToPrev(lp.name, lp.type, lp);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setWeightsCompression(type);
+
+    // warmup
+    {
+        net.setInput(A);
+        Mat out = net.forward();
+    }
+
+    TEST_CYCLE()
+    {
+        Mat res = net.forward();
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Gemm_WeightsCompression, Combine(
+    Values(std::vector<int>{1, 3072, 768}, std::vector<int>{8, 4096, 1024}, std::vector<int>{197, 2304, 768}),
+    Values(CV_32F, CV_16F, CV_8S)
+));
+
+// MLP of the transformer encoder block: MatMul + bias, GELU, MatMul + bias, residual Add and LayerNorm,
+// with the fusion the bias, GELU and residual are applied in the GEMM epilogues
+typedef TestBaseWithParam<tuple<std::vector<int>, bool> > MatMul_TransformerMLP;
+PERF_TEST_P_(MatMul_TransformerMLP, forward)
+{
+    const std::vector<int> params = get<0>(GetParam());
+    const bool fusion = get<1>(GetParam());
+    const int seq_len = params[0], dim = params[1], hidden = params[2];
+
+    int input_shape[] = {1, seq_len, dim};
+    Mat input(3, input_shape, CV_32F);
+    randu(input, -1.0f, 1.0f);
+
+    Net net;
+    for (int i = 0; i < 2; i++)
+    {
+        const int K = i == 0 ? dim : hidden, N = i == 0 ? hidden : dim;
+        Mat weights(K, N, CV_32F), bias(N, 1, CV_32F);
+        randu(weights, -0.05f, 0.05f);
+        randu(bias, -0.1f, 0.1f);
+
+        LayerParams lp;
+        lp.type = "MatMul";
+        lp.name = format("fc%d", i + 1);
+        lp.set("real_ndims_C", 1);
+        lp.blobs.push_back(weights);
+        lp.blobs.push_back(bias);
+        net.addLayerToPrev(lp.name, lp.type, lp);
+        if (i == 0)
+        {
+            LayerParams gelu;
+            net.addLayerToPrev("gelu", "Gelu", gelu);
+        }
+    }
+
+    LayerParams add;
+    add.set("operation", "add");
+    int add_id = net.addLayerToPrev("add", "NaryEltwise", add);
+    net.connect(0, 0, add_id, 1);
+
+    LayerParams norm;
+    norm.set("axis", 2);
+    Mat scale(dim, 1, CV_32F, Scalar(1)), shift(dim, 1, CV_32F, Scalar(0));
+    norm.blobs.push_back(scale);
+    norm.blobs.push_back(shift);
+    net.addLayerToPrev("norm", "LayerNormalization", norm);
+
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(DNN_TARGET_CPU);
+    net.enableFusion(fusion);
+
+    // warmup
+    {
+        net.setInput(input);
+        Mat out = net.forward();
+    }
+
+    TEST_CYCLE()
+    {
+        Mat res = net.forward();
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, MatMul_TransformerMLP, Combine(
+    Values(std::vector<int>{197, 768, 3072}, std::vector<int>{850, 256, 2048}),
+    testing::Bool()
+));
+
 INSTANTIATE_TEST_CASE_P(/**/, Gemm, Combine(
     GemmParamId::all(),
     dnnBackendsAndTargets(false, false)  // defined in ../test/test_common.hpp
@@ -783,6 +783,11 @@ PERF_TEST_P_(Layer_Attention, VisionTransformer) {
     test_layer({1, 197, 768}, {768, 768, 768}, 12);
 }
 
+// the score matrix of a long sequence is not materialized
+PERF_TEST_P_(Layer_Attention, LongSequence) {
+    test_layer({1, 2048, 256}, {256, 256, 256}, 4);
+}
+
 struct Layer_GroupNorm : public TestBaseWithParam<tuple<Backend, Target> >
 {
     void test_layer(const std::vector<int>& x_shape, int num_groups)
@@ -447,4 +447,80 @@ PERF_TEST_P_(DNNTestNetwork, VIT_B_32)
 
 INSTANTIATE_TEST_CASE_P(/*nothing*/, DNNTestNetwork, dnnBackendsAndTargets());
 
+// Throughput of N concurrent workers running either the execution contexts
+// of one network (shared weights) or N separately loaded networks
+typedef tuple<int, bool> ExecutionContextsParams;
+typedef TestBaseWithParam<ExecutionContextsParams> DNNExecutionContexts;
+
+PERF_TEST_P(DNNExecutionContexts, SqueezeNet_v1_1, Combine(Values(2, 4, 8), testing::Bool()))
+{
+    const int nworkers = get<0>(GetParam());
+    const bool shared = get<1>(GetParam());
+    const std::string weights = findDataFile("dnn/squeezenet_v1.1.caffemodel", false);
+    const std::string proto = findDataFile("dnn/squeezenet_v1.1.prototxt");
+
+    Mat input_data(Size(227, 227), CV_32FC3);
+    randu(input_data, 0.0f, 1.0f);
+    Mat input = blobFromImage(input_data, 1.0, Size(), Scalar(), false);
+
+    std::vector<Net> nets(nworkers);
+    Net base;
+    if (shared)
+    {
+        base = readNet(weights, proto);
+        base.setInput(input);
+        base.forward();
+    }
+    for (int i = 0; i < nworkers; i++)
+    {
+        if (shared)
+            nets[i] = base.createExecutionContext();
+        else
+        {
+            nets[i] = readNet(weights, proto);
+            nets[i].setInput(input);
+            nets[i].forward();  // warmup
+        }
+    }
+
+    PERF_SAMPLE_BEGIN()
+        parallel_for_(Range(0, nworkers), [&](const Range& r)
+        {
+            for (int i = r.start; i < r.end; i++)
+            {
+                nets[i].setInput(input);
+                nets[i].forward();
+            }
+        }, nworkers);
+    PERF_SAMPLE_END()
+
+    SANITY_CHECK_NOTHING();
+}
+
+// Inception blocks with and without concurrent execution of the independent branches
+typedef TestBaseWithParam<bool> DNNInterLayerParallelism;
+
+PERF_TEST_P(DNNInterLayerParallelism, GoogLeNet, testing::Bool())
+{
+    const bool enable = GetParam();
+    Net net = readNet(findDataFile("dnn/bvlc_googlenet.caffemodel", false),
+                      findDataFile("dnn/bvlc_googlenet.prototxt"));
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.enableInterLayerParallelism(enable);
+
+    Mat input_data(Size(224, 224), CV_32FC3);
+    randu(input_data, 0.0f, 1.0f);
+    Mat input = blobFromImage(input_data, 1.0, Size(), Scalar(), false);
+    net.setInput(input);
+    net.forward();  // warmup
+
+    TEST_CYCLE()
+    {
+        net.setInput(input);
+        net.forward();
+    }
+
+    SANITY_CHECK_NOTHING();
+}
+
 } // namespace
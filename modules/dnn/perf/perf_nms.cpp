@@ -0,0 +1,79 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "perf_precomp.hpp"
+
+namespace opencv_test {
+
+// YOLO-like output: N candidate boxes with the scores of 80 classes
+typedef TestBaseWithParam<tuple<int, bool> > NMS_MultiClass;
+
+static void generateDetections(int N, int C, Mat& boxes, Mat& scores)
+{
+    RNG rng(0);
+    boxes.create(N, 4, CV_32F);
+    scores.create(N, C, CV_32F);
+    for (int i = 0; i < N; i++)
+    {
+        float* b = boxes.ptr<float>(i);
+        b[0] = rng.uniform(0.f, 600.f);
+        b[1] = rng.uniform(0.f, 600.f);
+        b[2] = rng.uniform(8.f, 160.f);
+        b[3] = rng.uniform(8.f, 160.f);
+    }
+    // most of the candidates have low scores
+    rng.fill(scores, RNG::UNIFORM, 0.f, 1.f);
+    pow(scores, 8, scores);
+}
+
+PERF_TEST_P_(NMS_MultiClass, NMSBoxes)
+{
+    int N = get<0>(GetParam());
+    bool useMat = get<1>(GetParam());
+    const int C = 80;
+    const float score_thresh = 0.25f, nms_thresh = 0.45f;
+    Mat boxes, scores;
+    generateDetections(N, C, boxes, scores);
+
+    std::vector<int> indices, class_ids;
+    if (useMat)
+    {
+        TEST_CYCLE()
+        {
+            NMSBoxesMultiClass(boxes, scores, score_thresh, nms_thresh, indices, class_ids);
+        }
+    }
+    else
+    {
+        TEST_CYCLE()
+        {
+            // the typical post-processing: the best class of each box and batched NMS
+            std::vector<Rect2d> rects;
+            std::vector<float> confidences;
+            for (int i = 0; i < N; i++)
+            {
+                Point classId;
+                double maxScore;
+                minMaxLoc(scores.row(i), 0, &maxScore, 0, &classId);
+                if (maxScore > score_thresh)
+                {
+                    const float* b = boxes.ptr<float>(i);
+                    rects.push_back(Rect2d(b[0], b[1], b[2], b[3]));
+                    confidences.push_back((float)maxScore);
+                    class_ids.push_back(classId.x);
+                }
+            }
+            NMSBoxesBatched(rects, confidences, class_ids, score_thresh, nms_thresh, indices);
+            class_ids.clear();
+        }
+    }
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, NMS_MultiClass, Combine(
+    Values(8400, 25200, 100000),
+    testing::Bool()  // Mat-based NMSBoxesMultiClass or vectors and NMSBoxesBatched
+));
+
+} // namespace
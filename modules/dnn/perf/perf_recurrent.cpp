@@ -87,4 +87,62 @@ PERF_TEST_P_(Layer_LSTM, lstm) {
 
 INSTANTIATE_TEST_CASE_P(/**/, Layer_LSTM, testing::ValuesIn(testLstmConfigs));
 
+// bidirectional recurrent layers of the text recognition models (CRNN-like), the input is seq_len x batch x input_size
+static const LstmParams testBidirectionalConfigs[] = {
+    {1, 512, 256, 26},
+    {4, 512, 256, 26},
+    {1, 256, 256, 64}
+};
+
+class Layer_Recurrent_Bidirectional : public TestBaseWithParam<tuple<LstmParams, std::string> > {};
+
+PERF_TEST_P_(Layer_Recurrent_Bidirectional, forward) {
+    const LstmParams& params = get<0>(GetParam());
+    const std::string& type = get<1>(GetParam());
+    const int numGates = type == "LSTM" ? 4 : 3;
+    const int numBiases = type == "LSTM" ? 1 : 2;  // GRU has separate biases for the input and recurrent projections
+
+    LayerParams lp;
+    lp.type = type;
+    lp.name = "testRecurrent";
+    lp.set("bidirectional", true);
+
+    Mat weightH(2 * numGates * params.hiddenSize, params.hiddenSize, CV_32FC1);
+    Mat weightX(2 * numGates * params.hiddenSize, params.inputSize, CV_32FC1);
+    Mat bias(1, 2 * numBiases * numGates * params.hiddenSize, CV_32FC1);
+    Mat hInternal(2 * params.nrSamples, params.hiddenSize, CV_32FC1, cv::Scalar(0));
+    Mat cInternal(2 * params.nrSamples, params.hiddenSize, CV_32FC1, cv::Scalar(0));
+    randu(weightH, -0.1f, 0.1f);
+    randu(weightX, -0.1f, 0.1f);
+    randu(bias, -0.1f, 0.1f);
+    lp.blobs.push_back(weightH);
+    lp.blobs.push_back(weightX);
+    lp.blobs.push_back(bias);
+    lp.blobs.push_back(hInternal);
+    if (type == "LSTM")
+        lp.blobs.push_back(cInternal);
+
+    int inputDims[] = {params.nrSteps, params.nrSamples, params.inputSize};
+    Mat input(3, inputDims, CV_32FC1);
+    randu(input, -1.f, 1.f);
+
+    Net net;
+    net.addLayerToPrev(lp.name, lp.type, lp);
+    net.setInput(input);
+
+    // Warm up
+    Mat output = net.forward();
+
+    TEST_CYCLE()
+    {
+        output = net.forward();
+    }
+    SANITY_CHECK_NOTHING();
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Layer_Recurrent_Bidirectional, Combine(
+    testing::ValuesIn(testBidirectionalConfigs),
+    Values(std::string("LSTM"), std::string("GRU"))
+));
+
 } // namespace
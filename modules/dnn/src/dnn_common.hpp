@@ -107,6 +107,40 @@ private:
     std::unordered_map<std::string, std::unordered_set<std::string>> layers;
 };
 
+// Wraps the memory owned by another object (e.g. a mapped model file) into a Mat without copying.
+// The Mat and all its copies keep the owner alive (see dnn_read.cpp).
+Mat wrapExternalMemory(const std::shared_ptr<void>& owner, const void* data, const std::vector<int>& sizes, int type);
+
+// Layers which keep their weights packed for the current CPU and can export them
+// into the compiled network files (see Net::save()).
+class PackedWeightsLayer
+{
+public:
+    virtual ~PackedWeightsLayer() {}
+
+    // Returns false if the weights are not packed yet. The buffers may refer to the layer memory.
+    virtual bool getPackedWeights(std::vector<int>& params, std::vector<Mat>& buffers) const = 0;
+
+    // The layer validates the packed weights against its own ones before the use.
+    virtual void setPackedWeights(const std::vector<int>& params, const std::vector<Mat>& buffers) = 0;
+};
+
+// Layers which can keep their constant weights compressed (see Net::setWeightsCompression()).
+class WeightsCompressionLayer
+{
+public:
+    virtual ~WeightsCompressionLayer() {}
+
+    // CV_32F disables the compression. The weights are packed again on the next finalize().
+    virtual void setWeightsCompression(int type) = 0;
+
+    // DNN_TARGET_CPU_FP16 keeps the weights in FP16 if no other compression is set.
+    static int getWeightsStorageType(int compression, int target)
+    {
+        return compression == CV_32F && target == DNN_TARGET_CPU_FP16 ? CV_16F : compression;
+    }
+};
+
 struct NetImplBase
 {
     const int networkId;  // network global identifier
@@ -10,6 +10,51 @@ namespace dnn {
 CV__DNN_INLINE_NS_BEGIN
 
 
+namespace {
+
+// Allocator of the Mats over the external memory: the UMatData holds a reference to the owner of the memory
+class ExternalMemoryAllocator CV_FINAL : public MatAllocator
+{
+public:
+    UMatData* allocate(int, const int*, int, void*, size_t*, AccessFlag, UMatUsageFlags) const CV_OVERRIDE
+    {
+        CV_Error(Error::StsNotImplemented, "DNN: the external memory can't be reallocated");
+    }
+
+    bool allocate(UMatData*, AccessFlag, UMatUsageFlags) const CV_OVERRIDE
+    {
+        return false;
+    }
+
+    void deallocate(UMatData* u) const CV_OVERRIDE
+    {
+        if (!u)
+            return;
+        CV_Assert(u->urefcount == 0);
+        CV_Assert(u->refcount == 0);
+        delete (std::shared_ptr<void>*)u->userdata;
+        delete u;
+    }
+};
+
+}  // namespace
+
+Mat detail::wrapExternalMemory(const std::shared_ptr<void>& owner, const void* data, const std::vector<int>& sizes, int type)
+{
+    static ExternalMemoryAllocator* allocator = new ExternalMemoryAllocator();  // never destroyed: Mats may outlive static objects
+
+    CV_Assert(owner && data);
+    Mat m(sizes, type, const_cast<void*>(data));
+    UMatData* u = new UMatData(allocator);
+    u->data = u->origdata = m.data;
+    u->size = m.total() * m.elemSize();
+    u->userdata = new std::shared_ptr<void>(owner);
+    u->refcount = 1;
+    m.u = u;
+    return m;
+}
+
+
 Net readNet(const String& _model, const String& _config, const String& _framework)
 {
     String framework = toLowerCase(_framework);
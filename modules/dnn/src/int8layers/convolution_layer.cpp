@@ -160,8 +160,10 @@ public:
 class ConvolutionLayerInt8Impl CV_FINAL : public BaseConvolutionLayerInt8Impl
 {
 public:
-    enum { VEC_ALIGN = 32, DFT_TYPE = CV_8S };
+    // PACKED_MR must match FASTCONV_PACKED_MR of the dispatched fastConvPacked()
+    enum { VEC_ALIGN = 32, DFT_TYPE = CV_8S, PACKED_MR = 8 };
     Mat weightsMat;
+    Mat packedWeights;
     std::vector<int> biasvec;
     std::vector<float> outputMultiplier;
     Mat activationLUT;
@@ -261,6 +263,7 @@ public:
             wm = wm_aligned;
         }
         weightsMat = wm;
+        packWeights(inputs[0].size[1] / blobs[0].size[1]);
 
         Mat biasMat = blobs[1];
         biasvec.resize(numOutput+2);
@@ -274,6 +277,35 @@ public:
         }
     }
 
+    // Repacks the weights of each group into strips of PACKED_MR output channels. Within a strip
+    // the weights are stored as quadruples along the kernel dimension, interleaved across the channels:
+    // (w[0][0..3], w[1][0..3], ..., w[MR-1][0..3], w[0][4..7], ...). The reduction dimension is padded
+    // with zeros to a multiple of 4, the missing channels of the last strip are filled with zeros too.
+    void packWeights(int ngroups)
+    {
+        const int MR = PACKED_MR;
+        int outCn = numOutput / ngroups;
+        int K = blobs[0].size[1] * (int)std::accumulate(kernel_size.begin(), kernel_size.end(),
+                                                        1, std::multiplies<size_t>());
+        int Kq = (int)alignSize(K, 4);
+        int nstrips = (outCn + MR - 1) / MR;
+        size_t wstep = (size_t)Kq * MR;
+
+        packedWeights.create(1, (int)(wstep * nstrips * ngroups), CV_8S);
+        packedWeights.setTo(Scalar::all(0));
+        int8_t* dst = packedWeights.ptr<int8_t>();
+        for (int g = 0; g < ngroups; g++)
+        {
+            for (int i = 0; i < outCn; i++)
+            {
+                const int8_t* wptr = weightsMat.ptr<int8_t>(g * outCn + i);
+                int8_t* strip = dst + (g * nstrips + i / MR) * wstep + (i % MR) * 4;
+                for (int k = 0; k < K; k++)
+                    strip[(k / 4) * MR * 4 + (k % 4)] = wptr[k];
+            }
+        }
+    }
+
     bool setActivation(const Ptr<ActivationLayer>& layer) CV_OVERRIDE
     {
         // TODO! add activation in convolution.
@@ -690,6 +722,7 @@ public:
 
         const Mat* input_;
         const Mat* weights_;
+        const Mat* packedWeights_;
         Mat* output_;
         int outShape[4]; // used only for conv2d
         std::vector<size_t> kernel_size, pads_begin, pads_end, strides, dilations;
@@ -708,12 +741,13 @@ public:
         const std::vector<float>* multiplier;
 
         ParallelConv()
-            : input_(0), weights_(0), output_(0), ngroups_(0), nstripes_(0),
+            : input_(0), weights_(0), packedWeights_(0), output_(0), ngroups_(0), nstripes_(0),
               biasvec_(0), activLUT_(0), activ_(0), is1x1_(false), useAVX2(false), useAVX512(false), useLASX(false), useRVV(false)
             , blk_size_cn(0), inpZp(0), outZp(0), multiplier(0)
         {}
 
-        static void run( const Mat& input, Mat& output, const Mat& weights, const std::vector<float>& multipliers,
+        static void run( const Mat& input, Mat& output, const Mat& weights, const Mat& packedWeights,
+                         const std::vector<float>& multipliers,
                          const std::vector<int>& biasvec, const Mat& activLUT,
                          const std::vector<size_t>& kernel_size, const std::vector<size_t>& strides,
                          const std::vector<size_t>& pads_begin, const std::vector<size_t>& pads_end,
@@ -737,10 +771,14 @@ public:
                        output.isContinuous(),
                        biasvec.size() == (size_t)output.size[1]+2);
             CV_Check(weights.step1(), weights.step1() % VEC_ALIGN == 0, "");
+            CV_Assert(packedWeights.empty() ||
+                      packedWeights.total() == alignSize(weights.cols, 4)*PACKED_MR*
+                                               ((weights.rows/ngroups + PACKED_MR - 1)/PACKED_MR)*ngroups);
             ParallelConv p;
 
             p.input_ = &input;
             p.weights_ = &weights;
+            p.packedWeights_ = &packedWeights;
             p.output_ = &output;
             int max_ind = isConv1D? 3: 4;
             for( int i = 0; i < max_ind; i++ ) p.outShape[i] = output.size[i];
@@ -821,6 +859,149 @@ public:
             parallel_for_(Range(0, nstripes), p, nstripes);
         }
 
+        // Generic version of opt_AVX2::fastConvPacked(), see packWeights() for the layout of the weights.
+        // Computes outCn x blockSize block of the output, blockSize pixels are stored in rowbuf after im2row.
+        static void fastConvPacked( const int8_t* weights, size_t wstep, const int* bias,
+                                    const int8_t* rowbuf, int* output, size_t outPlaneSize, int outCn,
+                                    int blockSize, int vecsize, int vecsize_aligned, int outZp,
+                                    const float* multiplier, const int* activLUT,
+                                    bool initOutput, bool finalOutput )
+        {
+            const int MR = PACKED_MR, NR = 4;
+            int nquads = (vecsize + 3)/4;
+            int sbuf[NR][MR];
+
+            for( int i = 0; i < outCn; i += MR )
+            {
+                const int8_t* wptr0 = weights + (i/MR)*wstep;
+                int* outptr0 = output + i*outPlaneSize;
+                int mr = std::min(outCn - i, (int)MR);
+
+                for( int j = 0; j < blockSize; j += NR )
+                {
+                    const int8_t* rptr[NR];
+                    for( int t = 0; t < NR; t++ )
+                        rptr[t] = rowbuf + std::min(j + t, blockSize - 1)*vecsize_aligned;
+                    const int8_t* wptr = wptr0;
+                #if CV_SIMD128
+                    v_int32x4 vs0[NR], vs1[NR];
+                    for( int t = 0; t < NR; t++ )
+                        vs0[t] = vs1[t] = v_setzero_s32();
+                    for( int q = 0; q < nquads; q++, wptr += MR*4 )
+                    {
+                        v_int8x16 w0 = v_load(wptr), w1 = v_load(wptr + 16);
+                        for( int t = 0; t < NR; t++ )
+                        {
+                            int r;
+                            memcpy(&r, rptr[t] + q*4, sizeof(r));
+                            v_int8x16 x = v_reinterpret_as_s8(v_setall_s32(r));
+                            vs0[t] = v_dotprod_expand(w0, x, vs0[t]);
+                            vs1[t] = v_dotprod_expand(w1, x, vs1[t]);
+                        }
+                    }
+                    for( int t = 0; t < NR; t++ )
+                    {
+                        v_store(sbuf[t], vs0[t]);
+                        v_store(sbuf[t] + 4, vs1[t]);
+                    }
+                #else
+                    memset(sbuf, 0, sizeof(sbuf));
+                    for( int q = 0; q < nquads; q++, wptr += MR*4 )
+                    {
+                        for( int t = 0; t < NR; t++ )
+                        {
+                            const int8_t* r = rptr[t] + q*4;
+                            for( int m = 0; m < MR; m++ )
+                                sbuf[t][m] += wptr[m*4]*r[0] + wptr[m*4+1]*r[1] + wptr[m*4+2]*r[2] + wptr[m*4+3]*r[3];
+                        }
+                    }
+                #endif
+                    for( int t = 0; t < NR && j + t < blockSize; t++ )
+                    {
+                        for( int m = 0; m < mr; m++ )
+                        {
+                            int* outptr = outptr0 + m*outPlaneSize + j + t;
+                            int s = sbuf[t][m] + (initOutput ? bias[i + m] : *outptr);
+                            if( finalOutput )
+                            {
+                                s = std::min(std::max(outZp + (int)std::round(s*multiplier[i + m]), -128), 127);
+                                if( activLUT )
+                                    s = activLUT[s + 128];
+                            }
+                            *outptr = s;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Depth-wise convolution of a single 2D plane with arbitrary kernel size, stride and dilation.
+        // The padded input pixels are equal to inpZp; requantization and activation are fused.
+        static void depthwiseConvGeneric( const int8_t* wptr, int kernel_h, int kernel_w,
+                                          int stride_h, int stride_w, int dilation_h, int dilation_w,
+                                          int pad_t, int pad_l, int bias, float mult,
+                                          const int8_t* inptr, int height, int width,
+                                          int* outptr, int outH, int outW,
+                                          int inpZp, int outZp, const int* activLUT )
+        {
+            for( int out_i = 0; out_i < outH; out_i++ )
+            {
+                int* orow = outptr + out_i*outW;
+                int in_i = out_i*stride_h - pad_t;
+                int rowbias = bias;
+                for( int ki = 0; ki < kernel_h; ki++ )
+                {
+                    int y = in_i + ki*dilation_h;
+                    if( y < 0 || y >= height )
+                        for( int kj = 0; kj < kernel_w; kj++ )
+                            rowbias += inpZp*wptr[ki*kernel_w + kj];
+                }
+                for( int j = 0; j < outW; j++ )
+                    orow[j] = rowbias;
+
+                for( int ki = 0; ki < kernel_h; ki++ )
+                {
+                    int y = in_i + ki*dilation_h;
+                    if( y < 0 || y >= height )
+                        continue;
+                    for( int kj = 0; kj < kernel_w; kj++ )
+                    {
+                        int w = wptr[ki*kernel_w + kj], padw = w*inpZp;
+                        int dx = kj*dilation_w - pad_l;
+                        // the output pixels [j0, j1) read the input row inside of its borders
+                        int j0 = std::min(std::max((-dx + stride_w - 1)/stride_w, 0), outW);
+                        int j1 = std::max(std::min((width - dx + stride_w - 1)/stride_w, outW), j0);
+                        const int8_t* iptr = inptr + y*width + dx;
+                        int j = 0;
+                        for( ; j < j0; j++ )
+                            orow[j] += padw;
+                    #if CV_SIMD128
+                        if( stride_w == 1 )
+                        {
+                            v_int16x8 vw = v_setall_s16((short)w);
+                            for( ; j <= j1 - 8; j += 8 )
+                            {
+                                v_int32x4 p0, p1;
+                                v_mul_expand(v_load_expand(iptr + j), vw, p0, p1);
+                                v_store(orow + j, v_add(v_load(orow + j), p0));
+                                v_store(orow + j + 4, v_add(v_load(orow + j + 4), p1));
+                            }
+                        }
+                    #endif
+                        for( ; j < j1; j++ )
+                            orow[j] += w*iptr[j*stride_w];
+                        for( ; j < outW; j++ )
+                            orow[j] += padw;
+                    }
+                }
+                for( int j = 0; j < outW; j++ )
+                {
+                    int out = std::min(std::max(outZp + (int)std::round(orow[j]*mult), -128), 127);
+                    orow[j] = activLUT ? activLUT[out + 128] : out;
+                }
+            }
+        }
+
         virtual void operator ()(const Range &r0) const CV_OVERRIDE
         {
             const int valign = ConvolutionLayerInt8Impl::VEC_ALIGN;
@@ -873,8 +1054,24 @@ public:
                 // computing at most 1 pixel from each side can involve padding
                 max(stride_w, dilation_w) >= pad_l && max(stride_h, dilation_h) >= pad_t &&
                 pad_l <= 1 && pad_t <= 1;
-
-            if( !depthWiseConvolution && nstripes >= batchSize*2 )
+            // the other 2D depth-wise convolutions are processed plane by plane as well
+            bool depthWiseGeneric = !depthWiseConvolution && isConv2D && ngroups > 1 && inpCn == 1 && outCn == 1;
+            bool depthWise = depthWiseConvolution || depthWiseGeneric;
+
+            // the packed weights are not used by the platform-specific LASX/RVV/RVP kernels
+            bool usePacked = !packedWeights_->empty() && !useLASX && !useRVV;
+        #if CV_RVP052
+            usePacked = usePacked && !isConv2D;
+        #endif
+            const int MR = PACKED_MR;
+            size_t pwstep = alignSize(karea*inpCn, 4)*MR;
+            int pnstrips = (outCn + MR - 1)/MR;
+            const int8_t* pwptr_ = usePacked ? packedWeights_->ptr<int8_t>() : 0;
+            // with the packed weights and in the generic depth-wise convolution
+            // the activation is applied together with requantization
+            bool fusedActiv = depthWiseGeneric || (usePacked && !depthWiseConvolution);
+
+            if( !depthWise && nstripes >= batchSize*2 )
             {
                 stripesPerSample = nstripes/batchSize;
                 stripeSize = (int)alignSize((outPlaneSize + stripesPerSample - 1)/stripesPerSample, 8);
@@ -899,8 +1096,8 @@ public:
             int* data_out0_ = output_->ptr<int>();
             AutoBuffer<int8_t> rowbuf0_;
             int8_t* rowbuf0 = 0;
-            bool use_rowbuf = !depthWiseConvolution;
-            int blk_size = depthWiseConvolution ? outPlaneSize : min((int)BLK_SIZE, stripeSize);
+            bool use_rowbuf = !depthWise;
+            int blk_size = depthWise ? outPlaneSize : min((int)BLK_SIZE, stripeSize);
 
             // im2row buffer is not used for depth-wise convolution
             if(use_rowbuf)
@@ -934,6 +1131,7 @@ public:
                 const int8_t* wptr_orig = wptr_orig_ + wstep*startOutCn;
                 const int* biasptr = biasptr_ + startOutCn;
                 const float* multptr = multptr_ + startOutCn;
+                const int8_t* pwptr_orig = pwptr_ + (subsampleIdx % ngroups)*pnstrips*pwstep;
 
                 for( int cn0 = 0; cn0 < inpCn; cn0 += blk_size_cn )
                 {
@@ -951,6 +1149,14 @@ public:
                         int out_i = (ofs0 - out_d * outH * outW) / outW;
                         int out_j = ofs0 % outW;
 
+                        if (depthWiseGeneric)
+                        {
+                            CV_Assert(out_i == 0 && out_j == 0);
+                            depthwiseConvGeneric(wptr, kernel_h, kernel_w, stride_h, stride_w, dilation_h, dilation_w,
+                                                 pad_t, pad_l, biasptr[0], multptr[0], data_inp0, height, width,
+                                                 data_out0 + ofs0, outH, outW, inpZp, outZp, lutptr_);
+                            continue;
+                        }
                         if (depthWiseConvolution)
                         {
                             CV_Assert(out_i == 0 && out_j == 0);
@@ -1347,6 +1553,22 @@ public:
                         }
                         // now compute dot product of the weights
                         // and im2row-transformed part of the tensor
+                        if( usePacked )
+                        {
+                            // cn0*karea is a multiple of 4, since blk_size_cn is either inpCn or a multiple of 32
+                            const int8_t* pwptr = pwptr_orig + cn0*karea*MR;
+                        #if CV_TRY_AVX2
+                            if(useAVX2)
+                                opt_AVX2::fastConvPacked(pwptr, pwstep, biasptr, rowbuf0, data_out0 + ofs0,
+                                                         outShape, bsz, vsz, vsz_a, outZp, multptr, lutptr_,
+                                                         cn0 == 0, cn1 == inpCn);
+                            else
+                        #endif
+                                fastConvPacked(pwptr, pwstep, biasptr, rowbuf0, data_out0 + ofs0,
+                                               outPlaneSize, outCn, bsz, vsz, vsz_a, outZp, multptr, lutptr_,
+                                               cn0 == 0, cn1 == inpCn);
+                        }
+                        else
                     #if CV_TRY_AVX512_SKX
                         if(useAVX512)
                             opt_AVX2::fastConv(wptr, wstep, biasptr, rowbuf0, data_out0 + ofs0,
@@ -1487,7 +1709,7 @@ public:
                         }
                     }
                 }
-                if( activ_ )
+                if( activ_ && !fusedActiv )
                     activ_->forwardSlice(data_out0 + stripeStart, lutptr_,
                                          data_out0 + stripeStart, (int)(stripeEnd - stripeStart),
                                          outPlaneSize, startOutCn, startOutCn + outCn);
@@ -1534,7 +1756,7 @@ public:
         int nstripes = std::max(getNumThreads(), 1);
         Mat outputInt32 = Mat(shape(outputs[0]), CV_32S);
 
-        ParallelConv::run(inputs[0], outputInt32, weightsMat, outputMultiplier, biasvec, activationLUT, kernel_size, strides,
+        ParallelConv::run(inputs[0], outputInt32, weightsMat, packedWeights, outputMultiplier, biasvec, activationLUT, kernel_size, strides,
                           pads_begin, pads_end, dilations, activ.get(), ngroups, nstripes, input_zp, output_zp);
 
         outputInt32.convertTo(outputs[0], CV_8S);
@@ -12,6 +12,11 @@ void fastConv( const int8_t* weights, size_t wstep, const int* bias,
                const int8_t* rowbuf, int* output, const int* outShape,
                int blockSize, int vecsize, int vecsize_aligned, int outZp,
                const float* multiplier, bool initOutput, bool finalOutput );
+void fastConvPacked( const int8_t* weights, size_t wstep, const int* bias,
+                     const int8_t* rowbuf, int* output, const int* outShape,
+                     int blockSize, int vecsize, int vecsize_aligned, int outZp,
+                     const float* multiplier, const int* activLUT,
+                     bool initOutput, bool finalOutput );
 void fastDepthwiseConv( const int8_t* wptr,
                         int kernel_h, int kernel_w,
                         int stride_h, int stride_w,
@@ -328,6 +333,96 @@ void fastConv( const int8_t* weights, size_t wstep, const int* bias,
     _mm256_zeroupper();
 }
 
+// The weights are packed by ConvolutionLayerInt8Impl into strips of FASTCONV_PACKED_MR output channels
+// (wstep bytes per strip); inside a strip each quadruple of consecutive weights of the first channel
+// is followed by the corresponding quadruples of the other channels. So a single 32-byte load gives
+// the weights for all 8 channels, and the 4 input values of a pixel are broadcasted to all the lanes.
+enum { FASTCONV_PACKED_MR = 8, FASTCONV_PACKED_NR = 8 };
+
+void fastConvPacked( const int8_t* weights, size_t wstep, const int* bias,
+                     const int8_t* rowbuf, int* output, const int* outShape,
+                     int blockSize, int vecsize, int vecsize_aligned, int outZp,
+                     const float* multiplier, const int* activLUT,
+                     bool initOutput, bool finalOutput )
+{
+    const int MR = FASTCONV_PACKED_MR, NR = FASTCONV_PACKED_NR;
+    int outCn = outShape[1];
+    size_t outPlaneSize = outShape[2]*outShape[3];
+    int nquads = (vecsize + 3)/4;
+    const __m256i vzp = _mm256_set1_epi32(outZp);
+    const __m256i vmin = _mm256_set1_epi32(-128), vmax = _mm256_set1_epi32(127);
+    int CV_DECL_ALIGNED(32) biasbuf[MR], ofsbuf[MR], outbuf[MR];
+    float CV_DECL_ALIGNED(32) multbuf[MR];
+
+    for( int i = 0; i < outCn; i += MR )
+    {
+        const int8_t* wptr0 = weights + (i/MR)*wstep;
+        int* outptr0 = output + i*outPlaneSize;
+        int mr = std::min(outCn - i, MR);
+        // the channels of the incomplete strip are padded with the last valid channel;
+        // the corresponding results are computed, but not stored
+        for( int m = 0; m < MR; m++ )
+        {
+            int m1 = std::min(m, mr - 1);
+            biasbuf[m] = bias[i + m1];
+            multbuf[m] = multiplier[i + m1];
+            ofsbuf[m] = (int)(m1*outPlaneSize);
+        }
+        const __m256i vbias = _mm256_load_si256((const __m256i*)biasbuf);
+        const __m256i vofs = _mm256_load_si256((const __m256i*)ofsbuf);
+        const __m256 vmult = _mm256_load_ps(multbuf);
+
+        for( int j = 0; j < blockSize; j += NR )
+        {
+            const int8_t* rptr[NR];
+            __m256i vs[NR];
+            for( int t = 0; t < NR; t++ )
+            {
+                rptr[t] = rowbuf + std::min(j + t, blockSize - 1)*vecsize_aligned;
+                vs[t] = _mm256_setzero_si256();
+            }
+
+            const int8_t* wptr = wptr0;
+            for( int q = 0; q < nquads; q++, wptr += MR*4 )
+            {
+                __m256i w = _mm256_loadu_si256((const __m256i*)wptr);
+                __m256i w_even = _mm256_srai_epi16(_mm256_slli_epi16(w, 8), 8);
+                __m256i w_odd = _mm256_srai_epi16(w, 8);
+                for( int t = 0; t < NR; t++ )
+                {
+                    int r;
+                    memcpy(&r, rptr[t] + q*4, sizeof(r));
+                    __m256i x = _mm256_set1_epi32(r);
+                    __m256i x_even = _mm256_srai_epi16(_mm256_slli_epi16(x, 8), 8);
+                    __m256i x_odd = _mm256_srai_epi16(x, 8);
+                    vs[t] = _mm256_add_epi32(vs[t], _mm256_add_epi32(_mm256_madd_epi16(w_even, x_even),
+                                                                     _mm256_madd_epi16(w_odd, x_odd)));
+                }
+            }
+
+            for( int t = 0; t < NR && j + t < blockSize; t++ )
+            {
+                __m256i s = vs[t];
+                if( initOutput )
+                    s = _mm256_add_epi32(s, vbias);
+                else
+                    s = _mm256_add_epi32(s, _mm256_i32gather_epi32(outptr0 + j + t, vofs, 4));
+                if( finalOutput )
+                {
+                    s = _mm256_add_epi32(vzp, _mm256_cvtps_epi32(_mm256_mul_ps(_mm256_cvtepi32_ps(s), vmult)));
+                    s = _mm256_min_epi32(_mm256_max_epi32(s, vmin), vmax);
+                    if( activLUT )
+                        s = _mm256_i32gather_epi32(activLUT + 128, s, 4);
+                }
+                _mm256_store_si256((__m256i*)outbuf, s);
+                for( int m = 0; m < mr; m++ )
+                    outptr0[m*outPlaneSize + j + t] = outbuf[m];
+            }
+        }
+    }
+    _mm256_zeroupper();
+}
+
 static inline void _mm256_expand_mul_add(const __m256i& a, const __m256i& b,
                                          __m256i& out0, __m256i& out1, __m256i& out2, __m256i& out3)
 {
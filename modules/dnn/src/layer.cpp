@@ -100,6 +100,7 @@ Ptr<BackendNode> Layer::tryAttach(const Ptr<BackendNode>& node)
 
 bool Layer::setActivation(const Ptr<ActivationLayer>&) { return false; }
 bool Layer::tryFuse(Ptr<Layer>&) { return false; }
+String Layer::getKernelName() const { return String(); }
 void Layer::getScaleShift(Mat& scale, Mat& shift) const
 {
     scale = Mat();
@@ -7,6 +7,7 @@
 #include "cpu_kernels/softmax.hpp"
 
 #include <opencv2/dnn/shape_utils.hpp>
+#include <opencv2/core/hal/hal.hpp>
 
 namespace cv { namespace dnn {
 
@@ -24,6 +25,81 @@ static void packWeight(size_t num_heads, size_t head_size, size_t input_hidden_s
     }
 }
 
+enum { ATTENTION_BLOCK_Q = 32, ATTENTION_BLOCK_KV = 256 };
+
+static size_t attentionBufferSize(size_t v_head_size) {
+    // scores, partial output, running maximum and sum of a block of queries
+    return ATTENTION_BLOCK_Q * (ATTENTION_BLOCK_KV + v_head_size + 2);
+}
+
+// Computes softmax(scale * Q * K^T) * V for a block of q_len queries of one head without
+// materializing the whole score matrix: the keys and values are processed in blocks and
+// the softmax is accumulated online with the running maximum and sum of every query,
+// the partial output is rescaled whenever the maximum grows.
+// If causal_offset >= 0, the query i attends only to the keys 0..i+causal_offset.
+static void attentionBlock(int q_len, int kv_len, int qk_head_size, int v_head_size, float scale,
+                           const float *Q, const float *K, const float *V, int causal_offset,
+                           float *out, size_t out_step, float *buf, FastGemmOpt &opt) {
+    CV_Assert(q_len <= ATTENTION_BLOCK_Q);
+    float *scores = buf, *acc = scores + ATTENTION_BLOCK_Q * ATTENTION_BLOCK_KV;
+    float *row_max = acc + ATTENTION_BLOCK_Q * v_head_size, *row_sum = row_max + ATTENTION_BLOCK_Q;
+    for (int i = 0; i < q_len; i++) {
+        row_max[i] = -FLT_MAX;
+        row_sum[i] = 0.f;
+    }
+    std::memset(acc, 0, q_len * v_head_size * sizeof(float));
+
+    int kv_end = causal_offset >= 0 ? std::min(kv_len, q_len + causal_offset) : kv_len;
+    for (int j0 = 0; j0 < kv_end; j0 += ATTENTION_BLOCK_KV) {
+        int kv_block = std::min(kv_end - j0, (int)ATTENTION_BLOCK_KV);
+        fastGemm(false, true, q_len, qk_head_size, kv_block, qk_head_size,
+                 scale, Q, qk_head_size, 1,
+                 K + j0 * qk_head_size, qk_head_size, 1, 0.f,
+                 scores, kv_block, opt);
+
+        for (int i = 0; i < q_len; i++) {
+            float *s = scores + i * kv_block;
+            // number of the keys of this block visible to the query
+            int valid = causal_offset >= 0 ? std::min(kv_block, i + causal_offset + 1 - j0) : kv_block;
+            if (valid <= 0) {
+                std::memset(s, 0, kv_block * sizeof(float));
+                continue;
+            }
+            float m = row_max[i];
+            for (int j = 0; j < valid; j++)
+                m = std::max(m, s[j]);
+            float correction = std::exp(row_max[i] - m);
+            for (int j = 0; j < valid; j++)
+                s[j] -= m;
+            hal::exp32f(s, s, valid);
+            float sum = 0.f;
+            for (int j = 0; j < valid; j++)
+                sum += s[j];
+            for (int j = valid; j < kv_block; j++)
+                s[j] = 0.f;
+            row_max[i] = m;
+            row_sum[i] = row_sum[i] * correction + sum;
+            if (correction != 1.f) {
+                float *a = acc + i * v_head_size;
+                for (int k = 0; k < v_head_size; k++)
+                    a[k] *= correction;
+            }
+        }
+
+        fastGemm(false, false, q_len, kv_block, kv_block, v_head_size,
+                 1.f, scores, kv_block, 1,
+                 V + j0 * v_head_size, v_head_size, 1, 1.f,
+                 acc, v_head_size, opt);
+    }
+
+    for (int i = 0; i < q_len; i++) {
+        const float *a = acc + i * v_head_size;
+        float *o = out + i * out_step, inv_sum = 1.f / row_sum[i];
+        for (int k = 0; k < v_head_size; k++)
+            o[k] = a[k] * inv_sum;
+    }
+}
+
 // Operator spec: https://github.com/microsoft/onnxruntime/blob/v1.16.1/docs/ContribOperators.md#com.microsoft.Attention
 class AttentionLayerImpl CV_FINAL : public AttentionLayer {
  public:
@@ -52,9 +128,28 @@ class AttentionLayerImpl CV_FINAL : public AttentionLayer {
 
         output_ndims = params.get<int>("output_ndims", 3);
 
+        unidirectional = params.get<int>("unidirectional", 0) != 0;
+        use_kv_cache = params.get<bool>("use_kv_cache", false);
+        kv_cache_len = kv_cache_capacity = kv_cache_bn = 0;
+
         is_prepacked = false;
     }
 
+    virtual void setUseKVCache(bool use) CV_OVERRIDE {
+        use_kv_cache = use;
+        resetKVCache();
+    }
+
+    virtual void resetKVCache() CV_OVERRIDE {
+        kv_cache_len = 0;
+        k_cache.clear();
+        v_cache.clear();
+    }
+
+    virtual int getKVCacheLength() const CV_OVERRIDE {
+        return static_cast<int>(kv_cache_len);
+    }
+
     virtual bool supportBackend(int backendId) CV_OVERRIDE {
         return backendId == DNN_BACKEND_OPENCV;
     }
@@ -86,16 +181,12 @@ class AttentionLayerImpl CV_FINAL : public AttentionLayer {
         }
 
         const int batch_size_ = input_shape[0], seq_len_ = input_shape[1],
-                  hidden_size_ = weight_shape.back(),
-                  num_heads_ = static_cast<int>(num_heads),
-                  v_head_size_ = static_cast<int>((hidden_size_ - qkv_hidden_sizes[0] - qkv_hidden_sizes[1]) / num_heads);
+                  hidden_size_ = weight_shape.back();
 
-        MatShape gemm_buffer_shape{batch_size_, seq_len_, hidden_size_},
-                 attention_prob_shape{batch_size_ * num_heads_, seq_len_, seq_len_},
-                 output_buffer_shape{batch_size_ * num_heads_, seq_len_, v_head_size_};
+        // the attention is computed block by block (see attentionBlock()),
+        // so the score matrix is not allocated
+        MatShape gemm_buffer_shape{batch_size_, seq_len_, hidden_size_};
         internals.assign(1, gemm_buffer_shape);
-        internals.push_back(attention_prob_shape);
-        internals.push_back(output_buffer_shape);
 
         return false;
     }
@@ -202,70 +293,77 @@ class AttentionLayerImpl CV_FINAL : public AttentionLayer {
             parallel_for_(Range(0, loops), fn, nstripes);
         }
 
-        // Compute Softmax(scale * MatMul(Q, K))
-        auto &attention_prob = internals[1];
-        {
-            auto *output = attention_prob.ptr<float>();
-
-            auto loops = batch_size * num_heads;
-            auto seq_len_square = seq_len * seq_len;
-            auto qk_head_size = qkv_head_sizes[0];
-            auto qk_inner_size = seq_len * qk_head_size;
-
-            // Compute scale * matmul(Q, K)
-            opt.multi_thread = false;
-            parallel_for_(Range(0, loops), [&] (const Range r) {
-                for (int i = r.start; i < r.end; i++) {
-                    const int output_offset = i * seq_len_square;
-
-                    const auto *q = Q + qk_inner_size * i, *k = K + qk_inner_size * i;
-                    fastGemm(false, true, seq_len, qk_head_size, seq_len, qk_head_size,
-                             scale, q, qk_head_size, 1,
-                             k, qk_head_size, 1, 0.f,
-                             output + output_offset, seq_len, opt);
-                }
-            }, loops * seq_len * qk_head_size * seq_len * (1 / 1024.0));
-
-            // Compute softmax on the last dimension
-            softmax(attention_prob, attention_prob, shape(attention_prob).size() - 1);
+        // Append K and V of the new tokens to the cache
+        const size_t bn_size = batch_size * num_heads;
+        const float *keys = K, *values = V;
+        size_t kv_len = seq_len, past_len = 0;
+        if (use_kv_cache) {
+            appendKVCache(K, V);
+            keys = k_cache.data();
+            values = v_cache.data();
+            past_len = kv_cache_len - seq_len;
+            kv_len = kv_cache_len;
         }
+        const size_t k_step = (use_kv_cache ? kv_cache_capacity : seq_len) * qkv_head_sizes[1],
+                     v_step = (use_kv_cache ? kv_cache_capacity : seq_len) * qkv_head_sizes[2];
 
-        // Compute MatMul(attention_prob, V)
-        auto &output_buffer = internals[2];
+        // Compute MatMul(Softmax(scale * MatMul(Q, K)), V) block by block
         {
             auto *output = outputs[0].ptr<float>();
-            auto *output_buff = output_buffer.ptr<float>();
-            const auto *prob = attention_prob.ptr<const float>();
 
-            auto loops = batch_size * num_heads;
-            auto prob_inner_size = seq_len * seq_len;
-            auto v_head_size = qkv_head_sizes[2];
-            auto v_inner_size = seq_len * v_head_size;
+            const size_t q_blocks = (seq_len + ATTENTION_BLOCK_Q - 1) / ATTENTION_BLOCK_Q;
+            const auto qk_head_size = qkv_head_sizes[0], v_head_size = qkv_head_sizes[2];
 
             opt.multi_thread = false;
-            parallel_for_(Range(0, loops), [&] (const Range &r) {
-                for (int i = r.start; i < r.end; i++) {
-                    const int output_offset = i * v_inner_size;
-
-                    const auto *p = prob + i * prob_inner_size, *v = V + i * v_inner_size;
-                    fastGemm(false, false, seq_len, seq_len, seq_len, v_head_size,
-                             1.f, p, seq_len, 1,
-                             v, v_head_size, 1, 0.f,
-                             output_buff + output_offset, v_head_size, opt);
-
-                    // tranpose on the fly
-                    const int batch_index = static_cast<int>(i / num_heads);
-                    const int head_index = static_cast<int>(i % num_heads);
-                    auto *src = output_buff + output_offset;
-                    auto *dst = output + (batch_index * seq_len * num_heads + head_index) * v_head_size;
-                    for (int j = 0; j < seq_len; j++) {
-                        std::memcpy(dst, src, v_head_size * sizeof(float));
-                        src += v_head_size;
-                        dst += qkv_hidden_sizes[2];
-                    }
+            parallel_for_(Range(0, static_cast<int>(bn_size * q_blocks)), [&] (const Range &r) {
+                AutoBuffer<float> buf(attentionBufferSize(v_head_size));
+                for (int t = r.start; t < r.end; t++) {
+                    const size_t i = t / q_blocks, qb = t % q_blocks;
+                    const size_t batch_index = i / num_heads, head_index = i % num_heads;
+                    const int q0 = static_cast<int>(qb * ATTENTION_BLOCK_Q);
+                    const int q_len = std::min(static_cast<int>(seq_len) - q0, static_cast<int>(ATTENTION_BLOCK_Q));
+                    const auto *q = Q + (i * seq_len + q0) * qk_head_size;
+                    // the output is transposed on the fly: [B, N, S, H] -> [B, S, N, H]
+                    auto *dst = output + ((batch_index * seq_len + q0) * num_heads + head_index) * v_head_size;
+                    attentionBlock(q_len, static_cast<int>(kv_len), static_cast<int>(qk_head_size), static_cast<int>(v_head_size),
+                                   scale, q, keys + i * k_step, values + i * v_step,
+                                   unidirectional ? static_cast<int>(past_len) + q0 : -1,
+                                   dst, qkv_hidden_sizes[2], buf.data(), opt);
                 }
-            }, loops * seq_len * seq_len * v_head_size * (1 / 1024.0));
+            }, bn_size * kv_len * seq_len * (qk_head_size + v_head_size) * (1 / 1024.0));
+        }
+    }
+
+    // Appends K and V of the current tokens ([B, N, S, H]) to the cache ([B * N, capacity, H]),
+    // the capacity of the cache grows geometrically.
+    void appendKVCache(const float *K, const float *V) {
+        const size_t bn_size = batch_size * num_heads;
+        const size_t k_head_size = qkv_head_sizes[1], v_head_size = qkv_head_sizes[2];
+        if (kv_cache_len > 0) {
+            CV_CheckEQ(kv_cache_bn, bn_size, "DNN/Attention: the batch size is changed, the key/value cache must be reset");
         }
+        size_t required = kv_cache_len + seq_len;
+        if (kv_cache_len == 0 || required > kv_cache_capacity) {
+            size_t capacity = std::max(required, 2 * (kv_cache_len == 0 ? 0 : kv_cache_capacity));
+            std::vector<float> k_new(bn_size * capacity * k_head_size), v_new(bn_size * capacity * v_head_size);
+            for (size_t i = 0; i < bn_size && kv_cache_len > 0; i++) {
+                std::memcpy(k_new.data() + i * capacity * k_head_size, k_cache.data() + i * kv_cache_capacity * k_head_size,
+                            kv_cache_len * k_head_size * sizeof(float));
+                std::memcpy(v_new.data() + i * capacity * v_head_size, v_cache.data() + i * kv_cache_capacity * v_head_size,
+                            kv_cache_len * v_head_size * sizeof(float));
+            }
+            k_cache.swap(k_new);
+            v_cache.swap(v_new);
+            kv_cache_capacity = capacity;
+            kv_cache_bn = bn_size;
+        }
+        for (size_t i = 0; i < bn_size; i++) {
+            std::memcpy(k_cache.data() + (i * kv_cache_capacity + kv_cache_len) * k_head_size, K + i * seq_len * k_head_size,
+                        seq_len * k_head_size * sizeof(float));
+            std::memcpy(v_cache.data() + (i * kv_cache_capacity + kv_cache_len) * v_head_size, V + i * seq_len * v_head_size,
+                        seq_len * v_head_size * sizeof(float));
+        }
+        kv_cache_len = required;
     }
 
  private:
@@ -281,6 +379,13 @@ class AttentionLayerImpl CV_FINAL : public AttentionLayer {
     size_t input_hidden_size;
     size_t hidden_size;
 
+    bool unidirectional;  // causal masking: a token attends only to itself and the previous tokens
+
+    // key/value cache of the incremental decoding: [B * N, capacity, H]
+    bool use_kv_cache;
+    std::vector<float> k_cache, v_cache;
+    size_t kv_cache_len, kv_cache_capacity, kv_cache_bn;
+
     bool is_prepacked;
     std::vector<float> packed_weight_q;
     std::vector<float> packed_weight_k;
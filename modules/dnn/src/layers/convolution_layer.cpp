@@ -243,7 +243,7 @@ public:
 
 
 //TODO: simultaneously convolution and bias addition for cache optimization
-class ConvolutionLayerImpl CV_FINAL : public BaseConvolutionLayerImpl
+class ConvolutionLayerImpl CV_FINAL : public BaseConvolutionLayerImpl, public PackedWeightsLayer
 {
 public:
     enum { VEC_ALIGN = 8, DFT_TYPE = CV_32F };
@@ -253,6 +253,10 @@ public:
     Ptr<ActivationLayer> activ;
 
     Ptr<FastConv> fastConvImpl;
+    uint64 fastConvFingerprint;  // of the weights and the parameters packed into fastConvImpl
+    bool fastConvUseFP16;        // fastConvImpl is packed for DNN_TARGET_CPU_FP16
+    Ptr<FastConv> loadedConvImpl;  // packed weights from a compiled network file, not validated yet
+    uint64 loadedConvFingerprint;
 
 #ifdef HAVE_OPENCL
     Ptr<OCL4DNNConvSpatial<float> > convolutionOp;
@@ -269,7 +273,8 @@ public:
     float cuda_power_exp, cuda_power_scale, cuda_power_shift;
 #endif
 
-    ConvolutionLayerImpl(const LayerParams &params) : BaseConvolutionLayerImpl(params)
+    ConvolutionLayerImpl(const LayerParams &params) : BaseConvolutionLayerImpl(params),
+        fastConvFingerprint(0), fastConvUseFP16(false), loadedConvFingerprint(0)
     {
 #ifdef HAVE_OPENCL
         newActiv = false;
@@ -1257,13 +1262,15 @@ public:
         int ngroups = inputs[0].size[1] / inpGroupCn;
         CV_Assert(outputs[0].size[1] % ngroups == 0);
 
-        reluslope.clear();
+        // local copy: forward() doesn't modify the layer state, so that execution contexts
+        // can run the layer concurrently
+        std::vector<float> activSlope;
         if( activ )
         {
             Ptr<ReLULayer> activ_relu = activ.dynamicCast<ReLULayer>();
             if( !activ_relu.empty() )
             {
-                reluslope.assign(outCn+2, activ_relu->negativeSlope);
+                activSlope.assign(outCn+2, activ_relu->negativeSlope);
             }
 
             Ptr<ChannelsPReLULayer> activ_chprelu = activ.dynamicCast<ChannelsPReLULayer>();
@@ -1272,9 +1279,9 @@ public:
                 const Mat& m = activ_chprelu->blobs[0];
                 CV_Assert(m.isContinuous() && m.type() == CV_32F && (int)m.total() == outCn);
                 const float* mdata = m.ptr<float>();
-                reluslope.resize(outCn+2);
-                std::copy(mdata, mdata + outCn, reluslope.begin());
-                reluslope[outCn] = reluslope[outCn+1] = reluslope[outCn-1];
+                activSlope.resize(outCn+2);
+                std::copy(mdata, mdata + outCn, activSlope.begin());
+                activSlope[outCn] = activSlope[outCn+1] = activSlope[outCn-1];
             }
         }
 
@@ -1287,26 +1294,107 @@ public:
                 conv_dim = CONV_3D;
 
             // Initialization of FastCovn2d, pack weight.
-            if (!fastConvImpl || variableWeight)
+            // The weights are packed again if the target is changed between CPU and CPU_FP16.
+            bool useFP16 = preferableTarget == DNN_TARGET_CPU_FP16;
+            if (!fastConvImpl || variableWeight || fastConvUseFP16 != useFP16)
             {
                 int K = outputs[0].size[1];
                 int C = inputs[0].size[1];
 
                 // Winograd only works when input h and w >= 12.
                 bool canUseWinograd = useWinograd && conv_dim == CONV_2D && inputs[0].size[2] >= 12 && inputs[0].size[3] >= 12;
+                fastConvUseFP16 = useFP16;
 
                 CV_Assert(outputs[0].size[1] % ngroups == 0);
-                fastConvImpl = initFastConv(weightsMat, &biasvec[0], ngroups, K, C, kernel_size, strides,
-                                            dilations, pads_begin, pads_end, conv_dim,
-                                            preferableTarget == DNN_TARGET_CPU_FP16, canUseWinograd);
+                fastConvFingerprint = variableWeight ? 0 :
+                        packingFingerprint(K, C, ngroups, conv_dim, useFP16, canUseWinograd);
+                if (loadedConvImpl && fastConvFingerprint == loadedConvFingerprint)
+                    fastConvImpl = loadedConvImpl;
+                else
+                    fastConvImpl = initFastConv(weightsMat, &biasvec[0], ngroups, K, C, kernel_size, strides,
+                                                dilations, pads_begin, pads_end, conv_dim,
+                                                useFP16, canUseWinograd);
+                loadedConvImpl.release();
                 // This is legal to release weightsMat here as this is not used anymore for
                 // OpenCV inference. If network needs to be reinitialized (new shape, new backend)
                 // a new version of weightsMat is created at .finalize() from original weights
                 weightsMat.release();
             }
 
-            runFastConv(inputs[0], outputs[0], fastConvImpl, nstripes, activ, reluslope, fusedAdd);
+            runFastConv(inputs[0], outputs[0], fastConvImpl, nstripes, activ, activSlope, fusedAdd);
+        }
+    }
+
+    // Identifies the packed weights: the packing parameters, the (fused) biases and a sample of
+    // the (fused) weights. The fusion scales the whole output channels, so every row is sampled.
+    uint64 packingFingerprint(int K, int C, int ngroups, int conv_dim, bool useFP16, bool canUseWinograd) const
+    {
+        uint64 h = 14695981039346656037ULL;  // FNV-1a
+        const int config[] = { K, C, ngroups, conv_dim, useFP16 ? 1 : 0, canUseWinograd ? 1 : 0 };
+        h = hashBytes(h, config, sizeof(config));
+        const std::vector<size_t>* sizes[] = { &kernel_size, &strides, &dilations, &pads_begin, &pads_end };
+        for (int i = 0; i < 5; i++)
+        {
+            for (size_t j = 0; j < sizes[i]->size(); j++)
+            {
+                int64 v = (int64)(*sizes[i])[j];
+                h = hashBytes(h, &v, sizeof(v));
+            }
+        }
+        h = hashBytes(h, biasvec.data(), std::min(biasvec.size(), (size_t)K) * sizeof(float));
+
+        CV_Assert(weightsMat.type() == CV_32F && weightsMat.dims == 2);
+        const int cols = weightsMat.cols, step = std::max(cols / 16, 1);
+        for (int i = 0; i < weightsMat.rows; i++)
+        {
+            const float* row = weightsMat.ptr<float>(i);
+            for (int j = 0; j < cols; j += step)
+                h = hashBytes(h, row + j, sizeof(float));
+            h = hashBytes(h, row + cols - 1, sizeof(float));
         }
+        return h;
+    }
+
+    static uint64 hashBytes(uint64 h, const void* data, size_t size)
+    {
+        const uchar* p = (const uchar*)data;
+        for (size_t i = 0; i < size; i++)
+            h = (h ^ p[i]) * 1099511628211ULL;
+        return h;
+    }
+
+    bool getPackedWeights(std::vector<int>& params, std::vector<Mat>& buffers) const CV_OVERRIDE
+    {
+        if (!fastConvImpl || blobs.empty() || fastConvFingerprint == 0)
+            return false;
+        getFastConvState(*fastConvImpl, params, buffers);
+        params.push_back((int)(fastConvFingerprint >> 32));
+        params.push_back((int)(fastConvFingerprint & 0xffffffffu));
+        return true;
+    }
+
+    void setPackedWeights(const std::vector<int>& params, const std::vector<Mat>& buffers) CV_OVERRIDE
+    {
+        CV_Assert(params.size() > 2);
+        std::vector<int> convParams(params.begin(), params.end() - 2);
+        loadedConvImpl = createFastConvFromState(convParams, buffers);
+        loadedConvFingerprint = ((uint64)(unsigned)params[params.size() - 2] << 32) | (unsigned)params.back();
+        fastConvImpl.release();
+    }
+
+    String getKernelName() const CV_OVERRIDE
+    {
+        if (!fastConvImpl)
+            return String();
+        const int type = fastConvImpl->conv_type;
+        String name = type == CONV_TYPE_WINOGRAD3X3 ? "winograd3x3" :
+                      type == CONV_TYPE_DEPTHWISE ? "depthwise3x3" :
+                      type == CONV_TYPE_DEPTHWISE_REMAIN ? "depthwise" : "generic";
+        if (fastConvImpl->useFP16)
+            name += "_fp16";
+        else if (fastConvImpl->useFP16Weights)
+            name += "_fp16weights";
+        return name;
     }
 
 #ifdef HAVE_CUDA
@@ -15,6 +15,7 @@
 #include "conv_block.simd.hpp"
 #include "layers/cpu_kernels/conv_block.simd_declarations.hpp" // defines CV_CPU_DISPATCH_MODES_ALL=AVX2,...,BASELINE based on CMakeLists.txt content
 #include <opencv2/core/utils/logger.hpp>
+#include <opencv2/core/hal/hal.hpp>
 
 namespace cv { namespace dnn {
 enum { VEC_ALIGN = 32}; // Memory alignment.
@@ -191,6 +192,10 @@ Ptr<FastConv> initFastConv(
         CV_LOG_ONCE_WARNING(NULL, "DNN: the CPU does not support the instruction set required by FP16, fallback to FP32.");
     }
 #endif
+    // Without FP16 arithmetic only the weights of the generic convolution are kept in FP16,
+    // this halves their memory footprint and traffic. The blocks of the weights are converted
+    // to FP32 right before the use (F16C on x86, see hal::cvt16f32f()).
+    conv->useFP16Weights = _useFP16 && !conv->useFP16 && conv->conv_type == CONV_TYPE_GENERIC;
 
     float *srcWeights = (float *)weightsMat.data;
     if (conv->conv_type == CONV_TYPE_DEPTHWISE || conv->conv_type == CONV_TYPE_DEPTHWISE_REMAIN)
@@ -441,6 +446,13 @@ Ptr<FastConv> initFastConv(
                     }
                 }
             }});
+
+            if (conv->useFP16Weights)
+            {
+                conv->weightsBuf_FP16.resize(nweights + VEC_ALIGN);
+                hal::cvt32f16f(weightsPtr, conv->getWeightsFP16(), (int)nweights);
+                std::vector<float>().swap(conv->weightsBuf);
+            }
         }
     }
     else
@@ -460,6 +472,84 @@ Ptr<FastConv> initFastConv(
     return conv;
 }
 
+template<typename T> static
+Mat exportPackedBuffer(std::vector<T>& buf, T* alignedPtr, int type)
+{
+    // the buffers are allocated with VEC_ALIGN extra elements for the alignment
+    if (buf.empty())
+        return Mat();
+    CV_Assert(buf.size() > (size_t)VEC_ALIGN);
+    return Mat(1, (int)(buf.size() - VEC_ALIGN), type, alignedPtr);
+}
+
+template<typename T> static
+void importPackedBuffer(const Mat& m, std::vector<T>& buf, T* (FastConv::*getAligned)(), FastConv& conv)
+{
+    buf.clear();
+    if (m.empty())
+        return;
+    CV_Assert(m.isContinuous() && m.elemSize() == sizeof(T));
+    buf.resize(m.total() + VEC_ALIGN);
+    memcpy((conv.*getAligned)(), m.ptr(), m.total() * sizeof(T));
+}
+
+enum { FAST_CONV_STATE_PARAMS = 21, FAST_CONV_STATE_BUFFERS = 5 };
+
+void getFastConvState(FastConv& conv, std::vector<int>& params, std::vector<Mat>& buffers)
+{
+    const int p[FAST_CONV_STATE_PARAMS] = {
+        conv.ngroups, conv.K, conv.C, conv.Hk, conv.Wk, conv.Dk,
+        conv.stride_h, conv.stride_w, conv.stride_d,
+        conv.dilation_h, conv.dilation_w, conv.dilation_d,
+        conv.pad_top, conv.pad_bottom, conv.pad_left, conv.pad_right, conv.pad_front, conv.pad_behind,
+        conv.conv_type, conv.conv_dim, (conv.useFP16 ? 1 : 0) | (conv.useFP16Weights ? 2 : 0)
+    };
+    params.assign(p, p + FAST_CONV_STATE_PARAMS);
+
+    buffers.resize(FAST_CONV_STATE_BUFFERS);
+    buffers[0] = exportPackedBuffer(conv.weightsBuf, conv.getWeights(), CV_32F);
+    buffers[1] = exportPackedBuffer(conv.weightsWinoBuf, conv.getWeightsWino(), CV_32F);
+    buffers[2] = conv.biasBuf.empty() ? Mat() : Mat(1, (int)conv.biasBuf.size(), CV_32F, conv.biasBuf.data());
+    buffers[3] = exportPackedBuffer(conv.weightsBuf_FP16, conv.getWeightsFP16(), CV_16F);
+    buffers[4] = exportPackedBuffer(conv.weightsWinoBuf_FP16, conv.getWeightsWinoFP16(), CV_16F);
+}
+
+Ptr<FastConv> createFastConvFromState(const std::vector<int>& params, const std::vector<Mat>& buffers)
+{
+    CV_CheckEQ((int)params.size(), (int)FAST_CONV_STATE_PARAMS, "");
+    CV_CheckEQ((int)buffers.size(), (int)FAST_CONV_STATE_BUFFERS, "");
+
+    Ptr<FastConv> conv = makePtr<FastConv>();
+    const int* p = params.data();
+    conv->ngroups = p[0]; conv->K = p[1]; conv->C = p[2];
+    conv->Hk = p[3]; conv->Wk = p[4]; conv->Dk = p[5];
+    conv->stride_h = p[6]; conv->stride_w = p[7]; conv->stride_d = p[8];
+    conv->dilation_h = p[9]; conv->dilation_w = p[10]; conv->dilation_d = p[11];
+    conv->pad_top = p[12]; conv->pad_bottom = p[13]; conv->pad_left = p[14];
+    conv->pad_right = p[15]; conv->pad_front = p[16]; conv->pad_behind = p[17];
+    conv->conv_type = p[18]; conv->conv_dim = p[19];
+    conv->useFP16 = (p[20] & 1) != 0; conv->useFP16Weights = (p[20] & 2) != 0;
+    CV_Assert(!conv->useFP16Weights || conv->conv_type == CONV_TYPE_GENERIC);
+    CV_Assert(conv->ngroups > 0 && conv->K > 0 && conv->C > 0 && conv->K % conv->ngroups == 0);
+    CV_Assert(conv->conv_type >= CONV_TYPE_GENERIC && conv->conv_type <= CONV_TYPE_DEPTHWISE_REMAIN);
+#ifndef CONV_ARM_FP16
+    CV_Assert(!conv->useFP16);
+#endif
+
+    importPackedBuffer(buffers[0], conv->weightsBuf, &FastConv::getWeights, *conv);
+    importPackedBuffer(buffers[1], conv->weightsWinoBuf, &FastConv::getWeightsWino, *conv);
+    if (!buffers[2].empty())
+    {
+        CV_Assert(buffers[2].isContinuous() && buffers[2].type() == CV_32F && (int)buffers[2].total() >= conv->K);
+        const float* bias = buffers[2].ptr<float>();
+        conv->biasBuf.assign(bias, bias + buffers[2].total());
+    }
+    importPackedBuffer(buffers[3], conv->weightsBuf_FP16, &FastConv::getWeightsFP16, *conv);
+    importPackedBuffer(buffers[4], conv->weightsWinoBuf_FP16, &FastConv::getWeightsWinoFP16, *conv);
+    CV_Assert(!conv->biasBuf.empty());
+    return conv;
+}
+
 static inline void packData8(char*& inpbuf, float*& inptrIn, int& in_w, int& x0, int& s0, const int* ofstab,
                              const int stride_w, const int ksize, const int esz)
 {
@@ -1261,6 +1351,10 @@ void runFastConv(InputArray _input, OutputArray _output, const Ptr<FastConv>& co
     }
 #endif
 
+    // element size of the packed weights
+    const bool useFP16Weights = conv->useFP16Weights;
+    const int wesz = useFP16Weights ? (int)sizeof(hfloat) : esz;
+
     int MAX_STRIPES = conv->conv_type == CONV_TYPE_DEPTHWISE_REMAIN ? 1 : (56 + CONV_NR - 1)/CONV_NR;
 
     // Friendly to L1 cache
@@ -1289,7 +1383,9 @@ void runFastConv(InputArray _input, OutputArray _output, const Ptr<FastConv>& co
     size_t stripesize = alignSize(CONV_NR * ksize * Cg, VEC_ALIGN);
     size_t cbufsize = alignSize(CONV_NR * K_BLOCK_SIZE * MAX_STRIPES, VEC_ALIGN);
 
-    size_t taskbufsize = cbufsize * sizeof(float );
+    // the FP16 weights of a (K_BLOCK_SIZE x C_BLOCK_SIZE) block are converted to FP32 into the task buffer
+    size_t wbufsize = useFP16Weights ? alignSize(((K_BLOCK_SIZE + CONV_MR - 1) / CONV_MR) * CONV_MR * C_BLOCK_SIZE, VEC_ALIGN) : 0;
+    size_t taskbufsize = (cbufsize + wbufsize) * sizeof(float );
 
     if (!separateIm2col)
         taskbufsize += MAX_STRIPES * stripesize * esz;
@@ -1372,7 +1468,8 @@ void runFastConv(InputArray _input, OutputArray _output, const Ptr<FastConv>& co
     for (int task_id = r0.start; task_id < r0.end; task_id++)
     {
         float * cbuf_task = (float *)(inpbuf_all + taskbufsize * task_id);
-        char * inpbuf_task = (char*)(cbuf_task + cbufsize);
+        float * wbuf_task = cbuf_task + cbufsize;
+        char * inpbuf_task = (char*)(wbuf_task + wbufsize);
 
         int ngs0 = (int)((size_t)nsubtasks * task_id / ntasks);
         int ngs1 = (int)((size_t)nsubtasks * (task_id+1) / ntasks);
@@ -1432,6 +1529,12 @@ void runFastConv(InputArray _input, OutputArray _output, const Ptr<FastConv>& co
                 }
                 else
 #endif
+                if (useFP16Weights)
+                {
+                    CV_Assert(!conv->weightsBuf_FP16.empty());
+                    weights = (char *)conv->getWeightsFP16();
+                }
+                else
                 {
                     CV_Assert(!conv->weightsBuf.empty());
                     weights = (char *)conv->getWeights();
@@ -1489,7 +1592,7 @@ void runFastConv(InputArray _input, OutputArray _output, const Ptr<FastConv>& co
                 }
 
                 CV_Assert(weights);
-                weights += g * Kg_aligned * DkHkWkCg * esz;
+                weights += g * Kg_aligned * DkHkWkCg * wesz;
 
                 const float *biasptr = conv->biasBuf.data() + Kg * g;
                 int ldc = nstripes * CONV_NR;
@@ -1505,15 +1608,29 @@ void runFastConv(InputArray _input, OutputArray _output, const Ptr<FastConv>& co
                         const char *inptr = separateIm2col ? inpbuf_all_0 + (ng * stripes_per_plane0 + zyx0 / CONV_NR) * stripesize * esz :
                                             inpbuf_task;
                         inptr += (c0 * CONV_NR) * esz;
+
+                        char *wptr0 = weights + (k0_block * DkHkWkCg + c0 * CONV_MR) * wesz;
+                        size_t wstep = DkHkWkCg * CONV_MR * esz;
+                        if (useFP16Weights)
+                        {
+                            // the weights of the block are reused by all the stripes
+                            const int wlen = (c1 - c0) * CONV_MR;
+                            for (int k = k0_block; k < k1_block; k += CONV_MR)
+                                hal::cvt16f32f((const hfloat *)wptr0 + (size_t)(k - k0_block) * DkHkWkCg,
+                                               wbuf_task + (k - k0_block) * C_BLOCK_SIZE, wlen);
+                            wptr0 = (char *)wbuf_task;
+                            wstep = C_BLOCK_SIZE * CONV_MR * sizeof(float);
+                        }
+
                         for (int stripe = 0; stripe < nstripes; stripe++, inptr += stripesize * esz)
                         {
                             const int outLen = std::min(out_width - stripe * CONV_NR, CONV_NR);
 
-                            char *wptr = weights + (k0_block * DkHkWkCg + c0 * CONV_MR) * esz;
+                            char *wptr = wptr0;
                             float *cptr = cbuf_task + stripe * CONV_NR;
                             hfloat* cptr_f16 = (hfloat*)cbuf_task + stripe*CONV_NR;
                             for (int k = k0_block; k < k1_block; k += CONV_MR,
-                                    wptr += DkHkWkCg * CONV_MR * esz, cptr += CONV_MR * ldc, cptr_f16 += CONV_MR * ldc)
+                                    wptr += wstep, cptr += CONV_MR * ldc, cptr_f16 += CONV_MR * ldc)
                             {
 #if CV_TRY_AVX2
                                 if (conv->useAVX2)
@@ -70,6 +70,7 @@ struct FastConv
     int conv_type;
     int conv_dim;  // Flag for conv1d, conv2d, or conv3d.
     bool useFP16 = false; // Only ARMv8 is supported.
+    bool useFP16Weights = false; // The other platforms: the weights are stored in FP16, the computations are done in FP32.
 #if CV_SIMD128
     bool useSIMD128 = true;
 #else
@@ -102,6 +103,11 @@ Ptr<FastConv> initFastConv(
         const bool useFP16,
         bool useWinograd);
 
+// Export and import of the packed weights (see ConvolutionLayerImpl::getPackedWeights()).
+// The buffers of getFastConvState() refer to the memory of conv.
+void getFastConvState(FastConv& conv, std::vector<int>& params, std::vector<Mat>& buffers);
+Ptr<FastConv> createFastConvFromState(const std::vector<int>& params, const std::vector<Mat>& buffers);
+
 // It contains different computing branches, like winograd, 1x1 conv.
 void runFastConv(InputArray _input, OutputArray _output, const Ptr<FastConv>& conv, int ntasks,
                    const Ptr<ActivationLayer>& actLayer, const std::vector<float>& reluslope, bool fusedAdd);
@@ -20,6 +20,26 @@
 
 namespace cv { namespace dnn {
 
+void fastGemmApplyEpilogue(const FastGemmEpilogue &epilogue, float *C_block, size_t block_offset,
+                           int ldc, int mc, int j0, int nc) {
+    const float *bias = epilogue.bias ? epilogue.bias + j0 : 0;
+    const float *residual = epilogue.residual ? epilogue.residual + block_offset : 0;
+    for (int i = 0; i < mc; i++) {
+        float *c = C_block + i * ldc;
+        if (bias) {
+            for (int j = 0; j < nc; j++)
+                c[j] += bias[j];
+        }
+        if (epilogue.activ)
+            epilogue.activ->forwardSlice(c, c, nc, nc, 0, 1);
+        if (residual) {
+            const float *r = residual + i * ldc;
+            for (int j = 0; j < nc; j++)
+                c[j] += r[j];
+        }
+    }
+}
+
 size_t fastGemmPackBSize(size_t N, size_t K, const FastGemmOpt &opt) {
 #if CV_TRY_NEON
     if (opt.use_neon) {
@@ -120,6 +140,64 @@ void fastGemmPackB(const Mat &B, std::vector<float> &packed_B, bool trans, FastG
     }
 }
 
+void fastGemmPackB(const Mat &B, FastGemmPackedB &packed_B, bool trans, int type, FastGemmOpt &opt) {
+    CV_CheckTypeEQ(B.type(), CV_32F, "fastGemmPackB: only float32 weights can be compressed");
+    CV_CheckType(type, type == CV_32F || type == CV_16F || type == CV_8S, "fastGemmPackB: unsupported storage type");
+
+    std::vector<float> packed_f32;
+    packed_B.type = type;
+    packed_B.scales.clear();
+    if (type == CV_32F) {
+        fastGemmPackB(B, packed_f32, trans, opt);
+        packed_B.data.resize(packed_f32.size() * sizeof(float));
+        memcpy(packed_B.data.data(), packed_f32.data(), packed_B.data.size());
+        return;
+    }
+
+    auto B_shape = shape(B);
+    int batch = total(B_shape, 0, B_shape.size() - 2),
+        rows = B_shape[B_shape.size() - 2], cols = B_shape.back();
+    Mat B_f32 = B.isContinuous() ? B : B.clone();
+
+    if (type == CV_8S) {
+        // Symmetric per-column quantization of B (columns of the product, i.e. output channels).
+        // The values are rounded before the packing, the scales are packed as a 1 x N matrix,
+        // so the kernels find the scale of a packed column at the same position within the tile.
+        B_f32 = B_f32.clone();
+        int N = trans ? rows : cols, K = trans ? cols : rows;
+        Mat scales(std::vector<int>{batch, 1, N}, CV_32F);
+        for (int b = 0; b < batch; b++) {
+            float *bptr = B_f32.ptr<float>() + (size_t)b * rows * cols;
+            float *sptr = scales.ptr<float>() + (size_t)b * N;
+            for (int n = 0; n < N; n++) {
+                size_t step = trans ? 1 : cols;
+                float *col = bptr + (trans ? (size_t)n * cols : (size_t)n);
+                float maxabs = 0.f;
+                for (int k = 0; k < K; k++)
+                    maxabs = std::max(maxabs, std::abs(col[k * step]));
+                float inv_scale = maxabs > 0.f ? 127.f / maxabs : 0.f;
+                for (int k = 0; k < K; k++)
+                    col[k * step] = (float)cvRound(col[k * step] * inv_scale);
+                sptr[n] = maxabs / 127.f;
+            }
+        }
+        fastGemmPackB(scales, packed_B.scales, false, opt);
+    }
+
+    fastGemmPackB(B_f32, packed_f32, trans, opt);
+    size_t total_packed = packed_f32.size();
+    packed_B.data.resize(total_packed * CV_ELEM_SIZE(type));
+    if (type == CV_8S) {
+        schar *dst = (schar *)packed_B.data.data();
+        for (size_t i = 0; i < total_packed; i++)
+            dst[i] = saturate_cast<schar>(packed_f32[i]);
+    } else {
+        hfloat *dst = (hfloat *)packed_B.data.data();
+        for (size_t i = 0; i < total_packed; i++)
+            dst[i] = hfloat(packed_f32[i]);
+    }
+}
+
 void fastGemmPackB(bool trans, size_t N, size_t K, const float *B, size_t ldb, float *packed_B, const FastGemmOpt &opt) {
     size_t ldb0 = ldb, ldb1 = 1;
     if (trans) {
@@ -187,12 +265,12 @@ static void fast_gemm_thin(float alpha, float beta, int M, int N, int K,
     }
 }
 
-void fastGemm(bool trans_a, int M, int N, int K,
-              float alpha, const float *A, int lda,
-              const float *packed_B, float beta,
-              float *C, int ldc, FastGemmOpt &opt) {
+static void fast_gemm_packed(bool trans_a, int M, int N, int K,
+                             float alpha, const float *A, int lda,
+                             const char *packed_b, int packed_B_type, const float *packed_B_scales,
+                             float beta, float *C, int ldc, FastGemmOpt &opt,
+                             const FastGemmEpilogue *epilogue) {
     const char *a = (const char *)A;
-    const char *packed_b = (const char *)packed_B;
     char *c = (char *)C;
 
     int lda0 = lda, lda1 = 1;
@@ -202,29 +280,45 @@ void fastGemm(bool trans_a, int M, int N, int K,
 
 #if CV_TRY_NEON
     if (opt.use_neon) {
-        opt_NEON::fastGemmKernel(M, N, K, alpha, a, lda0, lda1, packed_b, beta, c, ldc, sizeof(float), opt.multi_thread);
+        opt_NEON::fastGemmKernel(M, N, K, alpha, a, lda0, lda1, packed_b, packed_B_type, packed_B_scales, beta, c, ldc, sizeof(float), opt.multi_thread, epilogue);
     } else
 #endif
 #if CV_TRY_AVX2
     if (opt.use_avx2) {
-        opt_AVX2::fastGemmKernel(M, N, K, alpha, a, lda0, lda1, packed_b, beta, c, ldc, sizeof(float), opt.multi_thread);
+        opt_AVX2::fastGemmKernel(M, N, K, alpha, a, lda0, lda1, packed_b, packed_B_type, packed_B_scales, beta, c, ldc, sizeof(float), opt.multi_thread, epilogue);
     } else
 #endif
 #if CV_TRY_AVX
     if (opt.use_avx) {
-        opt_AVX::fastGemmKernel(M, N, K, alpha, a, lda0, lda1, packed_b, beta, c, ldc, sizeof(float), opt.multi_thread);
+        opt_AVX::fastGemmKernel(M, N, K, alpha, a, lda0, lda1, packed_b, packed_B_type, packed_B_scales, beta, c, ldc, sizeof(float), opt.multi_thread, epilogue);
     } else
 #endif
 #if CV_TRY_LASX
     if (opt.use_lasx) {
-        opt_LASX::fastGemmKernel(M, N, K, alpha, a, lda0, lda1, packed_b, beta, c, ldc, sizeof(float), opt.multi_thread);
+        opt_LASX::fastGemmKernel(M, N, K, alpha, a, lda0, lda1, packed_b, packed_B_type, packed_B_scales, beta, c, ldc, sizeof(float), opt.multi_thread, epilogue);
     } else
 #endif
     {
-        cpu_baseline::fastGemmKernel(M, N, K, alpha, a, lda0, lda1, packed_b, beta, c, ldc, sizeof(float), opt.multi_thread);
+        cpu_baseline::fastGemmKernel(M, N, K, alpha, a, lda0, lda1, packed_b, packed_B_type, packed_B_scales, beta, c, ldc, sizeof(float), opt.multi_thread, epilogue);
     }
 }
 
+void fastGemm(bool trans_a, int M, int N, int K,
+              float alpha, const float *A, int lda,
+              const float *packed_B, float beta,
+              float *C, int ldc, FastGemmOpt &opt) {
+    fast_gemm_packed(trans_a, M, N, K, alpha, A, lda, (const char *)packed_B, CV_32F, 0, beta, C, ldc, opt, 0);
+}
+
+void fastGemm(bool trans_a, int M, int N, int K,
+              float alpha, const float *A, int lda,
+              const FastGemmPackedB &packed_B, float beta,
+              float *C, int ldc, FastGemmOpt &opt,
+              const FastGemmEpilogue *epilogue) {
+    fast_gemm_packed(trans_a, M, N, K, alpha, A, lda, packed_B.ptr(), packed_B.type,
+                     packed_B.scales.empty() ? 0 : packed_B.scales.data(), beta, C, ldc, opt, epilogue);
+}
+
 void fastGemm(bool trans_a, bool trans_b, int ma, int na, int mb, int nb,
               float alpha, const float *A, int lda0, int lda1, const float *B, int ldb0, int ldb1,
               float beta, float *C, int ldc, FastGemmOpt &opt) {
@@ -342,38 +436,55 @@ void fastGemmBatch(size_t batch, const size_t *A_offsets, const size_t *B_offset
     }
 }
 
-void fastGemmBatch(size_t batch, const size_t *A_offsets, const size_t *packed_B_offsets, const size_t *C_offsets,
-                   int M, int N, int K, float alpha, const float *A, int lda0, int lda1,
-                   const float *packed_B, float beta, float *C, int ldc, FastGemmOpt &opt) {
+static void fast_gemm_batch_packed(size_t batch, const size_t *A_offsets, const size_t *packed_B_offsets, const size_t *C_offsets,
+                                   int M, int N, int K, float alpha, const float *A, int lda0, int lda1,
+                                   const char *b, int packed_B_type, const float *packed_B_scales,
+                                   float beta, float *C, int ldc, FastGemmOpt &opt,
+                                   const FastGemmEpilogue *epilogue) {
     const char *a = (const char *)A;
-    const char *b = (const char *)packed_B;
     char *c = (char *)C;
 
 #if CV_TRY_NEON
     if (opt.use_neon) {
-        opt_NEON::fastGemmBatchKernel(batch, A_offsets, packed_B_offsets, C_offsets, M, N, K, alpha, a, lda0, lda1, b, beta, c, ldc, sizeof(float));
+        opt_NEON::fastGemmBatchKernel(batch, A_offsets, packed_B_offsets, C_offsets, M, N, K, alpha, a, lda0, lda1, b, packed_B_type, packed_B_scales, beta, c, ldc, sizeof(float), epilogue);
     } else
 #endif
 #if CV_TRY_AVX2
     if (opt.use_avx2) {
-        opt_AVX2::fastGemmBatchKernel(batch, A_offsets, packed_B_offsets, C_offsets, M, N, K, alpha, a, lda0, lda1, b, beta, c, ldc, sizeof(float));
+        opt_AVX2::fastGemmBatchKernel(batch, A_offsets, packed_B_offsets, C_offsets, M, N, K, alpha, a, lda0, lda1, b, packed_B_type, packed_B_scales, beta, c, ldc, sizeof(float), epilogue);
     } else
 #endif
 #if CV_TRY_AVX
     if (opt.use_avx) {
-        opt_AVX::fastGemmBatchKernel(batch, A_offsets, packed_B_offsets, C_offsets, M, N, K, alpha, a, lda0, lda1, b, beta, c, ldc, sizeof(float));
+        opt_AVX::fastGemmBatchKernel(batch, A_offsets, packed_B_offsets, C_offsets, M, N, K, alpha, a, lda0, lda1, b, packed_B_type, packed_B_scales, beta, c, ldc, sizeof(float), epilogue);
     } else
 #endif
 #if CV_TRY_LASX
     if (opt.use_lasx) {
-        opt_LASX::fastGemmBatchKernel(batch, A_offsets, packed_B_offsets, C_offsets, M, N, K, alpha, a, lda0, lda1, b, beta, c, ldc, sizeof(float));
+        opt_LASX::fastGemmBatchKernel(batch, A_offsets, packed_B_offsets, C_offsets, M, N, K, alpha, a, lda0, lda1, b, packed_B_type, packed_B_scales, beta, c, ldc, sizeof(float), epilogue);
     } else
 #endif
     {
-        cpu_baseline::fastGemmBatchKernel(batch, A_offsets, packed_B_offsets, C_offsets, M, N, K, alpha, a, lda0, lda1, b, beta, c, ldc, sizeof(float));
+        cpu_baseline::fastGemmBatchKernel(batch, A_offsets, packed_B_offsets, C_offsets, M, N, K, alpha, a, lda0, lda1, b, packed_B_type, packed_B_scales, beta, c, ldc, sizeof(float), epilogue);
     }
 }
 
+void fastGemmBatch(size_t batch, const size_t *A_offsets, const size_t *packed_B_offsets, const size_t *C_offsets,
+                   int M, int N, int K, float alpha, const float *A, int lda0, int lda1,
+                   const float *packed_B, float beta, float *C, int ldc, FastGemmOpt &opt) {
+    fast_gemm_batch_packed(batch, A_offsets, packed_B_offsets, C_offsets, M, N, K, alpha, A, lda0, lda1,
+                           (const char *)packed_B, CV_32F, 0, beta, C, ldc, opt, 0);
+}
+
+void fastGemmBatch(size_t batch, const size_t *A_offsets, const size_t *packed_B_offsets, const size_t *C_offsets,
+                   int M, int N, int K, float alpha, const float *A, int lda0, int lda1,
+                   const FastGemmPackedB &packed_B, float beta, float *C, int ldc, FastGemmOpt &opt,
+                   const FastGemmEpilogue *epilogue) {
+    fast_gemm_batch_packed(batch, A_offsets, packed_B_offsets, C_offsets, M, N, K, alpha, A, lda0, lda1,
+                           packed_B.ptr(), packed_B.type, packed_B.scales.empty() ? 0 : packed_B.scales.data(),
+                           beta, C, ldc, opt, epilogue);
+}
+
 void fastGemmBatch(bool trans_a, bool trans_b,
                    float alpha, const Mat &A, const Mat &B,
                    float beta, Mat &C, FastGemmOpt &opt) {
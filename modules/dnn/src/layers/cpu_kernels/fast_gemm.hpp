@@ -14,6 +14,7 @@
 
 #include "opencv2/core/hal/intrin.hpp"
 #include <opencv2/dnn/shape_utils.hpp>
+#include <opencv2/dnn/all_layers.hpp>
 
 namespace cv { namespace dnn {
 
@@ -151,15 +152,54 @@ struct MatMulHelper {
     }
 };
 
+// Packed B with the optional weight-only compression: CV_32F (no compression), CV_16F or CV_8S.
+// CV_8S values are quantized symmetrically per column of B (per output channel),
+// the scales are packed as well. The kernels convert the blocks of B to float32
+// on the fly and accumulate in float32.
+struct FastGemmPackedB {
+    int type;
+    std::vector<uchar> data;
+    std::vector<float> scales;
+
+    FastGemmPackedB() : type(CV_32F) {}
+
+    bool empty() const { return data.empty(); }
+    size_t total() const { return data.size() / CV_ELEM_SIZE(type); }
+    const char *ptr() const { return (const char *)data.data(); }
+    void release() { data.clear(); scales.clear(); }
+};
+
+// Epilogue of the GEMM with packed B. It is applied to each block of C right after the block
+// is computed, while it is still in cache: C = activ(C + bias) + residual.
+// The activation must be element-wise, it is applied to the rows of the block.
+struct FastGemmEpilogue {
+    const float *bias;            // [N], added to each row of C; optional
+    const float *residual;        // has the same layout as C (the same offsets and ldc); optional
+    const ActivationLayer *activ; // optional
+
+    FastGemmEpilogue() : bias(0), residual(0), activ(0) {}
+};
+
+// Applies the epilogue to the block of C of mc x nc starting at the column j0,
+// block_offset is the offset of the block from the beginning of C in elements.
+void fastGemmApplyEpilogue(const FastGemmEpilogue &epilogue, float *C_block, size_t block_offset,
+                           int ldc, int mc, int j0, int nc);
+
 size_t fastGemmPackBSize(size_t N, size_t K, const FastGemmOpt &opt);
 
 void fastGemmPackB(const Mat &m, std::vector<float> &packed_B, bool trans, FastGemmOpt &opt);
 void fastGemmPackB(bool trans, size_t N, size_t K, const float *B, size_t ldb, float *packed_B, const FastGemmOpt &opt);
+void fastGemmPackB(const Mat &m, FastGemmPackedB &packed_B, bool trans, int type, FastGemmOpt &opt);
 
 void fastGemm(bool trans_a, int M, int N, int K,
               float alpha, const float *A, int lda,
               const float *packed_B, float beta,
               float *C, int ldc, FastGemmOpt &opt);
+void fastGemm(bool trans_a, int M, int N, int K,
+              float alpha, const float *A, int lda,
+              const FastGemmPackedB &packed_B, float beta,
+              float *C, int ldc, FastGemmOpt &opt,
+              const FastGemmEpilogue *epilogue = 0);
 void fastGemm(bool trans_a, bool trans_b, int ma, int na, int mb, int nb,
               float alpha, const float *A, int lda0, int lda1, const float *B, int ldb0, int ldb1,
               float beta, float *C, int ldc, FastGemmOpt &opt);
@@ -173,6 +213,10 @@ void fastGemmBatch(size_t batch, const size_t *A_offsets, const size_t *B_offset
 void fastGemmBatch(size_t batch, const size_t *A_offsets, const size_t *B_offsets, const size_t *C_offsets,
                    int M, int N, int K, float alpha, const float *A, int lda0, int lda1,
                    const float *packed_B, float beta, float *C, int ldc, FastGemmOpt &opt);
+void fastGemmBatch(size_t batch, const size_t *A_offsets, const size_t *packed_B_offsets, const size_t *C_offsets,
+                   int M, int N, int K, float alpha, const float *A, int lda0, int lda1,
+                   const FastGemmPackedB &packed_B, float beta, float *C, int ldc, FastGemmOpt &opt,
+                   const FastGemmEpilogue *epilogue = 0);
 void fastGemmBatch(bool trans_a, bool trans_b, float alpha, const Mat &A,
                    const Mat &B, float beta, Mat &C, FastGemmOpt &opt);
 
@@ -113,6 +113,11 @@ static void fast_gemm_pack##N##suffix( int m, int k, const void* A_, \
 
 namespace cv { namespace dnn {
 
+// the fused epilogue, see fast_gemm.hpp
+struct FastGemmEpilogue;
+void fastGemmApplyEpilogue(const FastGemmEpilogue &epilogue, float *C_block, size_t block_offset,
+                           int ldc, int mc, int j0, int nc);
+
 CV_CPU_OPTIMIZATION_NAMESPACE_BEGIN
 
 int fastGemmPackBSize(int N, int K);
@@ -125,14 +130,17 @@ void fastGemmKernel(int M, int N, int K,
                     float beta, char *C, int ldc, int esz, bool multi_thread);
 void fastGemmKernel(int M, int N, int K,
                     float alpha, const char *A, int lda0, int lda1,
-                    const char *packed_B, float beta, char *C, int ldc, int esz, bool multi_thread);
+                    const char *packed_B, int packed_B_type, const float *packed_B_scales,
+                    float beta, char *C, int ldc, int esz, bool multi_thread,
+                    const FastGemmEpilogue *epilogue);
 
 void fastGemmBatchKernel(size_t batch, const size_t *A_offsets, const size_t *B_offsets, const size_t *C_offsets,
                          int M, int N, int K, float alpha, const char *A, int lda0, int lda1,
                          const char *B, int ldb0, int ldb1, float beta, char *C, int ldc, int esz);
 void fastGemmBatchKernel(size_t batch, const size_t *A_offsets, const size_t *B_offsets, const size_t *C_offsets,
                          int M, int N, int K, float alpha, const char *A, int lda0, int lda1,
-                         const char *packed_B, float beta, char *C, int ldc, int esz);
+                         const char *packed_B, int packed_B_type, const float *packed_B_scales,
+                         float beta, char *C, int ldc, int esz, const FastGemmEpilogue *epilogue);
 
 #ifndef CV_CPU_OPTIMIZATION_DECLARATIONS_ONLY
 
@@ -531,6 +539,41 @@ static inline void fast_gemm_macro_kernel(int m, int n, int k,
     }
 }
 
+// Converts a block of the compressed packed B (nc / NR panels of kc x NR values) to float32,
+// CV_8S values are multiplied by the scales of their columns.
+static void fast_gemm_dequantize_b(int kc, int nc, const char *packed_B, int type,
+                                   const float *scales, float *dst) {
+    const int NR = FAST_GEMM_F32_NR;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+    const int vlanes = VTraits<v_float32>::vlanes();
+#endif
+    for (int g = 0; g < nc; g += NR) {
+        for (int p = 0; p < kc; p++) {
+            size_t ofs = (size_t)g * kc + (size_t)p * NR;
+            float *d = dst + ofs;
+            int j = 0;
+            if (type == CV_8S) {
+                const schar *s = (const schar*)packed_B + ofs;
+                const float *sc = scales + g;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+                for (; j <= NR - vlanes; j += vlanes)
+                    v_store(d + j, v_mul(v_cvt_f32(vx_load_expand_q(s + j)), vx_load(sc + j)));
+#endif
+                for (; j < NR; j++)
+                    d[j] = s[j] * sc[j];
+            } else {
+                const hfloat *s = (const hfloat*)packed_B + ofs;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+                for (; j <= NR - vlanes; j += vlanes)
+                    v_store(d + j, vx_load_expand(s + j));
+#endif
+                for (; j < NR; j++)
+                    d[j] = (float)s[j];
+            }
+        }
+    }
+}
+
 int fastGemmPackBSize(int N, int K) {
     int GEMM_NC = FAST_GEMM_F32_NC, GEMM_NR = FAST_GEMM_F32_NR;
     int NC = (((GEMM_NC < N ? GEMM_NC : N) + GEMM_NR - 1) / GEMM_NR) * GEMM_NR;
@@ -657,7 +700,9 @@ void fastGemmKernel(int M, int N, int K,
 
 void fastGemmKernel(int M, int N, int K,
                     float alpha, const char *A, int lda0, int lda1,
-                    const char *packed_B, float beta, char *C, int ldc, int esz, bool multi_thread) {
+                    const char *packed_B, int packed_B_type, const float *packed_B_scales,
+                    float beta, char *C, int ldc, int esz, bool multi_thread,
+                    const FastGemmEpilogue *epilogue) {
     int GEMM_MC = FAST_GEMM_F32_MC,
         GEMM_NC = FAST_GEMM_F32_NC,
         GEMM_MR = FAST_GEMM_F32_MR,
@@ -667,7 +712,10 @@ void fastGemmKernel(int M, int N, int K,
     int NC = (((GEMM_NC < N ? GEMM_NC : N) + GEMM_NR - 1) / GEMM_NR) * GEMM_NR;
     int KC = std::min(FAST_GEMM_F32_PACKED_STRIDE_K, K);
 
-    size_t buff_size = KC * MC * esz;
+    // compressed B is converted to float32 block by block
+    const bool compressed_B = packed_B_type != CV_32F;
+    const int esz_B = compressed_B ? CV_ELEM_SIZE(packed_B_type) : esz;
+    size_t buff_size = KC * MC * esz + (compressed_B ? KC * NC * esz : 0);
     bool use_stackbuff = buff_size <= FAST_GEMM_MAX_STACKBUF;
     int m_tiles = (M + MC - 1) / MC;
     int n_tiles = (N + NC - 1) / NC;
@@ -675,6 +723,7 @@ void fastGemmKernel(int M, int N, int K,
 
     auto fn = [&](const Range &r) {
         char* packed_a = (char*)(use_stackbuff ? alloca(buff_size) : malloc(buff_size)); // TODO: use AutoBuffer
+        float* dequant_b = (float*)(packed_a + KC * MC * esz);
         const char *packed_b_ = packed_B;
         int start = r.start;
         int end = r.end;
@@ -686,7 +735,8 @@ void fastGemmKernel(int M, int N, int K,
             int nc = N - j0 < NC ? N - j0 : NC;
             int ldc_block = ldc;
             char* c_block = C + (i0 * ldc + j0) * esz;
-            packed_b_ = packed_B + j0 * K * esz;
+            packed_b_ = packed_B + j0 * K * esz_B;
+            const float *scales_ = packed_B_scales ? packed_B_scales + j0 : 0;
 
             if (beta == 0.f) {
                 for(int i = 0; i < mc; i++)
@@ -699,7 +749,8 @@ void fastGemmKernel(int M, int N, int K,
                 }
             }
 
-            int _nc = static_cast<int>((nc + GEMM_NR - 1) / GEMM_NR) * GEMM_NR * esz;
+            int nc_padded = static_cast<int>((nc + GEMM_NR - 1) / GEMM_NR) * GEMM_NR;
+            int _nc = nc_padded * esz_B;
             for(int k0 = 0; k0 < K; k0 += KC)
             {
                 int kc = K - k0 < KC ? K - k0 : KC;
@@ -715,9 +766,16 @@ void fastGemmKernel(int M, int N, int K,
 #endif
 
                 // run kernel
-                fast_gemm_macro_kernel(mc, nc, kc, packed_a, packed_b_, alpha, c_block, ldc_block, esz);
+                const char *b_block = packed_b_;
+                if (compressed_B) {
+                    fast_gemm_dequantize_b(kc, nc_padded, packed_b_, packed_B_type, scales_, dequant_b);
+                    b_block = (const char*)dequant_b;
+                }
+                fast_gemm_macro_kernel(mc, nc, kc, packed_a, b_block, alpha, c_block, ldc_block, esz);
                 packed_b_ += _nc * kc;
             }
+            if (epilogue)
+                fastGemmApplyEpilogue(*epilogue, (float*)c_block, (c_block - C) / esz, ldc_block, mc, j0, nc);
         }
 
         if (!use_stackbuff) {
@@ -826,7 +884,8 @@ void fastGemmBatchKernel(size_t batch, const size_t *A_offsets, const size_t *B_
 
 void fastGemmBatchKernel(size_t batch, const size_t *A_offsets, const size_t *B_offsets, const size_t *C_offsets,
                          int M, int N, int K, float alpha, const char *A, int lda0, int lda1,
-                         const char *packed_B, float beta, char *C, int ldc, int esz) {
+                         const char *packed_B, int packed_B_type, const float *packed_B_scales,
+                         float beta, char *C, int ldc, int esz, const FastGemmEpilogue *epilogue) {
     int GEMM_MC = FAST_GEMM_F32_MC,
         GEMM_NC = FAST_GEMM_F32_NC,
         GEMM_MR = FAST_GEMM_F32_MR,
@@ -836,7 +895,10 @@ void fastGemmBatchKernel(size_t batch, const size_t *A_offsets, const size_t *B_
     int NC = (((GEMM_NC < N ? GEMM_NC : N) + GEMM_NR - 1) / GEMM_NR) * GEMM_NR;
     int KC = std::min(FAST_GEMM_F32_PACKED_STRIDE_K, K);
 
-    size_t buff_size = KC * MC * esz;
+    // compressed B is converted to float32 block by block
+    const bool compressed_B = packed_B_type != CV_32F;
+    const int esz_B = compressed_B ? CV_ELEM_SIZE(packed_B_type) : esz;
+    size_t buff_size = KC * MC * esz + (compressed_B ? KC * NC * esz : 0);
     bool use_stackbuff = buff_size <= FAST_GEMM_MAX_STACKBUF;
     int m_tiles = (M + MC - 1) / MC;
     int n_tiles = (N + NC - 1) / NC;
@@ -844,6 +906,7 @@ void fastGemmBatchKernel(size_t batch, const size_t *A_offsets, const size_t *B_
 
     auto fn = [&](const Range &r) {
         char* packed_a = (char*)(use_stackbuff ? alloca(buff_size) : malloc(buff_size));
+        float* dequant_b = (float*)(packed_a + KC * MC * esz);
         const char *packed_b = packed_B;
         int start = r.start;
         int end = r.end;
@@ -859,7 +922,8 @@ void fastGemmBatchKernel(size_t batch, const size_t *A_offsets, const size_t *B_
             int nc = N - j0 < NC ? N - j0 : NC;
             int ldc_block = ldc;
             const char *a_block = A + A_offsets[batch_index] * esz;
-            packed_b = packed_B + B_offsets[batch_index] * esz + j0 * K * esz;
+            packed_b = packed_B + (B_offsets[batch_index] + j0 * K) * esz_B;
+            const float *scales = packed_B_scales ? packed_B_scales + B_offsets[batch_index] / K + j0 : 0;
             char* c_block = C + C_offsets[batch_index] * esz + (i0 * ldc + j0) * esz;
 
             if (beta == 0.f) {
@@ -873,7 +937,8 @@ void fastGemmBatchKernel(size_t batch, const size_t *A_offsets, const size_t *B_
                 }
             }
 
-            int _nc = static_cast<int>((nc + GEMM_NR - 1) / GEMM_NR) * GEMM_NR * esz;
+            int nc_padded = static_cast<int>((nc + GEMM_NR - 1) / GEMM_NR) * GEMM_NR;
+            int _nc = nc_padded * esz_B;
             for(int k0 = 0; k0 < K; k0 += KC)
             {
                 int kc = K - k0 < KC ? K - k0 : KC;
@@ -889,9 +954,16 @@ void fastGemmBatchKernel(size_t batch, const size_t *A_offsets, const size_t *B_
 #endif
 
                 // run kernel
-                fast_gemm_macro_kernel(mc, nc, kc, packed_a, packed_b, alpha, c_block, ldc_block, esz);
+                const char *b_block = packed_b;
+                if (compressed_B) {
+                    fast_gemm_dequantize_b(kc, nc_padded, packed_b, packed_B_type, scales, dequant_b);
+                    b_block = (const char*)dequant_b;
+                }
+                fast_gemm_macro_kernel(mc, nc, kc, packed_a, b_block, alpha, c_block, ldc_block, esz);
                 packed_b += _nc * kc;
             }
+            if (epilogue)
+                fastGemmApplyEpilogue(*epilogue, (float*)c_block, (c_block - C) / esz, ldc_block, mc, j0, nc);
         }
 
         if (!use_stackbuff) {
@@ -116,6 +116,55 @@ void fastNorm(const Mat &input, const Mat &scale, const Mat &bias, Mat &output,
     parallel_for_(Range(0, loops), fn, nstripes);
 }
 
+void fastNormAdd(const Mat &input, const Mat &residual, const Mat &scale, const Mat &bias, Mat &output, float epsilon, size_t normalized_axis) {
+    const auto input_shape = shape(input);
+    CV_CheckLT(normalized_axis, input_shape.size(), "fastNormAdd: axis out of range");
+    CV_CheckEQ(residual.total(), input.total(), "fastNormAdd: residual should have the same shape as input");
+    CV_Check(bias.total(), bias.empty() || bias.total() == scale.total(), "fastNormAdd: scale and bias should have the same shape");
+
+    size_t loops = static_cast<size_t>(total(input_shape, 0, static_cast<int>(normalized_axis))),
+           norm_size = static_cast<size_t>(total(input_shape, static_cast<int>(normalized_axis)));
+    float inv_norm_size = 1.0 / norm_size;
+
+    auto fn = [&](const Range &r) {
+        const auto *input_data = input.ptr<const float>();
+        const auto *residual_data = residual.ptr<const float>();
+        const auto *scale_data = scale.ptr<const float>();
+        const auto *bias_data = bias.empty() ? 0 : bias.ptr<const float>();
+        auto *output_data = output.ptr<float>();
+        for (int i = r.start; i < r.end; i++) {
+            const auto *x = input_data + norm_size * i;
+            const auto *res = residual_data + norm_size * i;
+            auto *y = output_data + norm_size * i;
+
+            // the sum is kept in the output, the row is still in cache when it is normalized
+            float mean = 0.f, mean_square = 0.f;
+            for (size_t j = 0; j < norm_size; j++) {
+                float v = x[j] + res[j];
+                y[j] = v;
+                mean += v;
+                mean_square += v * v;
+            }
+
+            mean *= inv_norm_size;
+            mean_square = std::sqrt(std::max(0.f, mean_square * inv_norm_size - mean * mean) + epsilon);
+            float inv_stdev = 1.f / mean_square;
+
+            if (bias_data) {
+                for (size_t j = 0; j < norm_size; j++) {
+                    y[j] = scale_data[j] * (y[j] - mean) * inv_stdev + bias_data[j];
+                }
+            } else {
+                for (size_t j = 0; j < norm_size; j++) {
+                    y[j] = scale_data[j] * (y[j] - mean) * inv_stdev;
+                }
+            }
+        }
+    };
+    double nstripes = loops * norm_size * (1 / 1024.0);
+    parallel_for_(Range(0, loops), fn, nstripes);
+}
+
 void fastNormChannel(const Mat &input, const Mat &scale, const Mat &bias, Mat &output, float epsilon) {
     const auto input_shape = shape(input);
     size_t N = input_shape[0], C = input_shape[1];
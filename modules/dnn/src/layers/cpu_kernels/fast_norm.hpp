@@ -18,6 +18,10 @@ void fastNorm(const Mat &input, const Mat &scale, Mat &output, float epsilon, si
 // Normalization speedup by multi-threading with scale and bias. Mainly for LayerNormalization.
 void fastNorm(const Mat &input, const Mat &scale, const Mat &bias, Mat &output, float epsilon, size_t normalized_axis = 0);
 
+// Normalization of the sum of input and residual (both have the same shape) with scale and optional bias.
+// Mainly for the residual connection followed by LayerNormalization in transformers.
+void fastNormAdd(const Mat &input, const Mat &residual, const Mat &scale, const Mat &bias, Mat &output, float epsilon, size_t normalized_axis = 0);
+
 // Channel-wise Normalization speedup by multi-threading. Scale and bias should have the same shape (C). Input should have dimension >= 3.
 void fastNormChannel(const Mat &input, const Mat &scale, const Mat &bias, Mat &output, float epsilon);
 
@@ -51,6 +51,7 @@
 #include "../op_vkcom.hpp"
 
 #include <opencv2/dnn/shape_utils.hpp>
+#include "cpu_kernels/fast_gemm.hpp"
 
 #ifdef HAVE_OPENCL
 #include "opencl_kernels_dnn.hpp"
@@ -68,7 +69,7 @@ namespace cv
 namespace dnn
 {
 
-class FullyConnectedLayerImpl CV_FINAL : public InnerProductLayer
+class FullyConnectedLayerImpl CV_FINAL : public InnerProductLayer, public WeightsCompressionLayer
 {
 public:
     enum { VEC_ALIGN = 8 };
@@ -88,6 +89,7 @@ public:
         bias = params.get<bool>("bias_term", true);
         axis = params.get<int>("axis", 1);
         isMatMul = params.get<bool>("is_matmul", false);
+        weightsCompression = params.get<int>("weights_compression", CV_32F);
         if (!blobs.empty())
         {
             CV_Assert(1 <= blobs.size() && blobs.size() <= 2);
@@ -344,14 +346,56 @@ public:
         bool useLASX;
     };
 
-#ifdef HAVE_OPENCL
+    void setWeightsCompression(int type) CV_OVERRIDE
+    {
+        weightsCompression = type;
+    }
+
     virtual void finalize(InputArrayOfArrays, OutputArrayOfArrays) CV_OVERRIDE
     {
+#ifdef HAVE_OPENCL
         innerProductOp.release();
         umat_blobs.clear();
         half_blobs.clear();
+#endif
+
+        // the compressed weights are multiplied by fastGemm(), Y = X * W^T
+        const int weightsType = getWeightsStorageType(weightsCompression, preferableTarget);
+        bool useCompressed = weightsType != CV_32F && !blobs.empty() && !isMatMul &&
+                             preferableTarget != DNN_TARGET_OPENCL && preferableTarget != DNN_TARGET_OPENCL_FP16;
+        if (!useCompressed)
+            packedWeights.release();
+        else if (packedWeights.empty() || packedWeights.type != weightsType)
+        {
+            gemmOpt.init();
+            fastGemmPackB(weightsMat.isContinuous() ? weightsMat : weightsMat.clone(), packedWeights,
+                          true, weightsType, gemmOpt);
+        }
+    }
+
+    void forwardCompressed(const Mat& srcMat_, Mat& dstMat)
+    {
+        Mat srcMat = srcMat_.isContinuous() ? srcMat_ : srcMat_.clone();
+        int outerSize = srcMat.rows, vecsize = srcMat.cols, numOutput = dstMat.cols;
+        CV_Assert(dstMat.isContinuous() && vecsize == weightsMat.cols && numOutput == weightsMat.rows);
+
+        for (int i = 0; i < outerSize; i++)
+            biasMat.copyTo(dstMat.row(i));
+        fastGemm(false, outerSize, numOutput, vecsize, 1.f, srcMat.ptr<float>(), vecsize,
+                 packedWeights, 1.f, dstMat.ptr<float>(), numOutput, gemmOpt);
+
+        if (activ)
+        {
+            for (int i = 0; i < outerSize; i++)
+            {
+                float* dptr = dstMat.ptr<float>(i);
+                activ->forwardSlice(dptr, dptr, 1, 1, 0, numOutput);
+            }
+        }
     }
 
+#ifdef HAVE_OPENCL
+
     bool forward_ocl(InputArrayOfArrays inps, OutputArrayOfArrays outs, InputArrayOfArrays internals)
     {
         std::vector<UMat> inputs;
@@ -551,6 +595,11 @@ public:
                     Mat srcMat = input[i].reshape(1, outerSize);
                     Mat dstMat = output[i].reshape(1, outerSize);
 
+                    if (!packedWeights.empty())
+                    {
+                        forwardCompressed(srcMat, dstMat);
+                        continue;
+                    }
                     const int nstripes = getNumThreads();
                     FullyConnected::run(srcMat, weightsMat, biasMat, dstMat, activ.get(), nstripes);
                 }
@@ -941,6 +990,9 @@ public:
     bool transA, transB;
     bool isMatMul = false;
     Ptr<ActivationLayer> activ;
+    int weightsCompression;
+    FastGemmPackedB packedWeights;  // weightsMat packed with the weight-only compression
+    FastGemmOpt gemmOpt;
 };
 
 Ptr<InnerProductLayer> InnerProductLayer::create(const LayerParams& params)
@@ -20,7 +20,7 @@ using namespace cv::dnn::cuda4dnn;
 
 namespace cv { namespace dnn {
 
-class GemmLayerImpl CV_FINAL : public GemmLayer {
+class GemmLayerImpl CV_FINAL : public GemmLayer, public WeightsCompressionLayer {
 public:
     GemmLayerImpl(const LayerParams& params) {
         setParamsFrom(params);
@@ -35,6 +35,11 @@ public:
         have_bias = params.get<bool>("have_bias", false); // NOTE: have_bias being true does not mean bias is constant
 
         real_ndims_C = params.get<int>("real_ndims_C", -1);
+        weights_compression = params.get<int>("weights_compression", CV_32F);
+    }
+
+    void setWeightsCompression(int type) CV_OVERRIDE {
+        weights_compression = type;
     }
 
     virtual bool supportBackend(int backendId) CV_OVERRIDE {
@@ -146,9 +151,11 @@ public:
     virtual void finalize(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr) CV_OVERRIDE {
         opt.init();
 
-        // pack B if it is const
-        if (const_B) {
-            fastGemmPackB(blobs[0], packed_B, trans_b, opt);
+        // pack B if it is const, the packed weights don't depend on the input shapes
+        const int weights_type = getWeightsStorageType(weights_compression, preferableTarget);
+        if (const_B && (packed_B.empty() || packed_B_src.data != blobs[0].data || packed_B.type != weights_type)) {
+            fastGemmPackB(blobs[0], packed_B, trans_b, weights_type, opt);
+            packed_B_src = blobs[0];
         }
 
         // also pre-broadcast bias
@@ -208,8 +215,8 @@ public:
         }
 
         if (const_B) {
-            CV_CheckGT(packed_B.size(), static_cast<size_t>(0), "DNN/Gemm: constant B is not pre-packed");
-            fastGemm(trans_a, M, N, K, alpha, A.ptr<const float>(), na, packed_B.data(), 1.f, Y.ptr<float>(), N, opt);
+            CV_CheckFalse(packed_B.empty(), "DNN/Gemm: constant B is not pre-packed");
+            fastGemm(trans_a, M, N, K, alpha, A.ptr<const float>(), na, packed_B, 1.f, Y.ptr<float>(), N, opt);
         } else {
             fastGemmBatch(trans_a, trans_b, alpha, A, inputs[1], 1.f, Y, opt);
         }
@@ -368,9 +375,11 @@ private:
     bool const_B;
     bool const_C;
     bool have_bias;
-    std::vector<float> packed_B;
+    FastGemmPackedB packed_B;
+    Mat packed_B_src;  // blob which has been packed to packed_B
     std::vector<float> broadcast_C;
     int real_ndims_C;
+    int weights_compression;  // storage type of packed_B
     FastGemmOpt opt;
 };
 
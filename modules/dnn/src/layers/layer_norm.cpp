@@ -96,6 +96,9 @@ public:
         const auto input_shape = shape(inputs[0]);
         axis = normalize_axis(axis, static_cast<int>(input_shape.size()));
 
+        // the fusion is done again after the allocation
+        fusedAdd = false;
+
 #ifdef HAVE_OPENCL
         weight_umat.release();
         bias_umat.release();
@@ -124,6 +127,16 @@ public:
         const auto &scale = blobs.empty() ? inputs[1] : blobs.front();
         auto &output = outputs[0];
 
+        if (fusedAdd) {
+            // the residual is the last input
+            const size_t num_inputs = inputs.size() - 1 + blobs.size();
+            Mat bias;
+            if (num_inputs >= 3)
+                bias = blobs.empty() ? inputs[2] : blobs.back();
+            fastNormAdd(input, inputs.back(), scale, bias, output, epsilon, static_cast<size_t>(axis));
+            return;
+        }
+
         if ((inputs.size() + blobs.size()) >= 3) {
             const auto &bias = blobs.empty() ? inputs[2] : blobs.back();
             fastNorm(input, scale, bias, output, epsilon, static_cast<size_t>(axis));
@@ -25,7 +25,7 @@ using namespace cv::dnn::cuda4dnn;
 
 namespace cv { namespace dnn {
 
-class MatMulLayerImpl CV_FINAL : public MatMulLayer {
+class MatMulLayerImpl CV_FINAL : public MatMulLayer, public WeightsCompressionLayer {
 #ifdef HAVE_OPENCL
     UMat weight_umat, bias_umat;
 #endif
@@ -40,6 +40,24 @@ class MatMulLayerImpl CV_FINAL : public MatMulLayer {
         beta = params.get<float>("beta", 1.f);
 
         real_ndims_C = params.get<int>("real_ndims_C", -1);
+        weights_compression = params.get<int>("weights_compression", CV_32F);
+    }
+
+    void setWeightsCompression(int type) CV_OVERRIDE {
+        weights_compression = type;
+    }
+
+    virtual bool setActivation(const Ptr<ActivationLayer>& layer) CV_OVERRIDE {
+        // the activation is applied to the rows of the output in the epilogue of the GEMM with
+        // the packed (constant) B, so it must not depend on the channel
+        if (blobs.empty() || !IS_DNN_CPU_TARGET(preferableTarget) || fusedAdd ||
+            !layer.dynamicCast<ChannelsPReLULayer>().empty() || !layer.dynamicCast<BatchNormLayer>().empty())
+            return false;
+        if (activ.empty() || layer.empty()) {
+            activ = layer;
+            return !activ.empty();
+        }
+        return false;
     }
 
     virtual bool supportBackend(int backendId) CV_OVERRIDE {
@@ -121,6 +139,10 @@ class MatMulLayerImpl CV_FINAL : public MatMulLayer {
     virtual void finalize(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr) CV_OVERRIDE {
         opt.init();
 
+        // the fusion is done again after the allocation
+        activ.release();
+        fusedAdd = false;
+
         std::vector<Mat> inputs, outputs;
         inputs_arr.getMatVector(inputs);
         outputs_arr.getMatVector(outputs);
@@ -131,8 +153,14 @@ class MatMulLayerImpl CV_FINAL : public MatMulLayer {
         helper.compute(trans_a, trans_b, A_shape, B_shape, C_shape);
 
         if (!blobs.empty()) {
-            fastGemmPackB(blobs[0], packed_input_B, trans_b, opt);
-            helper.updatePackedBOffsets(packed_input_B.size());
+            // the packed weights don't depend on the input shapes
+            const int weights_type = getWeightsStorageType(weights_compression, preferableTarget);
+            if (packed_input_B.empty() || packed_input_B_src.data != blobs[0].data ||
+                packed_input_B.type != weights_type) {
+                fastGemmPackB(blobs[0], packed_input_B, trans_b, weights_type, opt);
+                packed_input_B_src = blobs[0];
+            }
+            helper.updatePackedBOffsets(packed_input_B.total());
         }
 
         // broadcast bias if needed
@@ -168,6 +196,17 @@ class MatMulLayerImpl CV_FINAL : public MatMulLayer {
             }
         }
 
+        // the bias along the last axis is added in the epilogue of the GEMM,
+        // there is no need to initialize the output with the broadcasted bias
+        bias_row.release();
+        if (blobs.size() >= 2 && inputs.size() == 1) {
+            const auto &bias_mat = blobs.back();
+            const int N = C_shape.back();
+            if (bias_mat.total() == static_cast<size_t>(N) && (real_ndims_C == 1 || shape(bias_mat).back() == N)) {
+                bias_mat.reshape(1, 1).convertTo(bias_row, CV_32F, beta);
+            }
+        }
+
 #ifdef HAVE_OPENCL
         weight_umat.release();
         bias_umat.release();
@@ -197,6 +236,19 @@ class MatMulLayerImpl CV_FINAL : public MatMulLayer {
 
         const auto *a = A.ptr<const float>();
         auto *y = Y.ptr<float>();
+
+        if (!blobs.empty() && (!bias_row.empty() || activ || fusedAdd)) {
+            // bias, activation and residual are applied to the blocks of the output while they are in cache
+            FastGemmEpilogue epilogue;
+            epilogue.bias = bias_row.empty() ? 0 : bias_row.ptr<const float>();
+            epilogue.residual = fusedAdd ? inputs.back().ptr<const float>() : 0;
+            epilogue.activ = activ.get();
+            fastGemmBatch(helper.batch, helper.A_offsets.data(), helper.packed_B_offsets.data(), helper.C_offsets.data(),
+                          helper.M, helper.N, helper.K, alpha, a, helper.lda0, helper.lda1,
+                          packed_input_B, 0.f, y, helper.ldc, opt, &epilogue);
+            return;
+        }
+
         // add bias if existed
         if ((inputs.size() + blobs.size()) >= 3) {
             const auto &shape_Y = shape(Y);
@@ -239,10 +291,22 @@ class MatMulLayerImpl CV_FINAL : public MatMulLayer {
         } else {
             fastGemmBatch(helper.batch, helper.A_offsets.data(), helper.packed_B_offsets.data(), helper.C_offsets.data(),
                           helper.M, helper.N, helper.K, alpha, a, helper.lda0, helper.lda1,
-                          packed_input_B.data(), beta, y, helper.ldc, opt);
+                          packed_input_B, beta, y, helper.ldc, opt);
         }
     }
 
+    String getKernelName() const CV_OVERRIDE {
+        if (!IS_DNN_CPU_TARGET(preferableTarget))
+            return String();
+        if (blobs.empty())
+            return "gemm";
+        String name = packed_input_B.type == CV_16F ? "gemm_packed_fp16" :
+                      packed_input_B.type == CV_8S ? "gemm_packed_int8" : "gemm_packed";
+        if (!bias_row.empty() || activ || fusedAdd)
+            name += "_epilogue";
+        return name;
+    }
+
 #ifdef HAVE_OPENCL
     bool forward_ocl(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, InputArrayOfArrays internals) {
         std::vector<UMat> inputs;
@@ -471,8 +535,12 @@ class MatMulLayerImpl CV_FINAL : public MatMulLayer {
 
     int real_ndims_C;
 
-    std::vector<float> packed_input_B;
+    FastGemmPackedB packed_input_B;
+    Mat packed_input_B_src;  // blob which has been packed to packed_input_B
+    int weights_compression;  // storage type of packed_input_B
     Mat broadcast_bias;
+    Mat bias_row;  // [1, N], the bias which is added in the GEMM epilogue
+    Ptr<ActivationLayer> activ;
 
     FastGemmOpt opt;
     MatMulHelper helper;
@@ -51,6 +51,7 @@ using namespace cv::dnn::cuda4dnn;
 #endif
 
 #include "layers_common.hpp"
+#include "cpu_kernels/fast_gemm.hpp"
 
 namespace cv
 {
@@ -105,6 +106,68 @@ static ActivationFunction get_activation_function(const String& activation) {
     }
 }
 
+// LSTM cell with the default activations fused into the epilogue of the recurrent GEMM.
+// gates contain x_t * Wx^T + h_{t-1} * Wh^T for the I, F, O and G gates,
+// hState and cState (numSamples x numOut) are updated in place and copied to the outputs.
+static void lstmCellForward(int numSamples, int numOut, const float* gates, size_t gatesStep,
+                            const float* bias, float forgetBias, bool useCellClip, float cellClip,
+                            float* hState, float* cState,
+                            float* hOut, size_t hOutStep, float* cOut, size_t cOutStep)
+{
+    for (int n = 0; n < numSamples; n++)
+    {
+        const float* gateI = gates + n * gatesStep;
+        const float* gateF = gateI + numOut;
+        const float* gateO = gateF + numOut;
+        const float* gateG = gateO + numOut;
+        const float* biasI = bias;
+        const float* biasF = biasI + numOut;
+        const float* biasO = biasF + numOut;
+        const float* biasG = biasO + numOut;
+        float* h = hState + n * numOut;
+        float* c = cState + n * numOut;
+        for (int j = 0; j < numOut; j++)
+        {
+            float i_t = 1.f / (1.f + std::exp(-(gateI[j] + biasI[j])));
+            float f_t = 1.f / (1.f + std::exp(-(gateF[j] + biasF[j] + forgetBias)));
+            float o_t = 1.f / (1.f + std::exp(-(gateO[j] + biasO[j])));
+            float g_t = std::tanh(gateG[j] + biasG[j]);
+            float c_t = f_t * c[j] + i_t * g_t;
+            if (useCellClip)
+                c_t = std::max(std::min(c_t, cellClip), -cellClip);
+            c[j] = c_t;
+            h[j] = o_t * std::tanh(c_t);
+        }
+        memcpy(hOut + n * hOutStep, h, numOut * sizeof(float));
+        if (cOut)
+            memcpy(cOut + n * cOutStep, c, numOut * sizeof(float));
+    }
+}
+
+// GRU cell fused into the epilogue of the recurrent GEMM.
+// gatesX contain x_t * Wx^T and gatesH contain h_{t-1} * Wh^T for the z, r and n gates,
+// hState (numSamples x numOut) is updated in place and copied to the output.
+static void gruCellForward(int numSamples, int numOut, const float* gatesX, size_t gatesXStep,
+                           const float* gatesH, const float* bx, const float* bh,
+                           float* hState, float* hOut, size_t hOutStep)
+{
+    for (int n = 0; n < numSamples; n++)
+    {
+        const float* x = gatesX + n * gatesXStep;
+        const float* hp = gatesH + n * 3 * numOut;
+        float* h = hState + n * numOut;
+        for (int j = 0; j < numOut; j++)
+        {
+            const int r = numOut + j, k = 2 * numOut + j;
+            float z_t = 1.f / (1.f + std::exp(-(x[j] + bx[j] + hp[j] + bh[j])));
+            float r_t = 1.f / (1.f + std::exp(-(x[r] + bx[r] + hp[r] + bh[r])));
+            float n_t = std::tanh(x[k] + bx[k] + r_t * (hp[k] + bh[k]));
+            h[j] = z_t * h[j] + (1.f - z_t) * n_t;
+        }
+        memcpy(hOut + n * hOutStep, h, numOut * sizeof(float));
+    }
+}
+
 class LSTMLayerImpl CV_FINAL : public LSTMLayer
 {
     int numTimeStamps, numSamples, numHidden;
@@ -143,6 +206,17 @@ class LSTMLayerImpl CV_FINAL : public LSTMLayer
     // in ONNXImporter are destructive, so we keep a copy.
     std::vector<Mat> originalBlobs;
 
+    // Weights prepacked for the fast path: Wx of both directions as a single matrix,
+    // so the input projections of all timestamps are computed with one GEMM, and Wh per direction.
+    std::vector<float> packedWx, packedWh;
+    FastGemmOpt opt;
+
+    bool useFastPath() const
+    {
+        return isDefaultActivations && !usePeephole && blobs.size() >= 2
+               && blobs[0].type() == CV_32F && blobs[0].isContinuous() && blobs[1].isContinuous();
+    }
+
 public:
 
     LSTMLayerImpl(const LayerParams& params)
@@ -337,6 +411,14 @@ public:
         internals.push_back(shape(_numSamples, _numOut)); // cInternal
         internals.push_back(shape(_numSamples, 1)); // dummyOnes
         internals.push_back(shape(_numSamples, 4*_numOut)); // gates
+        if (useFastPath())
+        {
+            const int numDirs = 1 + static_cast<int>(bidirectional);
+            int _numTimeStamps = !useTimestampDim ? 1 : layout == SEQ_BATCH_HID ? inp0[0] : inp0[1];
+            internals.push_back(shape(_numTimeStamps*_numSamples, numDirs*4*_numOut)); // gates of all timestamps
+            internals.push_back(shape(numDirs*_numSamples, _numOut)); // hidden states of the directions
+            internals.push_back(shape(numDirs*_numSamples, _numOut)); // cell states of the directions
+        }
 
         return false;
     }
@@ -382,9 +464,82 @@ public:
         outTsShape.insert(outTsShape.end(), outTailShape.begin(), outTailShape.end());
         outTsShape.back() *= (1 + static_cast<int>(bidirectional));
 
+        if (useFastPath())
+        {
+            const int numDirs = 1 + static_cast<int>(bidirectional);
+            opt.init();
+            fastGemmPackB(Wx, packedWx, true, opt);
+            int shp[] = {numDirs, Wh.rows / numDirs, Wh.cols};
+            fastGemmPackB(Wh.reshape(1, 3, shp), packedWh, true, opt);
+        }
+
         allocated = true;
     }
 
+    void forwardFast(const std::vector<Mat>& input, Mat& output, Mat& cOut, std::vector<Mat>& internals)
+    {
+        const int numDirs = 1 + static_cast<int>(bidirectional);
+        const int numOut = blobs[0].cols, numInp = blobs[1].cols;
+        const int numGates = 4 * numOut;
+        const int numSamplesTotal = numTimeStamps * numSamples;
+
+        Mat xTs = input[0].reshape(1, numSamplesTotal);
+        CV_Assert(xTs.isContinuous());
+        Mat gatesTs = internals[4], hStates = internals[5], cStates = internals[6];
+
+        Mat h_0 = (input.size() >= 2) ? input[1].reshape(1, input[1].size[0] * input[1].size[1]) : blobs[3];
+        Mat c_0 = (input.size() == 3) ? input[2].reshape(1, input[2].size[0] * input[2].size[1]) : blobs[4];
+        CV_CheckEQ(h_0.rows, numDirs * numSamples, "");
+        CV_CheckEQ(c_0.rows, numDirs * numSamples, "");
+        CV_CheckEQ(h_0.cols, numOut, "");
+        CV_CheckEQ(c_0.cols, numOut, "");
+        h_0.copyTo(hStates);
+        c_0.copyTo(cStates);
+
+        // input projections of all timestamps and both directions with a single GEMM
+        float* gates = gatesTs.ptr<float>();
+        const int ldg = numDirs * numGates;
+        fastGemm(false, numSamplesTotal, ldg, numInp, 1.f, xTs.ptr<float>(), numInp,
+                 packedWx.data(), 0.f, gates, ldg, opt);
+
+        Mat hOutTs = output.reshape(1, numSamplesTotal);
+        Mat cOutTs = produceCellOutput ? cOut.reshape(1, numSamplesTotal) : Mat();
+        const size_t packedWhSize = fastGemmPackBSize(numGates, numOut, opt);
+
+        auto runDirection = [&](int d, FastGemmOpt& dirOpt)
+        {
+            const float* bias = blobs[2].ptr<float>() + d * numGates;
+            float* h = hStates.ptr<float>(d * numSamples);
+            float* c = cStates.ptr<float>(d * numSamples);
+            const float* Wh = packedWh.data() + d * packedWhSize;
+            const bool backward = reverse || d == 1;
+            for (int k = 0; k < numTimeStamps; k++)
+            {
+                int ts = backward ? numTimeStamps - 1 - k : k;
+                float* gates_t = gates + (size_t)ts * numSamples * ldg + d * numGates;
+                fastGemm(false, numSamples, numGates, numOut, 1.f, h, numOut, Wh, 1.f, gates_t, ldg, dirOpt);
+                lstmCellForward(numSamples, numOut, gates_t, ldg, bias, forgetBias, useCellClip, cellClip, h, c,
+                                hOutTs.ptr<float>(ts * numSamples) + d * numOut, hOutTs.step1(),
+                                produceCellOutput ? cOutTs.ptr<float>(ts * numSamples) + d * numOut : 0,
+                                produceCellOutput ? cOutTs.step1() : 0);
+            }
+        };
+
+        if (numDirs == 1)
+            runDirection(0, opt);
+        else
+        {
+            // the directions are independent, each of them runs the recurrent GEMMs in a single thread
+            parallel_for_(Range(0, numDirs), [&](const Range& r)
+            {
+                FastGemmOpt dirOpt = opt;
+                dirOpt.multi_thread = false;
+                for (int d = r.start; d < r.end; d++)
+                    runDirection(d, dirOpt);
+            });
+        }
+    }
+
     void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
     {
         CV_TRACE_FUNCTION();
@@ -419,217 +574,224 @@ public:
         Mat cOut = produceCellOutput ? output[0].clone() : Mat();
         const bool needYcTransform = !originalBlobs.empty(); // if the producer is onnx
         const int numDirs = 1 + static_cast<int>(bidirectional);
-        for (int i = 0; i < numDirs; ++i)
+        if (useFastPath())
         {
-            Mat Wh = blobs[0];
-            Mat Wx = blobs[1];
-            Mat bias = blobs[2];
-
-            Mat h_0, c_0;
-            // Handle h_0 and c_0 based on input size
-            h_0 = (input.size() >= 2) ? input[1].reshape(1, input[1].size[0] * input[1].size[1]) : blobs[3];
-            c_0 = (input.size() == 3) ? input[2].reshape(1, input[2].size[0] * input[2].size[1]) : blobs[4];
-
-            // Perform checks if input size is 2 or 3
-            if (input.size() >= 2) {
-                CV_CheckEQ(h_0.cols, Wh.cols, "");
-                CV_CheckEQ(h_0.cols, c_0.cols, "");
-                CV_CheckEQ(h_0.rows, c_0.rows, "");
-            }
-
-
-            Mat pI, pF, pO;
-
-            Wh = Wh.rowRange(i * Wh.rows / numDirs, (i + 1) * Wh.rows / numDirs);
-            Wx = Wx.rowRange(i * Wx.rows / numDirs, (i + 1) * Wx.rows / numDirs);
-            bias = bias.colRange(i * bias.cols / numDirs, (i + 1) * bias.cols / numDirs);
-            h_0 = h_0.rowRange(i * h_0.rows / numDirs, (i + 1) * h_0.rows / numDirs);
-            c_0 = c_0.rowRange(i * c_0.rows / numDirs, (i + 1) * c_0.rows / numDirs);
-
-            if (usePeephole)
+            forwardFast(input, output[0], cOut, internals);
+        }
+        else
+        {
+            for (int i = 0; i < numDirs; ++i)
             {
-                pI = blobs[5];
-                pF = blobs[6];
-                pO = blobs[7];
+                Mat Wh = blobs[0];
+                Mat Wx = blobs[1];
+                Mat bias = blobs[2];
+
+                Mat h_0, c_0;
+                // Handle h_0 and c_0 based on input size
+                h_0 = (input.size() >= 2) ? input[1].reshape(1, input[1].size[0] * input[1].size[1]) : blobs[3];
+                c_0 = (input.size() == 3) ? input[2].reshape(1, input[2].size[0] * input[2].size[1]) : blobs[4];
+
+                // Perform checks if input size is 2 or 3
+                if (input.size() >= 2) {
+                    CV_CheckEQ(h_0.cols, Wh.cols, "");
+                    CV_CheckEQ(h_0.cols, c_0.cols, "");
+                    CV_CheckEQ(h_0.rows, c_0.rows, "");
+                }
 
-                pI = pI.rowRange(i * pI.rows / numDirs, (i + 1) * pI.rows / numDirs);
-                pI = pI.colRange(i * pI.cols / numDirs, (i + 1) * pI.cols / numDirs);
 
-                pF = pF.rowRange(i * pF.rows / numDirs, (i + 1) * pF.rows / numDirs);
-                pF = pF.colRange(i * pF.cols / numDirs, (i + 1) * pF.cols / numDirs);
+                Mat pI, pF, pO;
 
-                pO = pO.rowRange(i * pO.rows / numDirs, (i + 1) * pO.rows / numDirs);
-                pO = pO.colRange(i * pO.cols / numDirs, (i + 1) * pO.cols / numDirs);
-            }
+                Wh = Wh.rowRange(i * Wh.rows / numDirs, (i + 1) * Wh.rows / numDirs);
+                Wx = Wx.rowRange(i * Wx.rows / numDirs, (i + 1) * Wx.rows / numDirs);
+                bias = bias.colRange(i * bias.cols / numDirs, (i + 1) * bias.cols / numDirs);
+                h_0 = h_0.rowRange(i * h_0.rows / numDirs, (i + 1) * h_0.rows / numDirs);
+                c_0 = c_0.rowRange(i * c_0.rows / numDirs, (i + 1) * c_0.rows / numDirs);
 
-            int numOut = Wh.size[1];
-            Mat hInternal = internals[0], cInternal = internals[1],
-                    dummyOnes = internals[2], gates = internals[3];
-            h_0.copyTo(hInternal);
-            c_0.copyTo(cInternal);
-            dummyOnes.setTo(1.);
+                if (usePeephole)
+                {
+                    pI = blobs[5];
+                    pF = blobs[6];
+                    pO = blobs[7];
 
-            int numSamplesTotal = numTimeStamps*numSamples;
-            Mat xTs = input[0].reshape(1, numSamplesTotal);
+                    pI = pI.rowRange(i * pI.rows / numDirs, (i + 1) * pI.rows / numDirs);
+                    pI = pI.colRange(i * pI.cols / numDirs, (i + 1) * pI.cols / numDirs);
 
-            Mat hOutTs = output[0].reshape(1, numSamplesTotal);
-            hOutTs = hOutTs.colRange(i * hOutTs.cols / numDirs, (i + 1) * hOutTs.cols / numDirs);
-            Mat cOutTs;
-            if (produceCellOutput)
-            {
-                cOutTs = cOut.reshape(1, numSamplesTotal);
-                cOutTs = cOutTs.colRange(i * cOutTs.cols / numDirs, (i + 1) * cOutTs.cols / numDirs);
-            }
+                    pF = pF.rowRange(i * pF.rows / numDirs, (i + 1) * pF.rows / numDirs);
+                    pF = pF.colRange(i * pF.cols / numDirs, (i + 1) * pF.cols / numDirs);
 
-#if CV_TRY_AVX2 || CV_TRY_AVX
-            bool canUseAvx = gates.isContinuous() && bias.isContinuous()
-                && Wx.depth() == CV_32F && gates.depth() == CV_32F
-                && bias.depth() == CV_32F && Wx.cols >= 8;
-            bool canUseAvx_hInternal = hInternal.isContinuous() && gates.isContinuous() && bias.isContinuous()
-                && Wh.depth() == CV_32F && hInternal.depth() == CV_32F && gates.depth() == CV_32F
-                && Wh.cols >= 8;
-#endif
+                    pO = pO.rowRange(i * pO.rows / numDirs, (i + 1) * pO.rows / numDirs);
+                    pO = pO.colRange(i * pO.cols / numDirs, (i + 1) * pO.cols / numDirs);
+                }
 
-            int tsStart, tsEnd, tsInc;
-            if (reverse || i == 1) {
-                tsStart = numTimeStamps - 1;
-                tsEnd = -1;
-                tsInc = -1;
-            }
-            else {
-                tsStart = 0;
-                tsEnd = numTimeStamps;
-                tsInc = 1;
-            }
-            for (int ts = tsStart; ts != tsEnd; ts += tsInc)
-            {
-                Range curRowRange(ts*numSamples, (ts + 1)*numSamples);
-                Mat xCurr = xTs.rowRange(curRowRange);
+                int numOut = Wh.size[1];
+                Mat hInternal = internals[0], cInternal = internals[1],
+                        dummyOnes = internals[2], gates = internals[3];
+                h_0.copyTo(hInternal);
+                c_0.copyTo(cInternal);
+                dummyOnes.setTo(1.);
 
-#if CV_TRY_AVX2
-                if (useAVX2 && canUseAvx && xCurr.isContinuous())
+                int numSamplesTotal = numTimeStamps*numSamples;
+                Mat xTs = input[0].reshape(1, numSamplesTotal);
+
+                Mat hOutTs = output[0].reshape(1, numSamplesTotal);
+                hOutTs = hOutTs.colRange(i * hOutTs.cols / numDirs, (i + 1) * hOutTs.cols / numDirs);
+                Mat cOutTs;
+                if (produceCellOutput)
                 {
-                    for (int n = 0; n < xCurr.rows; n++) {
-                        opt_AVX2::fastGEMM1T(
-                            xCurr.ptr<float>(n),
-                            Wx.ptr<float>(),
-                            Wx.step1(),
-                            bias.ptr<float>(),
-                            gates.ptr<float>(n),
-                            Wx.rows,
-                            Wx.cols
-                        );
-                    }
+                    cOutTs = cOut.reshape(1, numSamplesTotal);
+                    cOutTs = cOutTs.colRange(i * cOutTs.cols / numDirs, (i + 1) * cOutTs.cols / numDirs);
                 }
-                else
-#endif
-#if CV_TRY_AVX
-                if (useAVX && canUseAvx && xCurr.isContinuous())
-                {
-                    for (int n = 0; n < xCurr.rows; n++) {
-                        opt_AVX::fastGEMM1T(
-                            xCurr.ptr<float>(n),
-                            Wx.ptr<float>(),
-                            Wx.step1(),
-                            bias.ptr<float>(),
-                            gates.ptr<float>(n),
-                            Wx.rows,
-                            Wx.cols
-                        );
-                    }
+
+    #if CV_TRY_AVX2 || CV_TRY_AVX
+                bool canUseAvx = gates.isContinuous() && bias.isContinuous()
+                    && Wx.depth() == CV_32F && gates.depth() == CV_32F
+                    && bias.depth() == CV_32F && Wx.cols >= 8;
+                bool canUseAvx_hInternal = hInternal.isContinuous() && gates.isContinuous() && bias.isContinuous()
+                    && Wh.depth() == CV_32F && hInternal.depth() == CV_32F && gates.depth() == CV_32F
+                    && Wh.cols >= 8;
+    #endif
+
+                int tsStart, tsEnd, tsInc;
+                if (reverse || i == 1) {
+                    tsStart = numTimeStamps - 1;
+                    tsEnd = -1;
+                    tsInc = -1;
                 }
-                else
-#endif
-                {
-                    gemm(xCurr, Wx, 1, gates, 0, gates, GEMM_2_T);      // Wx * x_t
-                    gemm(dummyOnes, bias, 1, gates, 1, gates);          //+b
+                else {
+                    tsStart = 0;
+                    tsEnd = numTimeStamps;
+                    tsInc = 1;
                 }
-
-#if CV_TRY_AVX2
-                if (useAVX2 && canUseAvx_hInternal)
+                for (int ts = tsStart; ts != tsEnd; ts += tsInc)
                 {
-                    for (int n = 0; n < hInternal.rows; n++) {
-                        opt_AVX2::fastGEMM1T(
-                            hInternal.ptr<float>(n),
-                            Wh.ptr<float>(),
-                            Wh.step1(),
-                            gates.ptr<float>(n),
-                            gates.ptr<float>(n),
-                            Wh.rows,
-                            Wh.cols
-                        );
+                    Range curRowRange(ts*numSamples, (ts + 1)*numSamples);
+                    Mat xCurr = xTs.rowRange(curRowRange);
+
+    #if CV_TRY_AVX2
+                    if (useAVX2 && canUseAvx && xCurr.isContinuous())
+                    {
+                        for (int n = 0; n < xCurr.rows; n++) {
+                            opt_AVX2::fastGEMM1T(
+                                xCurr.ptr<float>(n),
+                                Wx.ptr<float>(),
+                                Wx.step1(),
+                                bias.ptr<float>(),
+                                gates.ptr<float>(n),
+                                Wx.rows,
+                                Wx.cols
+                            );
+                        }
                     }
-                }
-                else
-#endif
-#if CV_TRY_AVX
-                if (useAVX && canUseAvx_hInternal)
-                {
-                    for (int n = 0; n < hInternal.rows; n++) {
-                        opt_AVX::fastGEMM1T(
-                            hInternal.ptr<float>(n),
-                            Wh.ptr<float>(),
-                            Wh.step1(),
-                            gates.ptr<float>(n),
-                            gates.ptr<float>(n),
-                            Wh.rows,
-                            Wh.cols
-                        );
+                    else
+    #endif
+    #if CV_TRY_AVX
+                    if (useAVX && canUseAvx && xCurr.isContinuous())
+                    {
+                        for (int n = 0; n < xCurr.rows; n++) {
+                            opt_AVX::fastGEMM1T(
+                                xCurr.ptr<float>(n),
+                                Wx.ptr<float>(),
+                                Wx.step1(),
+                                bias.ptr<float>(),
+                                gates.ptr<float>(n),
+                                Wx.rows,
+                                Wx.cols
+                            );
+                        }
+                    }
+                    else
+    #endif
+                    {
+                        gemm(xCurr, Wx, 1, gates, 0, gates, GEMM_2_T);      // Wx * x_t
+                        gemm(dummyOnes, bias, 1, gates, 1, gates);          //+b
                     }
-                }
-                else
-#endif
-                {
-                    gemm(hInternal, Wh, 1, gates, 1, gates, GEMM_2_T);  //+Wh * h_{t-1}
-                }
 
-                Mat gateI = gates.colRange(0*numOut, 1*numOut);
-                Mat gateF = gates.colRange(1*numOut, 2*numOut);
-                Mat gateO = gates.colRange(2*numOut, 3*numOut);
-                Mat gateG = gates.colRange(3*numOut, 4*numOut);
+    #if CV_TRY_AVX2
+                    if (useAVX2 && canUseAvx_hInternal)
+                    {
+                        for (int n = 0; n < hInternal.rows; n++) {
+                            opt_AVX2::fastGEMM1T(
+                                hInternal.ptr<float>(n),
+                                Wh.ptr<float>(),
+                                Wh.step1(),
+                                gates.ptr<float>(n),
+                                gates.ptr<float>(n),
+                                Wh.rows,
+                                Wh.cols
+                            );
+                        }
+                    }
+                    else
+    #endif
+    #if CV_TRY_AVX
+                    if (useAVX && canUseAvx_hInternal)
+                    {
+                        for (int n = 0; n < hInternal.rows; n++) {
+                            opt_AVX::fastGEMM1T(
+                                hInternal.ptr<float>(n),
+                                Wh.ptr<float>(),
+                                Wh.step1(),
+                                gates.ptr<float>(n),
+                                gates.ptr<float>(n),
+                                Wh.rows,
+                                Wh.cols
+                            );
+                        }
+                    }
+                    else
+    #endif
+                    {
+                        gemm(hInternal, Wh, 1, gates, 1, gates, GEMM_2_T);  //+Wh * h_{t-1}
+                    }
 
-                if (forgetBias)
-                    add(gateF, forgetBias, gateF);
+                    Mat gateI = gates.colRange(0*numOut, 1*numOut);
+                    Mat gateF = gates.colRange(1*numOut, 2*numOut);
+                    Mat gateO = gates.colRange(2*numOut, 3*numOut);
+                    Mat gateG = gates.colRange(3*numOut, 4*numOut);
 
-                if (usePeephole)
-                {
-                    Mat gatesIF = gates.colRange(0, 2*numOut);
-                    gemm(cInternal, pI, 1, gateI, 1, gateI);
-                    gemm(cInternal, pF, 1, gateF, 1, gateF);
-                    f_activation(gatesIF, gatesIF);
-                }
-                else
-                {
-                    Mat gatesIFO = gates.colRange(0, 3*numOut);
-                    f_activation(gatesIFO, gatesIFO);
-                }
+                    if (forgetBias)
+                        add(gateF, forgetBias, gateF);
 
-                g_activation(gateG, gateG);
+                    if (usePeephole)
+                    {
+                        Mat gatesIF = gates.colRange(0, 2*numOut);
+                        gemm(cInternal, pI, 1, gateI, 1, gateI);
+                        gemm(cInternal, pF, 1, gateF, 1, gateF);
+                        f_activation(gatesIF, gatesIF);
+                    }
+                    else
+                    {
+                        Mat gatesIFO = gates.colRange(0, 3*numOut);
+                        f_activation(gatesIFO, gatesIFO);
+                    }
 
-                //compute c_t
-                multiply(gateF, cInternal, gateF);  // f_t (*) c_{t-1}
-                multiply(gateI, gateG, gateI);      // i_t (*) g_t
-                add(gateF, gateI, cInternal);       // c_t = f_t (*) c_{t-1} + i_t (*) g_t
+                    g_activation(gateG, gateG);
 
-                if (useCellClip)
-                {
-                    min(cInternal, cellClip, cInternal);
-                    max(cInternal, -cellClip, cInternal);
-                }
-                if (usePeephole)
-                {
-                    gemm(cInternal, pO, 1, gateO, 1, gateO);
-                    f_activation(gateO, gateO);
-                }
+                    //compute c_t
+                    multiply(gateF, cInternal, gateF);  // f_t (*) c_{t-1}
+                    multiply(gateI, gateG, gateI);      // i_t (*) g_t
+                    add(gateF, gateI, cInternal);       // c_t = f_t (*) c_{t-1} + i_t (*) g_t
 
-                //compute h_t
-                h_activation(cInternal, hInternal);
-                multiply(gateO, hInternal, hInternal);
+                    if (useCellClip)
+                    {
+                        min(cInternal, cellClip, cInternal);
+                        max(cInternal, -cellClip, cInternal);
+                    }
+                    if (usePeephole)
+                    {
+                        gemm(cInternal, pO, 1, gateO, 1, gateO);
+                        f_activation(gateO, gateO);
+                    }
 
-                //save results in output blobs
-                hInternal.copyTo(hOutTs.rowRange(curRowRange));
-                if (produceCellOutput)
-                    cInternal.copyTo(cOutTs.rowRange(curRowRange));
+                    //compute h_t
+                    h_activation(cInternal, hInternal);
+                    multiply(gateO, hInternal, hInternal);
+
+                    //save results in output blobs
+                    hInternal.copyTo(hOutTs.rowRange(curRowRange));
+                    if (produceCellOutput)
+                        cInternal.copyTo(cOutTs.rowRange(curRowRange));
+                }
             }
         }
         // transpose to match batch first output
@@ -962,6 +1124,15 @@ class GRULayerImpl CV_FINAL : public GRULayer
     MatShape outTsShape;    //shape of N output samples
     bool bidirectional;     // If true, produces both forward and reversed directions along time axis
 
+    // Weights prepacked for the fast path (see LSTMLayerImpl)
+    std::vector<float> packedWx, packedWh;
+    FastGemmOpt opt;
+
+    bool useFastPath() const
+    {
+        return blobs.size() >= 4 && blobs[0].type() == CV_32F && blobs[0].isContinuous() && blobs[1].isContinuous();
+    }
+
 public:
 
     GRULayerImpl(const LayerParams& params) : numTimeStamps(0), numSamples(0)
@@ -1028,6 +1199,13 @@ public:
         internals.push_back(shape(_numSamples, 2 * _numOut)); // gates_b
         internals.push_back(shape(_numSamples, 1 * _numOut)); // h_linear
         internals.push_back(shape(_numSamples, _numOut));     // ones
+        if (useFastPath())
+        {
+            const int numDirs = 1 + static_cast<int>(bidirectional);
+            internals.push_back(shape(inp0[0] * _numSamples, numDirs * 3 * _numOut)); // input projections of all timestamps
+            internals.push_back(shape(numDirs * _numSamples, _numOut));               // hidden states of the directions
+            internals.push_back(shape(numDirs * _numSamples, 3 * _numOut));           // recurrent projections
+        }
 
         return false;
     }
@@ -1058,9 +1236,74 @@ public:
         outTsShape.insert(outTsShape.end(), outTailShape.begin(), outTailShape.end());
         outTsShape.back() *= (1 + static_cast<int>(bidirectional));
 
+        if (useFastPath())
+        {
+            const int numDirs = 1 + static_cast<int>(bidirectional);
+            opt.init();
+            fastGemmPackB(Wx, packedWx, true, opt);
+            int shp[] = {numDirs, Wh.rows / numDirs, Wh.cols};
+            fastGemmPackB(Wh.reshape(1, 3, shp), packedWh, true, opt);
+        }
+
         allocated = true;
     }
 
+    void forwardFast(const Mat& input, Mat& output, std::vector<Mat>& internals)
+    {
+        const int numDirs = 1 + static_cast<int>(bidirectional);
+        const int numOut = blobs[0].cols, numInp = blobs[1].cols;
+        const int numGates = 3 * numOut;
+        const int numSamplesTotal = numTimeStamps * numSamples;
+
+        Mat xTs = input.reshape(1, numSamplesTotal);
+        CV_Assert(xTs.isContinuous());
+        Mat gatesTs = internals[6], hStates = internals[7], gatesH = internals[8];
+
+        const Mat& h_0 = blobs[3];
+        CV_CheckEQ(h_0.rows, numDirs * numSamples, "");
+        h_0.copyTo(hStates);
+
+        // input projections of all timestamps and both directions with a single GEMM
+        float* gates = gatesTs.ptr<float>();
+        const int ldg = numDirs * numGates;
+        fastGemm(false, numSamplesTotal, ldg, numInp, 1.f, xTs.ptr<float>(), numInp,
+                 packedWx.data(), 0.f, gates, ldg, opt);
+
+        Mat hOutTs = output.reshape(1, numSamplesTotal);
+        const size_t packedWhSize = fastGemmPackBSize(numGates, numOut, opt);
+
+        auto runDirection = [&](int d, FastGemmOpt& dirOpt)
+        {
+            const float* bx = blobs[2].ptr<float>() + d * 2 * numGates;
+            const float* bh = bx + numGates;
+            float* h = hStates.ptr<float>(d * numSamples);
+            float* hProj = gatesH.ptr<float>(d * numSamples);
+            const float* Wh = packedWh.data() + d * packedWhSize;
+            for (int k = 0; k < numTimeStamps; k++)
+            {
+                int ts = d == 1 ? numTimeStamps - 1 - k : k;
+                const float* gates_t = gates + (size_t)ts * numSamples * ldg + d * numGates;
+                fastGemm(false, numSamples, numGates, numOut, 1.f, h, numOut, Wh, 0.f, hProj, numGates, dirOpt);
+                gruCellForward(numSamples, numOut, gates_t, ldg, hProj, bx, bh, h,
+                               hOutTs.ptr<float>(ts * numSamples) + d * numOut, hOutTs.step1());
+            }
+        };
+
+        if (numDirs == 1)
+            runDirection(0, opt);
+        else
+        {
+            // the directions are independent, each of them runs the recurrent GEMMs in a single thread
+            parallel_for_(Range(0, numDirs), [&](const Range& r)
+            {
+                FastGemmOpt dirOpt = opt;
+                dirOpt.multi_thread = false;
+                for (int d = r.start; d < r.end; d++)
+                    runDirection(d, dirOpt);
+            });
+        }
+    }
+
     void forward(InputArrayOfArrays inputs_arr, OutputArrayOfArrays outputs_arr, OutputArrayOfArrays internals_arr) CV_OVERRIDE
     {
         CV_TRACE_FUNCTION();
@@ -1077,6 +1320,12 @@ public:
         outputs_arr.getMatVector(output);
         internals_arr.getMatVector(internals);
 
+        if (useFastPath())
+        {
+            forwardFast(input[0], output[0], internals);
+            return;
+        }
+
         const int numDirs = 1 + static_cast<int>(bidirectional);
         for (int i = 0; i < numDirs; ++i)
         {
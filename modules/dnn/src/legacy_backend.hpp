@@ -106,6 +106,15 @@ private:
 #endif  // HAVE_OPENCL
 
 
+// Static assignment of the blobs memory (see Net::Impl::planMemory()):
+// the memory hosts (blobs for which the memory is allocated) are placed
+// into the arenas, one arena per data type.
+struct MemoryPlan
+{
+    std::map<LayerPin, size_t> offsets;  // host blob -> offset in bytes
+    std::map<int, size_t> arenaSizes;  // data type -> arena size in bytes
+};
+
 struct BlobManager
 {
 public:
@@ -182,6 +191,20 @@ public:
 
     void reuseOrCreate(const MatShape& shape, const LayerPin& lp, Mat& dst, const int& dtype)
     {
+        std::map<LayerPin, size_t>::const_iterator planIt = memoryPlan.offsets.find(lp);
+        if (planIt != memoryPlan.offsets.end())
+        {
+            // the memory is assigned by the planner
+            std::map<int, Mat>::const_iterator arenaIt = arenas.find(dtype);
+            CV_Assert(arenaIt != arenas.end());
+            const Mat& arena = arenaIt->second;
+            size_t esz = CV_ELEM_SIZE(dtype), ofs = planIt->second;
+            CV_Assert(ofs % esz == 0 && ofs + total(shape)*esz <= arena.total()*esz);
+            dst = arena.colRange((int)(ofs/esz), (int)(ofs/esz) + total(shape)).reshape(1, shape);
+            addHost(lp, dst);
+            return;
+        }
+
         if (!getParam_DNN_DISABLE_MEMORY_OPTIMIZATIONS())
         {
             Mat bestBlob;
@@ -311,6 +334,16 @@ public:
         refCounter.clear();
         reuseMap.clear();
         memHosts.clear();
+        memoryPlan = MemoryPlan();
+        arenas.clear();
+    }
+
+    // Use the planned offsets in the arenas (one per data type) instead of
+    // the reference counting reuse. Calls after reset().
+    void setMemoryPlan(const MemoryPlan& plan, const std::map<int, Mat>& arenas_)
+    {
+        memoryPlan = plan;
+        arenas = arenas_;
     }
 
 private:
@@ -327,6 +360,8 @@ private:
     // For origin blobs key == value.
     std::map<LayerPin, LayerPin> reuseMap;
     std::map<LayerPin, Mat> memHosts;
+    MemoryPlan memoryPlan;
+    std::map<int, Mat> arenas;
 };  // BlobManager
 
 
@@ -8,6 +8,15 @@
 #include <utility>
 #include <unordered_map>
 #include <iterator>
+#include <functional>
+#include <chrono>
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#endif
 
 #include <opencv2/imgproc.hpp>
 
@@ -96,10 +105,8 @@ public:
         outNames = outNames_;
     }
 
-    /*virtual*/
-    void processFrame(InputArray frame, OutputArrayOfArrays outs)
+    Image2BlobParams getBlobParams() const
     {
-        CV_TRACE_FUNCTION();
         if (size.empty())
             CV_Error(Error::StsBadSize, "Input size not specified");
 
@@ -112,7 +119,14 @@ public:
         {
             param.paddingmode = DNN_PMODE_CROP_CENTER;
         }
-        Mat blob = dnn::blobFromImageWithParams(frame, param); // [1, 10, 10, 4]
+        return param;
+    }
+
+    /*virtual*/
+    void processFrame(InputArray frame, OutputArrayOfArrays outs)
+    {
+        CV_TRACE_FUNCTION();
+        Mat blob = dnn::blobFromImageWithParams(frame, getBlobParams()); // [1, 10, 10, 4]
 
         net.setInput(blob);
 
@@ -125,6 +139,28 @@ public:
 
         net.forward(outs, outNames);
     }
+
+    // Runs the network for the batch of frames, the blob is padded by zeros up to batchSize images
+    void processFrames(const std::vector<Mat>& frames, int batchSize, std::vector<Mat>& outs)
+    {
+        CV_TRACE_FUNCTION();
+        CV_Assert(!frames.empty());
+        CV_CheckGE(batchSize, (int)frames.size(), "");
+        Mat blob = dnn::blobFromImagesWithParams(frames, getBlobParams());
+        if (batchSize > blob.size[0])
+        {
+            MatShape paddedShape = shape(blob);
+            paddedShape[0] = batchSize;
+            Mat padded(paddedShape, blob.type(), Scalar::all(0));
+            std::vector<Range> ranges(blob.dims, Range::all());
+            ranges[0] = Range(0, blob.size[0]);
+            blob.copyTo(padded(ranges));
+            blob = padded;
+        }
+
+        net.setInput(blob);
+        net.forward(outs, outNames);
+    }
 };
 
 Model::Model()
@@ -252,6 +288,11 @@ public:
     {
         std::vector<Mat> outs;
         processFrame(frame, outs);
+        return postprocess(outs);
+    }
+
+    std::pair<int, float> postprocess(const std::vector<Mat>& outs) const
+    {
         CV_Assert(outs.size() == 1);
 
         Mat out = outs[0].reshape(1, 1);
@@ -268,7 +309,7 @@ public:
     }
 
 protected:
-    void softmax(InputArray inblob, OutputArray outblob)
+    static void softmax(InputArray inblob, OutputArray outblob)
     {
         const Mat input = inblob.getMat();
         outblob.create(inblob.size(), inblob.type());
@@ -455,6 +496,161 @@ public:
         return nmsAcrossClasses;
     }
 
+    // The postprocessing of the network outputs for a frame of the frameSize size, see DetectionModel::detect()
+    void postprocess(const std::vector<Mat>& detections, const Size& frameSize,
+                     std::vector<int>& classIds, std::vector<float>& confidences, std::vector<Rect>& boxes,
+                     float confThreshold, float nmsThreshold)
+    {
+        boxes.clear();
+        confidences.clear();
+        classIds.clear();
+
+        int frameWidth  = frameSize.width;
+        int frameHeight = frameSize.height;
+        if (net.getLayer(0)->outputNameToIndex("im_info") != -1)
+        {
+            frameWidth = size.width;
+            frameHeight = size.height;
+        }
+
+        std::vector<String> layerNames = net.getLayerNames();
+        int lastLayerId = net.getLayerId(layerNames.back());
+        Ptr<Layer> lastLayer = net.getLayer(lastLayerId);
+
+        if (lastLayer->type == "DetectionOutput")
+        {
+            // Network produces output blob with a shape 1x1xNx7 where N is a number of
+            // detections and an every detection is a vector of values
+            // [batchId, classId, confidence, left, top, right, bottom]
+            for (int i = 0; i < detections.size(); ++i)
+            {
+                float* data = (float*)detections[i].data;
+                for (int j = 0; j < detections[i].total(); j += 7)
+                {
+                    float conf = data[j + 2];
+                    if (conf < confThreshold)
+                        continue;
+
+                    int left   = data[j + 3];
+                    int top    = data[j + 4];
+                    int right  = data[j + 5];
+                    int bottom = data[j + 6];
+                    int width  = right  - left + 1;
+                    int height = bottom - top + 1;
+
+                    if (width <= 2 || height <= 2)
+                    {
+                        left   = data[j + 3] * frameWidth;
+                        top    = data[j + 4] * frameHeight;
+                        right  = data[j + 5] * frameWidth;
+                        bottom = data[j + 6] * frameHeight;
+                        width  = right  - left + 1;
+                        height = bottom - top + 1;
+                    }
+
+                    left   = std::max(0, std::min(left, frameWidth - 1));
+                    top    = std::max(0, std::min(top, frameHeight - 1));
+                    width  = std::max(1, std::min(width, frameWidth - left));
+                    height = std::max(1, std::min(height, frameHeight - top));
+                    boxes.emplace_back(left, top, width, height);
+
+                    classIds.push_back(static_cast<int>(data[j + 1]));
+                    confidences.push_back(conf);
+                }
+            }
+        }
+        else if (lastLayer->type == "Region")
+        {
+            std::vector<int> predClassIds;
+            std::vector<Rect> predBoxes;
+            std::vector<float> predConfidences;
+            for (int i = 0; i < detections.size(); ++i)
+            {
+                // Network produces output blob with a shape NxC where N is a number of
+                // detected objects and C is a number of classes + 4 where the first 4
+                // numbers are [center_x, center_y, width, height]
+                float* data = (float*)detections[i].data;
+                for (int j = 0; j < detections[i].rows; ++j, data += detections[i].cols)
+                {
+
+                    Mat scores = detections[i].row(j).colRange(5, detections[i].cols);
+                    Point classIdPoint;
+                    double conf;
+                    minMaxLoc(scores, nullptr, &conf, nullptr, &classIdPoint);
+
+                    if (static_cast<float>(conf) < confThreshold)
+                        continue;
+
+                    int centerX = data[0] * frameWidth;
+                    int centerY = data[1] * frameHeight;
+                    int width   = data[2] * frameWidth;
+                    int height  = data[3] * frameHeight;
+
+                    int left = std::max(0, std::min(centerX - width / 2, frameWidth - 1));
+                    int top  = std::max(0, std::min(centerY - height / 2, frameHeight - 1));
+                    width    = std::max(1, std::min(width, frameWidth - left));
+                    height   = std::max(1, std::min(height, frameHeight - top));
+
+                    predClassIds.push_back(classIdPoint.x);
+                    predConfidences.push_back(static_cast<float>(conf));
+                    predBoxes.emplace_back(left, top, width, height);
+                }
+            }
+
+            if (nmsThreshold)
+            {
+                if (getNmsAcrossClasses())
+                {
+                    std::vector<int> indices;
+                    NMSBoxes(predBoxes, predConfidences, confThreshold, nmsThreshold, indices);
+                    for (int idx : indices)
+                    {
+                        boxes.push_back(predBoxes[idx]);
+                        confidences.push_back(predConfidences[idx]);
+                        classIds.push_back(predClassIds[idx]);
+                    }
+                }
+                else
+                {
+                    std::map<int, std::vector<size_t> > class2indices;
+                    for (size_t i = 0; i < predClassIds.size(); i++)
+                    {
+                        if (predConfidences[i] >= confThreshold)
+                        {
+                            class2indices[predClassIds[i]].push_back(i);
+                        }
+                    }
+                    for (const auto& it : class2indices)
+                    {
+                        std::vector<Rect> localBoxes;
+                        std::vector<float> localConfidences;
+                        for (size_t idx : it.second)
+                        {
+                            localBoxes.push_back(predBoxes[idx]);
+                            localConfidences.push_back(predConfidences[idx]);
+                        }
+                        std::vector<int> indices;
+                        NMSBoxes(localBoxes, localConfidences, confThreshold, nmsThreshold, indices);
+                        classIds.resize(classIds.size() + indices.size(), it.first);
+                        for (int idx : indices)
+                        {
+                            boxes.push_back(localBoxes[idx]);
+                            confidences.push_back(localConfidences[idx]);
+                        }
+                    }
+                }
+            }
+            else
+            {
+                boxes       = std::move(predBoxes);
+                classIds    = std::move(predClassIds);
+                confidences = std::move(predConfidences);
+            }
+        }
+        else
+            CV_Error(Error::StsNotImplemented, "Unknown output layer type: \"" + lastLayer->type + "\"");
+    }
+
 private:
     bool nmsAcrossClasses = false;
 };
@@ -501,154 +697,8 @@ void DetectionModel::detect(InputArray frame, CV_OUT std::vector<int>& classIds,
     std::vector<Mat> detections;
     impl->processFrame(frame, detections);
 
-    boxes.clear();
-    confidences.clear();
-    classIds.clear();
-
-    int frameWidth  = frame.cols();
-    int frameHeight = frame.rows();
-    if (getNetwork_().getLayer(0)->outputNameToIndex("im_info") != -1)
-    {
-        frameWidth = impl->size.width;
-        frameHeight = impl->size.height;
-    }
-
-    std::vector<String> layerNames = getNetwork_().getLayerNames();
-    int lastLayerId = getNetwork_().getLayerId(layerNames.back());
-    Ptr<Layer> lastLayer = getNetwork_().getLayer(lastLayerId);
-
-    if (lastLayer->type == "DetectionOutput")
-    {
-        // Network produces output blob with a shape 1x1xNx7 where N is a number of
-        // detections and an every detection is a vector of values
-        // [batchId, classId, confidence, left, top, right, bottom]
-        for (int i = 0; i < detections.size(); ++i)
-        {
-            float* data = (float*)detections[i].data;
-            for (int j = 0; j < detections[i].total(); j += 7)
-            {
-                float conf = data[j + 2];
-                if (conf < confThreshold)
-                    continue;
-
-                int left   = data[j + 3];
-                int top    = data[j + 4];
-                int right  = data[j + 5];
-                int bottom = data[j + 6];
-                int width  = right  - left + 1;
-                int height = bottom - top + 1;
-
-                if (width <= 2 || height <= 2)
-                {
-                    left   = data[j + 3] * frameWidth;
-                    top    = data[j + 4] * frameHeight;
-                    right  = data[j + 5] * frameWidth;
-                    bottom = data[j + 6] * frameHeight;
-                    width  = right  - left + 1;
-                    height = bottom - top + 1;
-                }
-
-                left   = std::max(0, std::min(left, frameWidth - 1));
-                top    = std::max(0, std::min(top, frameHeight - 1));
-                width  = std::max(1, std::min(width, frameWidth - left));
-                height = std::max(1, std::min(height, frameHeight - top));
-                boxes.emplace_back(left, top, width, height);
-
-                classIds.push_back(static_cast<int>(data[j + 1]));
-                confidences.push_back(conf);
-            }
-        }
-    }
-    else if (lastLayer->type == "Region")
-    {
-        std::vector<int> predClassIds;
-        std::vector<Rect> predBoxes;
-        std::vector<float> predConfidences;
-        for (int i = 0; i < detections.size(); ++i)
-        {
-            // Network produces output blob with a shape NxC where N is a number of
-            // detected objects and C is a number of classes + 4 where the first 4
-            // numbers are [center_x, center_y, width, height]
-            float* data = (float*)detections[i].data;
-            for (int j = 0; j < detections[i].rows; ++j, data += detections[i].cols)
-            {
-
-                Mat scores = detections[i].row(j).colRange(5, detections[i].cols);
-                Point classIdPoint;
-                double conf;
-                minMaxLoc(scores, nullptr, &conf, nullptr, &classIdPoint);
-
-                if (static_cast<float>(conf) < confThreshold)
-                    continue;
-
-                int centerX = data[0] * frameWidth;
-                int centerY = data[1] * frameHeight;
-                int width   = data[2] * frameWidth;
-                int height  = data[3] * frameHeight;
-
-                int left = std::max(0, std::min(centerX - width / 2, frameWidth - 1));
-                int top  = std::max(0, std::min(centerY - height / 2, frameHeight - 1));
-                width    = std::max(1, std::min(width, frameWidth - left));
-                height   = std::max(1, std::min(height, frameHeight - top));
-
-                predClassIds.push_back(classIdPoint.x);
-                predConfidences.push_back(static_cast<float>(conf));
-                predBoxes.emplace_back(left, top, width, height);
-            }
-        }
-
-        if (nmsThreshold)
-        {
-            if (getNmsAcrossClasses())
-            {
-                std::vector<int> indices;
-                NMSBoxes(predBoxes, predConfidences, confThreshold, nmsThreshold, indices);
-                for (int idx : indices)
-                {
-                    boxes.push_back(predBoxes[idx]);
-                    confidences.push_back(predConfidences[idx]);
-                    classIds.push_back(predClassIds[idx]);
-                }
-            }
-            else
-            {
-                std::map<int, std::vector<size_t> > class2indices;
-                for (size_t i = 0; i < predClassIds.size(); i++)
-                {
-                    if (predConfidences[i] >= confThreshold)
-                    {
-                        class2indices[predClassIds[i]].push_back(i);
-                    }
-                }
-                for (const auto& it : class2indices)
-                {
-                    std::vector<Rect> localBoxes;
-                    std::vector<float> localConfidences;
-                    for (size_t idx : it.second)
-                    {
-                        localBoxes.push_back(predBoxes[idx]);
-                        localConfidences.push_back(predConfidences[idx]);
-                    }
-                    std::vector<int> indices;
-                    NMSBoxes(localBoxes, localConfidences, confThreshold, nmsThreshold, indices);
-                    classIds.resize(classIds.size() + indices.size(), it.first);
-                    for (int idx : indices)
-                    {
-                        boxes.push_back(localBoxes[idx]);
-                        confidences.push_back(localConfidences[idx]);
-                    }
-                }
-            }
-        }
-        else
-        {
-            boxes       = std::move(predBoxes);
-            classIds    = std::move(predClassIds);
-            confidences = std::move(predConfidences);
-        }
-    }
-    else
-        CV_Error(Error::StsNotImplemented, "Unknown output layer type: \"" + lastLayer->type + "\"");
+    impl.dynamicCast<DetectionModel_Impl>()->postprocess(detections, frame.size(), classIds, confidences, boxes,
+                                                         confThreshold, nmsThreshold);
 }
 
 struct TextRecognitionModel_Impl : public Model::Impl
@@ -1613,4 +1663,328 @@ int TextDetectionModel_DB::getMaxCandidates() const
 }
 
 
+// Dynamic batching: the requests are queued by submit(), the collector thread forms the batches,
+// runs the network and completes the requests in the order of submission.
+struct BatchingModel::Impl
+{
+    typedef std::chrono::steady_clock Clock;
+
+    struct Request
+    {
+        Mat frame;
+        Clock::time_point submitted;
+        std::function<void(std::vector<Mat>&)> complete;  // postprocesses the outputs of the frame and sets the result
+        std::function<void(std::exception_ptr)> fail;
+    };
+
+    Impl(const Model& model_, const Params& params_)
+        : model(model_), params(params_)
+    {
+        CV_CheckGE(params.maxBatchSize, 1, "");
+        CV_CheckGE(params.maxDelay, 0.0, "");
+        CV_CheckGE(params.maxQueueSize, 0, "");
+        CV_Assert(model.getImpl());
+        Model::Impl& m = model.getImplRef();
+        if (m.size.empty())
+            CV_Error(Error::StsBadSize, "Input size not specified");
+        if (m.net.getLayer(0)->outputNameToIndex("im_info") != -1)
+            CV_Error(Error::StsNotImplemented, "DNN: batching of the networks with 'im_info' input is not supported");
+
+        for (const String& name : m.outNames)
+            outTypes.push_back(m.net.getLayer(name)->type);
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        stop = false;
+        collector = std::thread(&Impl::run, this);
+#endif
+    }
+
+    ~Impl()
+    {
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        notEmpty.notify_all();
+        collector.join();
+#endif
+    }
+
+    template<typename T, typename Postprocess>
+    std::future<T> submit(InputArray frame, const Postprocess& postprocess)
+    {
+        CV_Assert(!frame.empty());
+        std::shared_ptr<std::promise<T> > promise = std::make_shared<std::promise<T> >();
+        std::future<T> result = promise->get_future();
+
+        Request req;
+        frame.copyTo(req.frame);  // the caller may reuse the buffer
+        req.complete = [promise, postprocess](std::vector<Mat>& outs) { promise->set_value(postprocess(outs)); };
+        req.fail = [promise](std::exception_ptr e) { promise->set_exception(e); };
+        req.submitted = Clock::now();
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            notFull.wait(lock, [&]() { return params.maxQueueSize == 0 || (int)queue.size() < params.maxQueueSize; });
+            queue.push_back(std::move(req));
+            stats.maxQueueDepth = std::max(stats.maxQueueDepth, queue.size());
+        }
+        notEmpty.notify_one();
+#else
+        std::vector<Request> batch(1);
+        batch[0] = std::move(req);
+        process(batch);
+#endif
+        return result;
+    }
+
+    // Splits the output of the batch, see the postprocessing in ClassificationModel and DetectionModel
+    void splitOutput(const Mat& out, const String& type, std::vector<std::vector<Mat> >& frameOuts) const
+    {
+        const int batchSize = (int)frameOuts.size();
+        if (type == "DetectionOutput")
+        {
+            // 1x1xNx7 blob with the detections of all the images: [batchId, classId, confidence, left, top, right, bottom]
+            CV_CheckEQ(out.total() % 7, (size_t)0, "");
+            const int numDetections = (int)(out.total() / 7);
+            const float* data = out.ptr<float>();
+            std::vector<std::vector<int> > rows(batchSize);
+            for (int j = 0; j < numDetections; j++)
+            {
+                int batchId = (int)data[j * 7];
+                if (batchId >= 0 && batchId < batchSize)
+                    rows[batchId].push_back(j);
+            }
+            for (int i = 0; i < batchSize; i++)
+            {
+                int sz[] = {1, 1, (int)rows[i].size(), 7};
+                Mat detections(4, sz, CV_32F);
+                for (size_t k = 0; k < rows[i].size(); k++)
+                    std::copy(data + rows[i][k] * 7, data + rows[i][k] * 7 + 7, detections.ptr<float>() + k * 7);
+                frameOuts[i].push_back(detections);
+            }
+            return;
+        }
+
+        CV_Assert(out.dims >= 2);
+        CV_CheckGE(out.size[0], batchSize, "DNN: the output has no batch dimension");
+        for (int i = 0; i < batchSize; i++)
+        {
+            std::vector<Range> ranges(out.dims, Range::all());
+            ranges[0] = Range(i, i + 1);
+            Mat frameOut = out(ranges.data()).clone();
+            if (type == "Region")
+                frameOut = frameOut.reshape(1, out.size[1]);  // batch-1 output is NxC
+            frameOuts[i].push_back(frameOut);
+        }
+    }
+
+    void process(std::vector<Request>& batch)
+    {
+        CV_TRACE_FUNCTION();
+        const Clock::time_point start = Clock::now();
+        const int batchSize = (int)batch.size();
+        std::vector<std::vector<Mat> > frameOuts(batchSize);
+        Clock::time_point inferenceEnd;
+        try
+        {
+            std::vector<Mat> frames(batchSize);
+            for (int i = 0; i < batchSize; i++)
+                frames[i] = batch[i].frame;
+            std::vector<Mat> outs;
+            model.getImplRef().processFrames(frames, params.padBatch ? params.maxBatchSize : batchSize, outs);
+            inferenceEnd = Clock::now();
+            CV_CheckEQ(outs.size(), outTypes.size(), "");
+            for (size_t k = 0; k < outs.size(); k++)
+                splitOutput(outs[k], outTypes[k], frameOuts);
+        }
+        catch (...)
+        {
+            inferenceEnd = Clock::now();
+            for (int i = 0; i < batchSize; i++)
+                batch[i].fail(std::current_exception());
+            frameOuts.clear();
+        }
+
+        for (size_t i = 0; i < frameOuts.size(); i++)
+        {
+            try
+            {
+                batch[i].complete(frameOuts[i]);
+            }
+            catch (...)
+            {
+                batch[i].fail(std::current_exception());
+            }
+        }
+
+        const Clock::time_point end = Clock::now();
+        double queueWait = 0, latency = 0, maxLatency = 0;
+        for (int i = 0; i < batchSize; i++)
+        {
+            queueWait += std::chrono::duration<double, std::milli>(start - batch[i].submitted).count();
+            double t = std::chrono::duration<double, std::milli>(end - batch[i].submitted).count();
+            latency += t;
+            maxLatency = std::max(maxLatency, t);
+        }
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        std::lock_guard<std::mutex> lock(mutex);
+#endif
+        stats.numRequests += batchSize;
+        stats.numBatches++;
+        totalQueueWait += queueWait;
+        totalLatency += latency;
+        totalInferenceTime += std::chrono::duration<double, std::milli>(inferenceEnd - start).count();
+        stats.maxLatency = std::max(stats.maxLatency, maxLatency);
+    }
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+    void run()
+    {
+        const Clock::duration maxDelay = std::chrono::duration_cast<Clock::duration>(
+                std::chrono::duration<double, std::milli>(params.maxDelay));
+        for (;;)
+        {
+            std::vector<Request> batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                notEmpty.wait(lock, [&]() { return stop || !queue.empty(); });
+                if (queue.empty())
+                    return;  // stopped, all the requests are processed
+                // the queued requests are flushed without the delay on stop
+                notEmpty.wait_until(lock, queue.front().submitted + maxDelay,
+                        [&]() { return stop || (int)queue.size() >= params.maxBatchSize; });
+                size_t n = std::min(queue.size(), (size_t)params.maxBatchSize);
+                for (size_t i = 0; i < n; i++)
+                {
+                    batch.push_back(std::move(queue.front()));
+                    queue.pop_front();
+                }
+            }
+            notFull.notify_all();
+
+            process(batch);
+        }
+    }
+#endif
+
+    Statistics getStatistics() const
+    {
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        std::lock_guard<std::mutex> lock(mutex);
+        Statistics s = stats;
+        s.queueDepth = queue.size();
+#else
+        Statistics s = stats;
+#endif
+        if (s.numBatches)
+        {
+            s.avgBatchSize = (double)s.numRequests / s.numBatches;
+            s.avgInferenceTime = totalInferenceTime / s.numBatches;
+        }
+        if (s.numRequests)
+        {
+            s.avgQueueWait = totalQueueWait / s.numRequests;
+            s.avgLatency = totalLatency / s.numRequests;
+        }
+        return s;
+    }
+
+    void resetStatistics()
+    {
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.maxQueueDepth = queue.size();
+#else
+        stats.maxQueueDepth = 0;
+#endif
+        stats.numRequests = stats.numBatches = 0;
+        stats.maxLatency = 0;
+        totalQueueWait = totalLatency = totalInferenceTime = 0;
+    }
+
+    Model model;
+    const Params params;
+    std::vector<String> outTypes;  // the types of the output layers, in the order of Model::Impl::outNames
+
+    Statistics stats;
+    double totalQueueWait = 0, totalLatency = 0, totalInferenceTime = 0;
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+    std::thread collector;
+    std::deque<Request> queue;
+    bool stop;
+    mutable std::mutex mutex;
+    std::condition_variable notEmpty, notFull;
+#endif
+};
+
+BatchingModel::Params::Params()
+    : maxBatchSize(8), maxDelay(5.0), maxQueueSize(0), padBatch(false)
+{
+    // nothing
+}
+
+BatchingModel::Statistics::Statistics()
+    : queueDepth(0), maxQueueDepth(0), numRequests(0), numBatches(0),
+      avgBatchSize(0), avgQueueWait(0), avgInferenceTime(0), avgLatency(0), maxLatency(0)
+{
+    // nothing
+}
+
+BatchingModel::BatchingModel(const Model& model, const Params& params)
+{
+    impl = makePtr<Impl>(model, params);
+}
+
+BatchingModel::~BatchingModel()
+{
+    // nothing
+}
+
+std::future<std::vector<Mat> > BatchingModel::predict(InputArray frame)
+{
+    CV_Assert(impl);
+    return impl->submit<std::vector<Mat> >(frame, [](std::vector<Mat>& outs) { return outs; });
+}
+
+std::future<std::pair<int, float> > BatchingModel::classify(InputArray frame)
+{
+    CV_Assert(impl);
+    // the model is owned by the front-end, which completes all the requests before the destruction
+    ClassificationModel_Impl* model = dynamic_cast<ClassificationModel_Impl*>(impl->model.getImpl());
+    CV_Assert(model && "DNN: classify() requires ClassificationModel");
+    return impl->submit<std::pair<int, float> >(frame,
+            [model](std::vector<Mat>& outs) { return model->postprocess(outs); });
+}
+
+std::future<BatchingModel::Detections> BatchingModel::detect(InputArray frame, float confThreshold, float nmsThreshold)
+{
+    CV_Assert(impl);
+    DetectionModel_Impl* model = dynamic_cast<DetectionModel_Impl*>(impl->model.getImpl());
+    CV_Assert(model && "DNN: detect() requires DetectionModel");
+    const Size frameSize = frame.size();
+    return impl->submit<Detections>(frame, [model, frameSize, confThreshold, nmsThreshold](std::vector<Mat>& outs)
+    {
+        Detections result;
+        model->postprocess(outs, frameSize, result.classIds, result.confidences, result.boxes,
+                           confThreshold, nmsThreshold);
+        return result;
+    });
+}
+
+BatchingModel::Statistics BatchingModel::getStatistics() const
+{
+    CV_Assert(impl);
+    return impl->getStatistics();
+}
+
+void BatchingModel::resetStatistics()
+{
+    CV_Assert(impl);
+    impl->resetStatistics();
+}
+
+
 }}  // namespace
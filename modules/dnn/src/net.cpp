@@ -226,6 +226,14 @@ void Net::dumpToPbtxt(const String& path)
     file.close();
 }
 
+void Net::save(const String& path)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    CV_Assert(!empty());
+    impl->saveCompiled(path);
+}
+
 Ptr<Layer> Net::getLayer(int layerId) const
 {
     CV_Assert(impl);
@@ -413,6 +421,34 @@ void Net::enableWinograd(bool useWinograd)
     return impl->enableWinograd(useWinograd);
 }
 
+void Net::setWeightsCompression(int type)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->setWeightsCompression(type);
+}
+
+void Net::enableInterLayerParallelism(bool enable)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->enableInterLayerParallelism(enable);
+}
+
+void Net::setAsyncQueueDepth(int depth)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->setAsyncQueueDepth(depth);
+}
+
+void Net::setPlanCacheLimits(int maxPlans, size_t maxMemory)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->setPlanCacheLimits(maxPlans, maxMemory);
+}
+
 void Net::setHalideScheduler(const String& scheduler)
 {
     CV_TRACE_FUNCTION();
@@ -428,5 +464,39 @@ int64 Net::getPerfProfile(std::vector<double>& timings)
     return impl->getPerfProfile(timings);
 }
 
+void Net::enableProfiling(bool enable)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->enableProfiling(enable);
+}
+
+String Net::dumpProfile(const String& format)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    return impl->dumpProfile(format);
+}
+
+void Net::dumpProfileToFile(const String& path)
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    String ext = path.size() >= 4 ? toLowerCase(path.substr(path.size() - 4)) : String();
+    std::ofstream file(path.c_str());
+    file << impl->dumpProfile(ext == ".csv" ? "csv" : "json");
+    file.close();
+}
+
+Net Net::createExecutionContext()
+{
+    CV_TRACE_FUNCTION();
+    CV_Assert(impl);
+    Net ctx;
+    ctx.impl = impl->createExecutionContext();
+    ctx.impl->executionBase = impl->executionBase ? impl->executionBase : impl;
+    return ctx;
+}
+
 CV__DNN_INLINE_NS_END
 }}  // namespace cv::dnn
@@ -59,6 +59,12 @@ Net::Impl::Impl()
     preferableTarget = DNN_TARGET_CPU;
     hasDynamicShapes = false;
     useWinograd = true;
+    weightsCompression = CV_32F;
+    interLayerParallelism = false;
+    profiling = false;
+    planCacheMaxPlans = 0;
+    planCacheMaxMemory = 0;
+    asyncQueueDepth = 2;
 }
 
 
@@ -72,6 +78,12 @@ void Net::Impl::clear()
 {
     CV_TRACE_FUNCTION();
 
+    if (executionBase)
+        CV_Error(Error::StsError, "DNN: execution context can't be re-initialized (backend, target, fusion or input shapes can't be changed)");
+
+    // wait for the asynchronous requests, they use the layers
+    asyncExecutor.release();
+
     MapIdToLayerData::iterator it;
     for (it = layers.begin(); it != layers.end(); it++)
     {
@@ -92,6 +104,7 @@ void Net::Impl::clear()
     }
     netWasAllocated = false;
     layersTimings.clear();
+    layersSchedule.clear();
 }
 
 
@@ -135,6 +148,18 @@ void Net::Impl::setUpNet(const std::vector<LayerPin>& blobsToKeep_)
 
     validateBackendAndTarget();
 
+    if (executionBase && netWasAllocated)
+    {
+        // the context can only run the plan of the base network
+        for (size_t i = 0; i < blobsToKeep_.size(); i++)
+        {
+            if (std::find(blobsToKeep.begin(), blobsToKeep.end(), blobsToKeep_[i]) == blobsToKeep.end())
+                CV_Error(Error::StsError, "DNN: the requested output is not preserved by the execution context: "
+                                          "run the base network with the same outputs before creating the context");
+        }
+        return;
+    }
+
     if (!netWasAllocated || this->blobsToKeep != blobsToKeep_)
     {
         if (preferableBackend == DNN_BACKEND_OPENCV && IS_DNN_OPENCL_TARGET(preferableTarget))
@@ -381,6 +406,8 @@ int Net::Impl::addLayer(const String& name, const String& type, const int& dtype
         }
     }
 
+    clearPlanCache();
+
     id = ++lastLayerId;
     layerNameToId.insert(std::make_pair(name, id));
     layers.insert(std::make_pair(id, LayerData(id, name, type, dtype, params)));
@@ -412,6 +439,7 @@ void Net::Impl::connect(int outLayerId, int outNum, int inLayerId, int inNum)
     addLayerInput(ldInp, inNum, LayerPin(outLayerId, outNum));
     ldOut.requiredOutputs.insert(outNum);
     ldOut.consumers.push_back(LayerPin(inLayerId, outNum));
+    clearPlanCache();
 
     CV_LOG_VERBOSE(NULL, 0, "DNN: connect(" << outLayerId << ":" << outNum << " ==> " << inLayerId << ":" << inNum << ")");
 }
@@ -534,8 +562,9 @@ void Net::Impl::allocateLayer(int lid, const LayersShapesMap& layersShapes)
         {
             inps[i] = *ld.inputBlobs[i];
         }
-        layerPtr->finalize(inps, ld.outputBlobs);
+        // the layers may pack their weights for the target in finalize()
         layerPtr->preferableTarget = preferableTarget;
+        layerPtr->finalize(inps, ld.outputBlobs);
 #if 0
         std::cout << "\toutputs:";
         size_t noutputs = ld.outputBlobs.size();
@@ -564,6 +593,7 @@ void Net::Impl::allocateLayers(const std::vector<LayerPin>& blobsToKeep_)
 
     CV_Assert(!layers[0].outputBlobs.empty());
     ShapesVec inputShapes;
+    std::vector<int> inputTypes;
     for (int i = 0; i < layers[0].outputBlobs.size(); i++)
     {
         Mat& inp = layers[0].outputBlobs[i];
@@ -575,11 +605,37 @@ void Net::Impl::allocateLayers(const std::vector<LayerPin>& blobsToKeep_)
             layers[0].outputBlobs[i].create(inp.dims, inp.size, CV_16F);
         }
         inputShapes.push_back(shape(inp));
+        inputTypes.push_back(layers[0].outputBlobs[i].type());
     }
     LayersShapesMap layersShapes;
-    getLayersShapes(inputShapes, layersShapes);
+    MemoryPlan memoryPlan;
+    std::map<int, Mat> arenas;
+    const PlanCacheEntry* plan = usePlanCache() ? findPlan(inputShapes, inputTypes, blobsToKeep_) : NULL;
+    if (plan)
+    {
+        layersShapes = plan->layersShapes;
+        memoryPlan = plan->memoryPlan;
+        arenas = plan->arenas;
+    }
+    else
+    {
+        getLayersShapes(inputShapes, layersShapes);
+        if (useMemoryPlanner())
+            planMemory(layersShapes, blobsToKeep_, memoryPlan);
+    }
 
     blobManager.reset();
+    for (std::map<int, size_t>::const_iterator it = memoryPlan.arenaSizes.begin(); it != memoryPlan.arenaSizes.end(); ++it)
+    {
+        Mat& arena = arenas[it->first];
+        if (arena.empty())
+        {
+            size_t n = it->second / CV_ELEM_SIZE(it->first);
+            CV_Assert(n <= (size_t)INT_MAX);
+            arena.create(1, (int)n, it->first);
+        }
+    }
+    blobManager.setMemoryPlan(memoryPlan, arenas);
     backendWrappers.clear();
 
     for (auto& layer : layers)
@@ -610,8 +666,14 @@ void Net::Impl::allocateLayers(const std::vector<LayerPin>& blobsToKeep_)
         allocateLayer(lid, layersShapes);
     }
 
+    if (usePlanCache())
+        storePlan(inputShapes, inputTypes, blobsToKeep_, layersShapes, memoryPlan, arenas);
+
     layersTimings.resize(lastLayerId + 1, 0);
+    if (profiling)
+        layersProfile.resize(lastLayerId + 1);
     fuseLayers(blobsToKeep_);
+    scheduleLayers();
 }
 
 
@@ -848,6 +910,8 @@ void Net::Impl::forwardLayer(LayerData& ld)
         tm.stop();
         int64 t = tm.getTimeTicks();
         layersTimings[ld.id] = (t > 0) ? t : t + 1;  // zero for skipped layers only
+        if (profiling)
+            updateProfile(ld, t);
     }
     else
     {
@@ -872,17 +936,25 @@ void Net::Impl::forwardToLayer(LayerData& ld, bool clearFlags)
     if (ld.flag)
         return;
 
-    // forward parents
-    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end() && (it->second.id < ld.id); ++it)
+    if (!layersSchedule.empty())
     {
-        LayerData& ld = it->second;
-        if (ld.flag)
-            continue;
-        forwardLayer(ld);
+        // forward parents and itself by the levels of independent layers
+        forwardScheduledLayers(ld);
     }
+    else
+    {
+        // forward parents
+        for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end() && (it->second.id < ld.id); ++it)
+        {
+            LayerData& ld = it->second;
+            if (ld.flag)
+                continue;
+            forwardLayer(ld);
+        }
 
-    // forward itself
-    forwardLayer(ld);
+        // forward itself
+        forwardLayer(ld);
+    }
 
 #ifdef HAVE_CUDA
     if (preferableBackend == DNN_BACKEND_CUDA)
@@ -930,8 +1002,13 @@ AsyncArray Net::Impl::forwardAsync(const String& outputName)
     std::vector<LayerPin> pins(1, getPinByAlias(layerName));
     setUpNet(pins);
 
+    if (preferableBackend == DNN_BACKEND_OPENCV &&
+        (preferableTarget == DNN_TARGET_CPU || preferableTarget == DNN_TARGET_CPU_FP16))
+        return forwardAsyncCPU(pins[0]);
+
     if (preferableBackend != DNN_BACKEND_INFERENCE_ENGINE_NGRAPH)
-        CV_Error(Error::StsNotImplemented, "DNN: Asynchronous forward is supported for Inference Engine backend only");
+        CV_Error(Error::StsNotImplemented, "DNN: Asynchronous forward is supported for Inference Engine backend "
+                                           "and for OpenCV backend with CPU targets only");
 
     isAsync = true;
     forwardToLayer(getLayerData(layerName));
@@ -1377,6 +1454,7 @@ void Net::Impl::setInputsNames(const std::vector<String>& inputBlobNames)
 {
     CV_Assert(netInputLayer);
     netInputLayer->setNames(inputBlobNames);
+    clearPlanCache();
 }
 
 
@@ -1435,6 +1513,9 @@ void Net::Impl::setInput(InputArray blob, const String& name, double scalefactor
 
     MatShape prevShape = shape(netInputLayer->inputsData[pin.oid]);
     bool oldShape = prevShape == blobShape;
+    if (executionBase && (!oldShape || blob_.type() != netInputLayer->inputsData[pin.oid].type()))
+        CV_Error(Error::StsBadArg, "DNN: execution context inputs must have the same shape and type as "
+                                   "the inputs of the base network");
 
     blob_.copyTo(netInputLayer->inputsData[pin.oid]);
     if (!oldShape)
@@ -1466,7 +1547,9 @@ void Net::Impl::setParam(int layer, int numParam, const Mat& blob)
     std::vector<Mat>& layerBlobs = getLayerInstance(ld)->blobs;
     CV_Assert(numParam < (int)layerBlobs.size());
     // we don't make strong checks, use this function carefully
+    asyncExecutor.release();
     layerBlobs[numParam] = blob;
+    clearPlanCache();
 }
 
 
@@ -2266,6 +2349,18 @@ void Net::Impl::getMemoryConsumption(
         weights += w[i];
         blobs += b[i];
     }
+
+    if (useMemoryPlanner())
+    {
+        // intermediate blobs are placed into the arenas of the memory plan
+        LayersShapesMap layersShapes;
+        getLayersShapes(netInputShapes, layersShapes);
+        MemoryPlan plan;
+        planMemory(layersShapes, blobsToKeep, plan);
+        blobs = 0;
+        for (std::map<int, size_t>::const_iterator it = plan.arenaSizes.begin(); it != plan.arenaSizes.end(); ++it)
+            blobs += it->second;
+    }
 }
 
 
@@ -2343,6 +2438,28 @@ void Net::Impl::enableWinograd(bool useWinograd_)
     }
 }
 
+void Net::Impl::setWeightsCompression(int type)
+{
+    CV_CheckType(type, type == CV_32F || type == CV_16F || type == CV_8S,
+                 "DNN: weights can be compressed to CV_16F or CV_8S only");
+    if (weightsCompression == type)
+        return;
+    clear();  // the weights are packed again by finalize()
+    weightsCompression = type;
+
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); ++it)
+    {
+        LayerData& ld = it->second;
+        if (ld.type == "InnerProduct" || ld.type == "MatMul" || ld.type == "Gemm")
+        {
+            ld.params.set("weights_compression", type);
+            Ptr<WeightsCompressionLayer> layer = ld.layerInstance.dynamicCast<WeightsCompressionLayer>();
+            if (!layer.empty())
+                layer->setWeightsCompression(type);
+        }
+    }
+}
+
 
 // TODO drop?
 void Net::Impl::getLayerTypes(std::vector<String>& layersTypes) const
@@ -26,6 +26,8 @@
 
 #include "legacy_backend.hpp"  // wrapMat BlobManager OpenCLBackendWrapper
 
+#include <list>
+
 namespace cv {
 namespace dnn {
 CV__DNN_INLINE_NS_BEGIN
@@ -66,8 +68,49 @@ struct Net::Impl : public detail::NetImplBase
     bool fusion;
     bool isAsync;  // FIXIT: drop
     bool useWinograd;
+    int weightsCompression;
+    bool interLayerParallelism;
     std::vector<int64> layersTimings;
 
+    // Per-layer profile of forward() (see Net::enableProfiling() and net_impl_profile.cpp)
+    struct LayerProfile
+    {
+        LayerProfile() : ticks(0), minTicks(0), calls(0) {}
+        int64 ticks, minTicks;
+        int calls;
+    };
+    bool profiling;
+    std::vector<LayerProfile> layersProfile;
+    std::vector<std::vector<int> > layersSchedule;  // levels of the layers which can run concurrently
+
+    // Execution context of another network (see Net::createExecutionContext())
+    Ptr<Net::Impl> executionBase;  // network which shares its layers with this context
+    std::vector<Mat> contextBuffers;  // activation memory of the context
+
+    // Allocated plans for the previously seen input shapes (see Net::setPlanCacheLimits())
+    struct PlanCacheEntry
+    {
+        ShapesVec inputShapes;
+        std::vector<int> inputTypes;
+        std::vector<LayerPin> blobsToKeep;
+        int backend;
+        int target;
+        bool fusion;
+        bool interLayerParallelism;
+        LayersShapesMap layersShapes;
+        MemoryPlan memoryPlan;
+        std::map<int, Mat> arenas;  // activation memory of the plan
+        size_t memory;
+    };
+    std::list<PlanCacheEntry> planCache;  // the most recently used plans go first
+    int planCacheMaxPlans;
+    size_t planCacheMaxMemory;
+
+    // Asynchronous inference on CPU (see net_impl_async.cpp)
+    struct AsyncExecutor;
+    Ptr<AsyncExecutor> asyncExecutor;
+    int asyncQueueDepth;
+
 
     virtual bool empty() const;
     virtual void setPreferableBackend(Net& net, int backendId);
@@ -84,6 +127,8 @@ struct Net::Impl : public detail::NetImplBase
 
     void setUpNet(const std::vector<LayerPin>& blobsToKeep_ = std::vector<LayerPin>());
 
+    Ptr<Net::Impl> createExecutionContext();
+
 
     virtual Ptr<Layer> createLayerInstance(const LayerData& ld) const
     {
@@ -215,15 +260,35 @@ struct Net::Impl : public detail::NetImplBase
 
     virtual void fuseLayers(const std::vector<LayerPin>& blobsToKeep_);
     void enableWinograd(bool useWinograd_);
+    void setWeightsCompression(int type);
 
     void allocateLayers(const std::vector<LayerPin>& blobsToKeep_);
 
+    void setPlanCacheLimits(int maxPlans, size_t maxMemory);
+    void clearPlanCache();
+    bool usePlanCache() const;
+    const PlanCacheEntry* findPlan(const ShapesVec& inputShapes, const std::vector<int>& inputTypes,
+            const std::vector<LayerPin>& blobsToKeep_);
+    void storePlan(const ShapesVec& inputShapes, const std::vector<int>& inputTypes,
+            const std::vector<LayerPin>& blobsToKeep_, const LayersShapesMap& layersShapes,
+            const MemoryPlan& memoryPlan, const std::map<int, Mat>& arenas);
+
+    bool useMemoryPlanner() const;
+    void planMemory(const LayersShapesMap& layersShapes, const std::vector<LayerPin>& blobsToKeep_,
+            MemoryPlan& plan) const;
+
     virtual void forwardLayer(LayerData& ld);
 
+    void enableInterLayerParallelism(bool enable);
+    void scheduleLayers();
+    void forwardScheduledLayers(const LayerData& lastLayer);
+
     void forwardToLayer(LayerData& ld, bool clearFlags = true);
 
     Mat forward(const String& outputName);
     AsyncArray forwardAsync(const String& outputName);
+    AsyncArray forwardAsyncCPU(const LayerPin& pin);
+    void setAsyncQueueDepth(int depth);
     void forward(OutputArrayOfArrays outputBlobs, const String& outputName);
     void forward(OutputArrayOfArrays outputBlobs,
             const std::vector<String>& outBlobNames);
@@ -265,6 +330,9 @@ struct Net::Impl : public detail::NetImplBase
             std::vector<int>& layerIds, std::vector<size_t>& weights,
             std::vector<size_t>& blobs) /*const*/;
     int64 getPerfProfile(std::vector<double>& timings) const;
+    void enableProfiling(bool enable);
+    void updateProfile(const LayerData& ld, int64 ticks);
+    String dumpProfile(const String& format);
 
     // TODO drop
     LayerPin getLatestLayerPin(const std::vector<LayerPin>& pins) const;
@@ -282,6 +350,10 @@ struct Net::Impl : public detail::NetImplBase
 
     void dumpNetworkToFile() const;
 
+    // Compiled network files (see net_impl_compiled.cpp)
+    void saveCompiled(const String& path) const;
+    void loadCompiled(const String& path, int& backend, int& target);
+
     // FIXIT drop from inference API
     Net quantize(Net& net, InputArrayOfArrays calibData, int inputsDtype, int outputsDtype, bool perChannel) /*const*/;
     void getInputDetails(std::vector<float>& scales, std::vector<int>& zeropoints) /*const*/;
@@ -0,0 +1,180 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include "net_impl.hpp"
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#endif
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+
+// Asynchronous inference on CPU: a bounded queue of requests served by the worker threads.
+// Every worker owns an execution context of the network (see createExecutionContext()),
+// so the requests share the layers (weights) and run concurrently in the different activation buffers.
+// The executor is bound to the plan of the network (input shapes, requested outputs),
+// it is destroyed (after completion of the queued requests) when the network is re-initialized.
+struct Net::Impl::AsyncExecutor
+{
+    struct Request
+    {
+        std::vector<Mat> inputs;
+        std::vector<double> scaleFactors;
+        std::vector<Scalar> means;
+        AsyncPromise promise;
+    };
+
+    AsyncExecutor(Net::Impl& net, const LayerPin& pin_, int depth)
+        : pin(pin_)
+    {
+        CV_Assert(depth > 0);
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        inFlight = 0;
+        stop = false;
+        for (int i = 0; i < depth; i++)
+            contexts.push_back(net.createExecutionContext());
+        for (int i = 0; i < depth; i++)
+            workers.push_back(std::thread(&AsyncExecutor::run, this, i));
+#else
+        contexts.push_back(net.createExecutionContext());
+#endif
+    }
+
+    ~AsyncExecutor()
+    {
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        notEmpty.notify_all();
+        for (size_t i = 0; i < workers.size(); i++)
+            workers[i].join();
+#endif
+    }
+
+    // Blocks while the queue is full
+    AsyncArray submit(const DataLayer& inputLayer)
+    {
+        Request req;
+        req.inputs.resize(inputLayer.inputsData.size());
+        for (size_t i = 0; i < req.inputs.size(); i++)
+            inputLayer.inputsData[i].copyTo(req.inputs[i]);
+        req.scaleFactors = inputLayer.scaleFactors;
+        req.means = inputLayer.means;
+        AsyncArray result = req.promise.getArrayResult();
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            notFull.wait(lock, [&]() { return inFlight < (int)contexts.size(); });
+            inFlight++;
+            queue.push_back(std::move(req));
+        }
+        notEmpty.notify_one();
+#else
+        process(*contexts[0], req);
+#endif
+        return result;
+    }
+
+    void process(Net::Impl& ctx, Request& req)
+    {
+        CV_TRACE_FUNCTION();
+        try
+        {
+            FPDenormalsIgnoreHintScope fp_denormals_ignore_scope;
+            DataLayer& inputLayer = *ctx.netInputLayer;
+            CV_Assert(inputLayer.inputsData.size() == req.inputs.size());
+            for (size_t i = 0; i < req.inputs.size(); i++)
+            {
+                // the shapes are the same, so the data is copied into the buffers of the context
+                req.inputs[i].copyTo(inputLayer.inputsData[i]);
+                inputLayer.scaleFactors[i] = req.scaleFactors[i];
+                inputLayer.means[i] = req.means[i];
+            }
+            ctx.forwardToLayer(ctx.getLayerData(pin.lid));
+            req.promise.setValue(ctx.getBlob(pin).clone());
+        }
+        catch (...)
+        {
+            req.promise.setException(std::current_exception());
+        }
+    }
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+    void run(int worker)
+    {
+        for (;;)
+        {
+            Request req;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                notEmpty.wait(lock, [&]() { return stop || !queue.empty(); });
+                if (queue.empty())
+                    return;  // stopped, all the requests are processed
+                req = std::move(queue.front());
+                queue.pop_front();
+            }
+
+            process(*contexts[worker], req);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                inFlight--;
+            }
+            notFull.notify_one();
+        }
+    }
+#endif
+
+    const LayerPin pin;
+    std::vector<Ptr<Net::Impl> > contexts;
+
+#ifndef OPENCV_DISABLE_THREAD_SUPPORT
+    std::vector<std::thread> workers;
+    std::deque<Request> queue;
+    int inFlight;  // queued and running requests
+    bool stop;
+    std::mutex mutex;
+    std::condition_variable notEmpty, notFull;
+#endif
+};
+
+
+void Net::Impl::setAsyncQueueDepth(int depth)
+{
+    CV_CheckGE(depth, 1, "");
+    if (depth != asyncQueueDepth)
+        asyncExecutor.release();
+    asyncQueueDepth = depth;
+}
+
+
+AsyncArray Net::Impl::forwardAsyncCPU(const LayerPin& pin)
+{
+    CV_TRACE_FUNCTION();
+
+    if (executionBase)
+        CV_Error(Error::StsNotImplemented, "DNN: asynchronous forward is not supported by execution contexts");
+
+    if (asyncExecutor && !(asyncExecutor->pin == pin))
+        asyncExecutor.release();
+    if (!asyncExecutor)
+        asyncExecutor.reset(new AsyncExecutor(*this, pin, asyncQueueDepth));
+
+    return asyncExecutor->submit(*netInputLayer);
+}
+
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
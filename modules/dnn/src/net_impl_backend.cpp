@@ -186,6 +186,8 @@ void Net::Impl::setPreferableBackend(Net& net, int backendId)
 
     if (preferableBackend != backendId)
     {
+        if (executionBase)
+            CV_Error(Error::StsError, "DNN: backend of an execution context can't be changed");
         clear();
         if (backendId == DNN_BACKEND_INFERENCE_ENGINE_NGRAPH)
         {
@@ -215,6 +217,9 @@ void Net::Impl::setPreferableBackend(Net& net, int backendId)
 
 void Net::Impl::setPreferableTarget(int targetId)
 {
+    if (executionBase && targetId != preferableTarget)
+        CV_Error(Error::StsError, "DNN: target of an execution context can't be changed");
+
     if (netWasQuantized && targetId != DNN_TARGET_CPU &&
         targetId != DNN_TARGET_OPENCL && targetId != DNN_TARGET_OPENCL_FP16 && targetId != DNN_TARGET_NPU)
     {
@@ -242,16 +247,9 @@ void Net::Impl::setPreferableTarget(int targetId)
 #endif
         }
 
-#if !defined(__arm64__) || !__arm64__
-        if (targetId == DNN_TARGET_CPU_FP16)
-        {
-            CV_LOG_WARNING(NULL, "DNN: fall back to DNN_TARGET_CPU. Only ARM v8 CPU is supported by DNN_TARGET_CPU_FP16.");
-            targetId = DNN_TARGET_CPU;
-        }
-#endif
-
         clear();
 
+#if defined(__arm64__) && __arm64__
         if (targetId == DNN_TARGET_CPU_FP16)
         {
             if (useWinograd) {
@@ -259,6 +257,12 @@ void Net::Impl::setPreferableTarget(int targetId)
                 enableWinograd(false);
             }
         }
+#else
+        // Only the weights are stored in FP16 (the Winograd branch keeps the FP32 weights),
+        // the computations are done in FP32.
+        if (targetId == DNN_TARGET_CPU_FP16 && !checkHardwareSupport(CPU_FP16))
+            CV_LOG_ONCE_INFO(NULL, "DNN: the CPU doesn't support F16C, DNN_TARGET_CPU_FP16 converts the weights in software");
+#endif
     }
 }
 
@@ -0,0 +1,513 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include "net_impl.hpp"
+
+#include <opencv2/core/utils/logger.hpp>
+#include <opencv2/core/utils/filesystem.hpp>
+#include <opencv2/core/utils/filesystem.private.hpp>
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+
+// Compiled network file (little-endian):
+//   magic "OCVDNNCN", u32 format version, u32 endianness marker, u64 size of the description
+//   description: the OpenCV version and the CPU key (build and runtime CPU features),
+//       the network settings, the table of the blobs, the layers (name, type, parameters,
+//       references to the blobs, connections), the packed weights of the layers
+//   blobs data: each blob is aligned to COMPILED_NET_ALIGN bytes, the offsets are relative
+//       to the data start which is the aligned end of the description
+// The layer parameters and blobs are the original ones (before the fusion): the network
+// is constructed again on load and the fusion reproduces the fused weights. The packed weights
+// are exported by the layers (see PackedWeightsLayer) and used only with the same CPU key.
+namespace {
+
+static const char compiledNetMagic[8] = { 'O', 'C', 'V', 'D', 'N', 'N', 'C', 'N' };
+enum { COMPILED_NET_VERSION = 1, COMPILED_NET_ENDIANNESS = 0x01020304, COMPILED_NET_ALIGN = 64 };
+
+static std::string getCompiledNetCPUKey()
+{
+    std::ostringstream key;
+    key << CV_VERSION << ";" << getCPUFeaturesLine() << ";";
+    for (int i = 1; i < CV_HARDWARE_MAX_FEATURE; i++)
+    {
+        if (checkHardwareSupport(i))
+            key << i << ",";
+    }
+    return key.str();
+}
+
+class CompiledNetWriter
+{
+public:
+    void writeInt(int v) { write(&v, sizeof(v)); }
+    void writeU64(uint64 v) { write(&v, sizeof(v)); }
+    void writeReal(double v) { write(&v, sizeof(v)); }
+    void writeString(const std::string& s)
+    {
+        writeInt((int)s.size());
+        write(s.data(), s.size());
+    }
+    void writeShape(const MatShape& shape)
+    {
+        writeInt((int)shape.size());
+        for (size_t i = 0; i < shape.size(); i++)
+            writeInt(shape[i]);
+    }
+    void writeDict(const Dict& dict);
+    void write(const void* data, size_t size)
+    {
+        buf.append((const char*)data, size);
+    }
+
+    // Returns the index of the blob in the table, the same memory is stored once
+    int addBlob(const Mat& m);
+    void writeBlobsTable(CompiledNetWriter& out) const;
+    void writeBlobsData(std::ostream& out) const;
+
+    std::string buf;
+
+private:
+    std::vector<Mat> blobs;
+    std::vector<uint64> offsets;
+    uint64 dataSize = 0;
+};
+
+void CompiledNetWriter::writeDict(const Dict& dict)
+{
+    int n = 0;
+    for (std::map<String, DictValue>::const_iterator it = dict.begin(); it != dict.end(); ++it)
+        n++;
+    writeInt(n);
+    for (std::map<String, DictValue>::const_iterator it = dict.begin(); it != dict.end(); ++it)
+    {
+        const DictValue& v = it->second;
+        writeString(it->first);
+        int kind = v.isInt() ? 0 : v.isReal() ? 1 : 2;
+        CV_Assert(kind != 2 || v.isString());
+        writeInt(kind);
+        writeInt(v.size());
+        for (int i = 0; i < v.size(); i++)
+        {
+            if (kind == 0)
+            {
+                int64 x = v.get<int64>(i);
+                write(&x, sizeof(x));
+            }
+            else if (kind == 1)
+                writeReal(v.get<double>(i));
+            else
+                writeString(v.get<String>(i));
+        }
+    }
+}
+
+int CompiledNetWriter::addBlob(const Mat& m_)
+{
+    if (m_.empty())
+        return -1;
+    Mat m = m_.isContinuous() ? m_ : m_.clone();
+    for (size_t i = 0; i < blobs.size(); i++)
+    {
+        const Mat& b = blobs[i];
+        if (b.data == m.data && b.type() == m.type() && b.size == m.size)
+            return (int)i;
+    }
+    blobs.push_back(m);
+    offsets.push_back(dataSize);
+    dataSize = alignSize(dataSize + m.total() * m.elemSize(), (int)COMPILED_NET_ALIGN);
+    return (int)blobs.size() - 1;
+}
+
+void CompiledNetWriter::writeBlobsTable(CompiledNetWriter& out) const
+{
+    out.writeInt((int)blobs.size());
+    for (size_t i = 0; i < blobs.size(); i++)
+    {
+        const Mat& m = blobs[i];
+        out.writeInt(m.type());
+        out.writeInt(m.dims);
+        for (int j = 0; j < m.dims; j++)
+            out.writeInt(m.size[j]);
+        out.writeU64(offsets[i]);
+    }
+    out.writeU64(dataSize);
+}
+
+void CompiledNetWriter::writeBlobsData(std::ostream& out) const
+{
+    const char zeros[COMPILED_NET_ALIGN] = {};
+    uint64 pos = 0;
+    for (size_t i = 0; i < blobs.size(); i++)
+    {
+        const Mat& m = blobs[i];
+        CV_Assert(pos <= offsets[i] && offsets[i] - pos < COMPILED_NET_ALIGN);
+        out.write(zeros, (std::streamsize)(offsets[i] - pos));
+        size_t size = m.total() * m.elemSize();
+        out.write((const char*)m.data, (std::streamsize)size);
+        pos = offsets[i] + size;
+    }
+    out.write(zeros, (std::streamsize)(dataSize - pos));
+}
+
+class CompiledNetReader
+{
+public:
+    CompiledNetReader(const uchar* data, size_t size) : ptr(data), end(data + size) {}
+
+    int readInt() { int v; read(&v, sizeof(v)); return v; }
+    uint64 readU64() { uint64 v; read(&v, sizeof(v)); return v; }
+    double readReal() { double v; read(&v, sizeof(v)); return v; }
+    int readCount()
+    {
+        int n = readInt();
+        CV_CheckGE(n, 0, "DNN/compiled: invalid file");
+        return n;
+    }
+    std::string readString()
+    {
+        int n = readCount();
+        check(n);
+        std::string s((const char*)ptr, n);
+        ptr += n;
+        return s;
+    }
+    MatShape readShape()
+    {
+        MatShape shape(readCount());
+        for (size_t i = 0; i < shape.size(); i++)
+            shape[i] = readInt();
+        return shape;
+    }
+    void readDict(Dict& dict);
+    void read(void* dst, size_t size)
+    {
+        check(size);
+        memcpy(dst, ptr, size);
+        ptr += size;
+    }
+    void check(size_t size) const
+    {
+        if ((size_t)(end - ptr) < size)
+            CV_Error(Error::StsParseError, "DNN/compiled: unexpected end of file");
+    }
+
+private:
+    const uchar* ptr;
+    const uchar* end;
+};
+
+void CompiledNetReader::readDict(Dict& dict)
+{
+    int n = readCount();
+    for (int k = 0; k < n; k++)
+    {
+        std::string key = readString();
+        int kind = readInt();
+        int size = readCount();
+        if (kind == 0)
+        {
+            std::vector<int64> v(size);
+            for (int i = 0; i < size; i++)
+                read(&v[i], sizeof(int64));
+            dict.set(key, DictValue::arrayInt(v.begin(), size));
+        }
+        else if (kind == 1)
+        {
+            std::vector<double> v(size);
+            for (int i = 0; i < size; i++)
+                v[i] = readReal();
+            dict.set(key, DictValue::arrayReal(v.begin(), size));
+        }
+        else if (kind == 2)
+        {
+            std::vector<String> v(size);
+            for (int i = 0; i < size; i++)
+                v[i] = readString();
+            dict.set(key, DictValue::arrayString(v.begin(), size));
+        }
+        else
+            CV_Error(Error::StsParseError, "DNN/compiled: invalid layer parameter");
+    }
+}
+
+static int readBlobRef(CompiledNetReader& reader, const std::vector<Mat>& blobs)
+{
+    int idx = reader.readInt();
+    CV_Check(idx, idx >= -1 && idx < (int)blobs.size(), "DNN/compiled: invalid blob reference");
+    return idx;
+}
+
+}  // namespace
+
+
+void Net::Impl::saveCompiled(const String& path) const
+{
+    CV_TRACE_FUNCTION();
+
+    if (netWasQuantized)
+        CV_Error(Error::StsNotImplemented, "DNN/compiled: quantized networks are not supported");
+
+    CompiledNetWriter layersDesc;
+    layersDesc.writeInt((int)layers.size() - 1);
+    std::vector<int> packedLayers;
+    for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); ++it)
+    {
+        const LayerData& ld = it->second;
+        if (ld.id == 0)
+            continue;
+        layersDesc.writeInt(ld.id);
+        layersDesc.writeString(ld.name);
+        layersDesc.writeString(ld.type);
+        layersDesc.writeInt(ld.dtype);
+        layersDesc.writeDict(ld.params);
+        layersDesc.writeInt((int)ld.params.blobs.size());
+        for (size_t i = 0; i < ld.params.blobs.size(); i++)
+            layersDesc.writeInt(layersDesc.addBlob(ld.params.blobs[i]));
+        layersDesc.writeInt((int)ld.inputBlobsId.size());
+        for (size_t i = 0; i < ld.inputBlobsId.size(); i++)
+        {
+            layersDesc.writeInt(ld.inputBlobsId[i].lid);
+            layersDesc.writeInt(ld.inputBlobsId[i].oid);
+        }
+        if (ld.layerInstance.dynamicCast<PackedWeightsLayer>())
+            packedLayers.push_back(ld.id);
+    }
+
+    // the packed weights are valid for the current backend and target only
+    int npacked = 0;
+    CompiledNetWriter packedDesc;
+    for (size_t i = 0; i < packedLayers.size(); i++)
+    {
+        const LayerData& ld = layers.find(packedLayers[i])->second;
+        Ptr<PackedWeightsLayer> layer = ld.layerInstance.dynamicCast<PackedWeightsLayer>();
+        std::vector<int> params;
+        std::vector<Mat> buffers;
+        if (!layer->getPackedWeights(params, buffers))
+            continue;
+        npacked++;
+        packedDesc.writeInt(ld.id);
+        packedDesc.writeInt((int)params.size());
+        for (size_t j = 0; j < params.size(); j++)
+            packedDesc.writeInt(params[j]);
+        packedDesc.writeInt((int)buffers.size());
+        for (size_t j = 0; j < buffers.size(); j++)
+            packedDesc.writeInt(layersDesc.addBlob(buffers[j]));
+    }
+
+    CompiledNetWriter desc;
+    desc.writeString(CV_VERSION);
+    desc.writeString(getCompiledNetCPUKey());
+    desc.writeInt(preferableBackend);
+    desc.writeInt(preferableTarget);
+    desc.writeInt(fusion ? 1 : 0);
+    desc.writeInt(useWinograd ? 1 : 0);
+    desc.writeInt(hasDynamicShapes ? 1 : 0);
+    const DataLayer& inputLayer = *netInputLayer;
+    desc.writeInt((int)inputLayer.outNames.size());
+    for (size_t i = 0; i < inputLayer.outNames.size(); i++)
+    {
+        desc.writeString(inputLayer.outNames[i]);
+        desc.writeShape(i < inputLayer.shapes.size() ? inputLayer.shapes[i] : MatShape());
+    }
+    desc.writeInt((int)outputNameToId.size());
+    for (std::map<std::string, int>::const_iterator it = outputNameToId.begin(); it != outputNameToId.end(); ++it)
+    {
+        desc.writeString(it->first);
+        desc.writeInt(it->second);
+    }
+    // the blobs table goes before the layers, they refer to it
+    layersDesc.writeBlobsTable(desc);
+    desc.buf += layersDesc.buf;
+    desc.writeInt(npacked);
+    desc.buf += packedDesc.buf;
+
+    std::ofstream out(path.c_str(), std::ios::binary);
+    if (!out.is_open())
+        CV_Error(Error::StsError, "DNN/compiled: can't open file for writing: " + path);
+    out.write(compiledNetMagic, sizeof(compiledNetMagic));
+    const int header[] = { COMPILED_NET_VERSION, COMPILED_NET_ENDIANNESS };
+    out.write((const char*)header, sizeof(header));
+    const uint64 descSize = desc.buf.size();
+    out.write((const char*)&descSize, sizeof(descSize));
+    out.write(desc.buf.data(), (std::streamsize)descSize);
+    const size_t headerSize = sizeof(compiledNetMagic) + sizeof(header) + sizeof(descSize);
+    const char zeros[COMPILED_NET_ALIGN] = {};
+    out.write(zeros, (std::streamsize)(alignSize(headerSize + descSize, (int)COMPILED_NET_ALIGN) - headerSize - descSize));
+    layersDesc.writeBlobsData(out);
+    if (!out.good())
+        CV_Error(Error::StsError, "DNN/compiled: can't write file: " + path);
+}
+
+
+void Net::Impl::loadCompiled(const String& path, int& backend, int& target)
+{
+    CV_TRACE_FUNCTION();
+
+#if OPENCV_HAVE_FILESYSTEM_SUPPORT
+    std::shared_ptr<utils::fs::MappedFile> file = std::make_shared<utils::fs::MappedFile>(path.c_str());
+    if (!file->isOpened())
+        CV_Error(Error::StsError, "DNN/compiled: can't open file: " + path);
+
+    CompiledNetReader reader(file->data(), file->size());
+    char magic[sizeof(compiledNetMagic)];
+    reader.read(magic, sizeof(magic));
+    if (memcmp(magic, compiledNetMagic, sizeof(magic)) != 0)
+        CV_Error(Error::StsParseError, "DNN/compiled: not a compiled network file: " + path);
+    const int version = reader.readInt();
+    if (version != COMPILED_NET_VERSION)
+        CV_Error(Error::StsNotImplemented, cv::format("DNN/compiled: unsupported file format version %d", version));
+    if (reader.readInt() != COMPILED_NET_ENDIANNESS)
+        CV_Error(Error::StsNotImplemented, "DNN/compiled: the file was saved on a platform with different endianness");
+    const uint64 descSize = reader.readU64();
+    const size_t headerSize = sizeof(compiledNetMagic) + 2 * sizeof(int) + sizeof(uint64);
+    CV_CheckLE(descSize, (uint64)(file->size() - headerSize), "DNN/compiled: invalid file");
+    const size_t dataStart = alignSize(headerSize + (size_t)descSize, (int)COMPILED_NET_ALIGN);
+    const size_t dataSize = file->size() > dataStart ? file->size() - dataStart : 0;
+
+    const std::string savedVersion = reader.readString();
+    const bool usePacked = reader.readString() == getCompiledNetCPUKey();
+    if (!usePacked)
+        CV_LOG_INFO(NULL, "DNN/compiled: the file was saved by OpenCV " << savedVersion
+                    << " or on another CPU, the weights are packed again");
+
+    backend = reader.readInt();
+    target = reader.readInt();
+    fusion = reader.readInt() != 0;
+    useWinograd = reader.readInt() != 0;
+    const bool dynamicShapes = reader.readInt() != 0;
+
+    std::vector<String> inputNames(reader.readCount());
+    std::vector<MatShape> inputShapes(inputNames.size());
+    for (size_t i = 0; i < inputNames.size(); i++)
+    {
+        inputNames[i] = reader.readString();
+        inputShapes[i] = reader.readShape();
+    }
+    std::map<std::string, int> outputs;
+    for (int i = 0, n = reader.readCount(); i < n; i++)
+    {
+        std::string name = reader.readString();
+        outputs[name] = reader.readInt();
+    }
+
+    // the weights are used from the mapped file, the Mats keep the file mapped
+    std::vector<Mat> blobs(reader.readCount());
+    std::vector<std::pair<std::vector<int>, int> > blobsDesc(blobs.size());
+    std::vector<uint64> blobsOffsets(blobs.size());
+    for (size_t i = 0; i < blobs.size(); i++)
+    {
+        blobsDesc[i].second = reader.readInt();
+        blobsDesc[i].first = reader.readShape();
+        blobsOffsets[i] = reader.readU64();
+    }
+    CV_CheckLE(reader.readU64(), (uint64)dataSize, "DNN/compiled: the file is truncated");
+    for (size_t i = 0; i < blobs.size(); i++)
+    {
+        const std::vector<int>& sizes = blobsDesc[i].first;
+        const int type = blobsDesc[i].second;
+        CV_Check(type, type == CV_MAT_TYPE(type) && !sizes.empty(), "DNN/compiled: invalid blob");
+        uint64 size = CV_ELEM_SIZE(type);
+        for (size_t j = 0; j < sizes.size(); j++)
+        {
+            CV_CheckGT(sizes[j], 0, "DNN/compiled: invalid blob");
+            size *= (uint64)sizes[j];
+            CV_CheckLE(size, (uint64)dataSize, "DNN/compiled: invalid blob");
+        }
+        CV_CheckLE(blobsOffsets[i], (uint64)dataSize - size, "DNN/compiled: invalid blob");
+        blobs[i] = wrapExternalMemory(file, file->data() + dataStart + (size_t)blobsOffsets[i], sizes, type);
+    }
+
+    setInputsNames(inputNames);
+    for (size_t i = 0; i < inputNames.size(); i++)
+    {
+        if (!inputShapes[i].empty())
+            setInputShape(inputNames[i], inputShapes[i]);
+    }
+
+    std::map<int, int> ids;  // saved id -> new id
+    ids[0] = 0;
+    for (int k = 0, n = reader.readCount(); k < n; k++)
+    {
+        const int savedId = reader.readInt();
+        const std::string name = reader.readString();
+        const std::string type = reader.readString();
+        const int dtype = reader.readInt();
+        LayerParams params;
+        reader.readDict(params);
+        params.name = name;
+        params.type = type;
+        params.blobs.resize(reader.readCount());
+        for (size_t i = 0; i < params.blobs.size(); i++)
+        {
+            int idx = readBlobRef(reader, blobs);
+            if (idx >= 0)
+                params.blobs[i] = blobs[idx];
+        }
+        CV_Check(savedId, ids.count(savedId) == 0, "DNN/compiled: duplicated layer id");
+        const int id = addLayer(name, type, dtype, params);
+        ids[savedId] = id;
+
+        for (int i = 0, ninputs = reader.readCount(); i < ninputs; i++)
+        {
+            const int lid = reader.readInt();
+            const int oid = reader.readInt();
+            std::map<int, int>::const_iterator inp = ids.find(lid);
+            CV_Check(lid, inp != ids.end(), "DNN/compiled: invalid layer input");
+            connect(inp->second, oid, id, i);
+        }
+    }
+    hasDynamicShapes = hasDynamicShapes || dynamicShapes;
+    for (std::map<std::string, int>::const_iterator it = outputs.begin(); it != outputs.end(); ++it)
+    {
+        std::map<int, int>::const_iterator out = ids.find(it->second);
+        CV_Check(it->second, out != ids.end(), "DNN/compiled: invalid network output");
+        outputNameToId[it->first] = out->second;
+    }
+
+    for (int k = 0, n = reader.readCount(); k < n; k++)
+    {
+        const int savedId = reader.readInt();
+        std::vector<int> params(reader.readCount());
+        for (size_t i = 0; i < params.size(); i++)
+            params[i] = reader.readInt();
+        std::vector<Mat> buffers(reader.readCount());
+        for (size_t i = 0; i < buffers.size(); i++)
+        {
+            int idx = readBlobRef(reader, blobs);
+            if (idx >= 0)
+                buffers[i] = blobs[idx];
+        }
+        std::map<int, int>::const_iterator it = ids.find(savedId);
+        if (!usePacked || it == ids.end() || backend != DNN_BACKEND_OPENCV)
+            continue;
+        Ptr<PackedWeightsLayer> layer = getLayerInstance(getLayerData(it->second)).dynamicCast<PackedWeightsLayer>();
+        if (layer)
+            layer->setPackedWeights(params, buffers);
+    }
+#else
+    CV_UNUSED(path); CV_UNUSED(backend); CV_UNUSED(target);
+    CV_Error(Error::StsNotImplemented, "DNN/compiled: file system support is disabled in this OpenCV build");
+#endif
+}
+
+
+Net readNetFromCompiled(const String& path)
+{
+    CV_TRACE_FUNCTION();
+    Net net;
+    int backend = DNN_BACKEND_DEFAULT, target = DNN_TARGET_CPU;
+    accessor::DnnNetAccessor::getImplPtrRef(net)->loadCompiled(path, backend, target);
+    net.setPreferableBackend(backend);
+    net.setPreferableTarget(target);
+    return net;
+}
+
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
@@ -0,0 +1,127 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include "net_impl.hpp"
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+
+// Execution contexts share the layer instances (weights, prepacked buffers, fused state)
+// of the allocated base network. A context owns a copy of the base network plan:
+// LayerData entries with their own activation blobs, which keep the aliasing
+// of the base network blobs (reused and in-place buffers).
+Ptr<Net::Impl> Net::Impl::createExecutionContext()
+{
+    CV_TRACE_FUNCTION();
+
+    if (executionBase)
+        return executionBase->createExecutionContext();
+
+    CV_Assert(!empty());
+    if (preferableBackend != DNN_BACKEND_OPENCV ||
+        (preferableTarget != DNN_TARGET_CPU && preferableTarget != DNN_TARGET_CPU_FP16))
+        CV_Error(Error::StsNotImplemented, "DNN: execution contexts are supported by DNN_BACKEND_OPENCV on CPU targets only");
+    CV_Assert(basePtr_.empty());
+    if (netInputLayer->inputsData.empty())
+        CV_Error(Error::StsError, "DNN: network inputs must be set before creating execution contexts");
+
+    FPDenormalsIgnoreHintScope fp_denormals_ignore_scope;
+
+    // Allocate the plan and run the network once: some layers finish their
+    // initialization in the first forward() call (e.g. packing of convolution weights),
+    // it must be done before the layers are shared between threads.
+    if (!netWasAllocated)
+    {
+        std::vector<String> outNames = getUnconnectedOutLayersNames();
+        std::vector<LayerPin> pins;
+        for (size_t i = 0; i < outNames.size(); i++)
+            pins.push_back(getPinByAlias(outNames[i]));
+        setUpNet(pins);
+    }
+    forwardToLayer(layers.rbegin()->second);
+
+    Ptr<Impl> ctx = makePtr<Impl>();
+    ctx->blobsToKeep = blobsToKeep;
+    ctx->layers = layers;
+    ctx->layerNameToId = layerNameToId;
+    ctx->outputNameToId = outputNameToId;
+    ctx->preferableBackend = preferableBackend;
+    ctx->preferableTarget = preferableTarget;
+    ctx->hasDynamicShapes = hasDynamicShapes;
+    ctx->lastLayerId = lastLayerId;
+    ctx->netWasQuantized = netWasQuantized;
+    ctx->fusion = fusion;
+    ctx->useWinograd = useWinograd;
+    ctx->weightsCompression = weightsCompression;
+    ctx->interLayerParallelism = interLayerParallelism;
+    ctx->layersSchedule = layersSchedule;  // the context keeps the aliasing of the blobs
+    ctx->layersTimings.resize(layersTimings.size(), 0);
+
+    // the input layer keeps the input data, so it is not shared
+    ctx->netInputLayer = makePtr<DataLayer>(*netInputLayer);
+    ctx->layers[0].layerInstance = ctx->netInputLayer;
+
+    // Replace every allocation referenced by the blobs with a new one of the same size,
+    // the blobs keep their offsets (so the aliasing is preserved). The contents are copied:
+    // some blobs are only initialized during the allocation of the network.
+    std::map<const void*, uchar*> buffers;
+    std::vector<Mat*> blobs;
+    for (size_t i = 0; i < ctx->netInputLayer->inputsData.size(); i++)
+        blobs.push_back(&ctx->netInputLayer->inputsData[i]);
+    for (MapIdToLayerData::iterator it = ctx->layers.begin(); it != ctx->layers.end(); ++it)
+    {
+        LayerData& ld = it->second;
+        for (size_t i = 0; i < ld.outputBlobs.size(); i++)
+            blobs.push_back(&ld.outputBlobs[i]);
+        for (size_t i = 0; i < ld.internals.size(); i++)
+            blobs.push_back(&ld.internals[i]);
+    }
+    for (size_t i = 0; i < blobs.size(); i++)
+    {
+        Mat& m = *blobs[i];
+        if (m.empty())
+            continue;
+        uchar*& buf = buffers[m.datastart];
+        if (!buf)
+        {
+            size_t nbytes = m.datalimit - m.datastart;
+            Mat storage(1, (int)nbytes, CV_8U);
+            memcpy(storage.data, m.datastart, nbytes);
+            ctx->contextBuffers.push_back(storage);
+            buf = storage.data;
+        }
+        m = Mat(m.dims, m.size.p, m.type(), buf + (m.data - m.datastart), m.step.p);
+    }
+
+    // rebind layer inputs to the blobs of the context
+    std::map<const Mat*, Mat*> outputs;
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); ++it)
+    {
+        LayerData& ld = it->second;
+        LayerData& ctx_ld = ctx->layers[it->first];
+        for (size_t i = 0; i < ld.outputBlobs.size(); i++)
+            outputs[&ld.outputBlobs[i]] = &ctx_ld.outputBlobs[i];
+    }
+    for (MapIdToLayerData::iterator it = ctx->layers.begin(); it != ctx->layers.end(); ++it)
+    {
+        LayerData& ld = it->second;
+        for (size_t i = 0; i < ld.inputBlobs.size(); i++)
+        {
+            std::map<const Mat*, Mat*>::const_iterator o = outputs.find(ld.inputBlobs[i]);
+            CV_Assert(o != outputs.end());
+            ld.inputBlobs[i] = o->second;
+        }
+    }
+
+    ctx->netWasAllocated = true;
+    return ctx;
+}
+
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
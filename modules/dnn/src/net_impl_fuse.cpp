@@ -32,6 +32,20 @@ void Net::Impl::enableFusion(bool fusion_)
 #endif
 
 
+// Eltwise or NaryEltwise layer which adds two blobs of the same shape (e.g. the residual connection)
+static bool isAddOfSameShapes(const LayerData& ld)
+{
+    if (ld.layerInstance.dynamicCast<NaryEltwiseLayer>().empty() && ld.layerInstance.dynamicCast<EltwiseLayer>().empty())
+        return false;
+    if (ld.inputBlobsId.size() != 2 || ld.inputBlobs.size() != 2 || ld.outputBlobs.size() != 1)
+        return false;
+    if (!ld.params.has("operation") || toLowerCase(ld.params.get<String>("operation")) != "add")
+        return false;
+    MatShape outShape = shape(ld.outputBlobs[0]);
+    return shape(*ld.inputBlobs[0]) == outShape && shape(*ld.inputBlobs[1]) == outShape;
+}
+
+
 void Net::Impl::fuseLayers(const std::vector<LayerPin>& blobsToKeep_)
 {
     CV_TRACE_FUNCTION();
@@ -359,6 +373,100 @@ void Net::Impl::fuseLayers(const std::vector<LayerPin>& blobsToKeep_)
                 break;
             }
 
+            // CPU: fuse MatMul layer with the constant weights followed by the residual Add.
+            // The residual is passed to [MatMul] as the last input and it is added
+            // in the epilogue of the GEMM, together with the bias and the fused activation.
+            while (nextData && preferableBackend == DNN_BACKEND_OPENCV && IS_DNN_CPU_TARGET(preferableTarget) &&
+                   ld.layerInstance->type == "MatMul")  // semantic of 'if'
+            {
+                Ptr<MatMulLayer> matmulLayer = ld.layerInstance.dynamicCast<MatMulLayer>();
+                if (matmulLayer.empty() || matmulLayer->blobs.empty() || ld.inputBlobs.size() != 1 ||
+                    ld.outputBlobs.size() != 1 || !isAddOfSameShapes(*nextData))
+                    break;
+
+                // [Add] consumes [MatMul] directly, there is no fused activation in between
+                LayerData* addData = nextData;
+                if (addData->inputBlobsId[0].lid != ld.id && addData->inputBlobsId[1].lid != ld.id)
+                    break;
+                int residualIdx = addData->inputBlobsId[0].lid == ld.id ? 1 : 0;
+
+                // the residual must already be computed
+                if (addData->inputBlobsId[residualIdx].lid >= ld.id)
+                    break;
+
+                printf_(("\tfused with %s\n", addData->layerInstance->name.c_str()));
+                addData->skip = true;
+
+                // To prevent memory collisions (i.e. when the residual and the output
+                // of [Add] are the same blob) we allocate a new blob.
+                ld.outputBlobs[0] = ld.outputBlobs[0].clone();
+                ld.outputBlobsWrappers[0] = wrap(ld.outputBlobs[0]);
+                ld.inputBlobs.push_back(addData->inputBlobs[residualIdx]);
+                ld.inputBlobsWrappers.push_back(addData->inputBlobsWrappers[residualIdx]);
+                matmulLayer->fusedAdd = true;
+
+                addData->outputBlobs = ld.outputBlobs;
+                addData->outputBlobsWrappers = ld.outputBlobsWrappers;
+
+                // Move references of [Add] consumers to the newly allocated blob.
+                for (int i = 0; i < addData->consumers.size(); ++i)
+                {
+                    LayerData& consumer = layers[addData->consumers[i].lid];
+                    for (int j = 0; j < consumer.inputBlobsId.size(); ++j)
+                    {
+                        if (consumer.inputBlobsId[j].lid == addData->id)
+                        {
+                            consumer.inputBlobs[j] = &ld.outputBlobs[0];
+                            consumer.inputBlobsWrappers[j] = ld.outputBlobsWrappers[0];
+                            break;
+                        }
+                    }
+                }
+                break;
+            }
+
+            // CPU: fuse the residual Add followed by LayerNorm. [LayerNorm] reads both inputs
+            // of [Add] and normalizes their sum, the output of [Add] is not computed.
+            while (nextData && preferableBackend == DNN_BACKEND_OPENCV && IS_DNN_CPU_TARGET(preferableTarget) &&
+                   isAddOfSameShapes(ld))  // semantic of 'if'
+            {
+                Ptr<LayerNormLayer> normLayer = nextData->layerInstance.dynamicCast<LayerNormLayer>();
+                if (normLayer.empty() || nextData->outputBlobs.size() != 1 ||
+                    !(nextData->inputBlobsId[0] == LayerPin(ld.id, 0)))
+                    break;
+
+                // The memory of the [Add] inputs may be reused by the layers allocated after [Add],
+                // so there must be no layers between [Add] and [LayerNorm].
+                MapIdToLayerData::const_iterator nextIt = layers.find(ld.id);
+                if (++nextIt == layers.end() || nextIt->first != nextData->id)
+                    break;
+
+                printf_(("\tfused with %s\n", normLayer->name.c_str()));
+                ld.skip = true;
+
+                // The residual is passed to [LayerNorm] as the last input. Its output is a new blob,
+                // it must not overlap with the inputs of [Add].
+                nextData->inputBlobs[0] = ld.inputBlobs[0];
+                nextData->inputBlobsWrappers[0] = ld.inputBlobsWrappers[0];
+                nextData->inputBlobs.push_back(ld.inputBlobs[1]);
+                nextData->inputBlobsWrappers.push_back(ld.inputBlobsWrappers[1]);
+                nextData->outputBlobs[0] = nextData->outputBlobs[0].clone();
+                nextData->outputBlobsWrappers[0] = wrap(nextData->outputBlobs[0]);
+                normLayer->fusedAdd = true;
+
+                // The consumers refer to the output of [LayerNorm] by pointer, only the wrappers are updated.
+                for (int i = 0; i < nextData->consumers.size(); ++i)
+                {
+                    LayerData& consumer = layers[nextData->consumers[i].lid];
+                    for (int j = 0; j < consumer.inputBlobsId.size(); ++j)
+                    {
+                        if (consumer.inputBlobsId[j] == LayerPin(nextData->id, 0))
+                            consumer.inputBlobsWrappers[j] = nextData->outputBlobsWrappers[0];
+                    }
+                }
+                break;
+            }
+
             // OpenCL: fuse convolution layer followed by eltwise + relu
             // CUDA: fuse convolution layer followed by eltwise/naryEltwise (and optional activation)
             while (nextData &&
@@ -807,6 +915,16 @@ void Net::Impl::fuseLayers(const std::vector<LayerPin>& blobsToKeep_)
                         // Layers that refer old input Mat will refer to the
                         // new data but the same Mat object.
                         CV_Assert_N(curr_output.data == output_slice.data, oldPtr == &curr_output);
+
+                        // the skipped (fused) layers between the real input and the concat
+                        // share its output, they may be requested as the network outputs
+                        for (LayerPin skipped = ld.inputBlobsId[i]; !(skipped == pin);
+                             skipped = layers[skipped.lid].inputBlobsId[0])
+                        {
+                            Mat& skipped_output = layers[skipped.lid].outputBlobs[skipped.oid];
+                            CV_Assert(skipped_output.size == output_slice.size);
+                            skipped_output = output_slice;
+                        }
                     }
 
 #ifdef HAVE_CUDA
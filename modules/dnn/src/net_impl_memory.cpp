@@ -0,0 +1,253 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include "net_impl.hpp"
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+
+bool Net::Impl::useMemoryPlanner() const
+{
+    return preferableBackend == DNN_BACKEND_OPENCV &&
+           (preferableTarget == DNN_TARGET_CPU || preferableTarget == DNN_TARGET_CPU_FP16);
+}
+
+
+namespace {
+
+// alignment of the blobs in the arenas, enough for any SIMD loads
+enum { MEMORY_PLAN_ALIGN = 64 };
+
+struct PlannedBuffer
+{
+    LayerPin host;
+    int type;
+    size_t size;
+    int start, end;  // positions of the first and the last layers which use the buffer
+    int levelStart, levelEnd;  // graph levels of the first and the last layers which use the buffer
+    int lastLevel;
+};
+
+struct PlannedBufferGreater
+{
+    const std::vector<PlannedBuffer>& buffers;
+    PlannedBufferGreater(const std::vector<PlannedBuffer>& buffers_) : buffers(buffers_) {}
+    bool operator()(int a, int b) const
+    {
+        const PlannedBuffer& ba = buffers[a];
+        const PlannedBuffer& bb = buffers[b];
+        if (ba.type != bb.type)
+            return ba.type < bb.type;
+        if (ba.size != bb.size)
+            return ba.size > bb.size;
+        return ba.start < bb.start;
+    }
+};
+
+}  // namespace
+
+// Static memory planning of the activations. The allocation of the layers is simulated
+// in the same order and with the same in-place rules as BlobManager::allocateBlobsForLayer():
+// every blob which is not computed in-place gets its own buffer, the buffer is live
+// from the layer which creates it to the last layer which consumes any of the blobs
+// stored in it. Internal blobs live only within their layer, unconsumed outputs
+// and the outputs to keep live till the end.
+// Then the buffers are placed into the arenas (greedy by size): the largest buffers go first,
+// each buffer takes the best fitting gap between the buffers with intersected lifetimes.
+// With the inter-layer parallelism the lifetimes are also measured in the levels of the graph
+// (see scheduleLayers()): the buffers used by the layers which can run concurrently never share the memory.
+void Net::Impl::planMemory(const LayersShapesMap& layersShapes, const std::vector<LayerPin>& blobsToKeep_,
+        MemoryPlan& plan) const
+{
+    CV_TRACE_FUNCTION();
+
+    plan = MemoryPlan();
+    const bool reuseMemory = !getParam_DNN_DISABLE_MEMORY_OPTIMIZATIONS();
+    const int lifetimeEnd = INT_MAX;
+
+    std::map<LayerPin, int> pinRefs;
+    for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); ++it)
+    {
+        const LayerData& ld = it->second;
+        for (size_t i = 0; i < ld.inputBlobsId.size(); i++)
+            pinRefs[ld.inputBlobsId[i]]++;
+    }
+    // fake references to the network inputs, they are reused for the next forward()
+    LayersShapesMap::const_iterator inputShapesIt = layersShapes.find(0);
+    CV_Assert(inputShapesIt != layersShapes.end());
+    for (size_t i = 0; i < inputShapesIt->second.out.size(); i++)
+        pinRefs[LayerPin(0, (int)i)]++;
+    for (size_t i = 0; i < blobsToKeep_.size(); i++)
+        pinRefs[blobsToKeep_[i]]++;
+
+    // levels of the layers by the data dependencies
+    const bool useLevels = interLayerParallelism;
+    std::map<int, int> levels;
+    for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); ++it)
+    {
+        const LayerData& ld = it->second;
+        int level = 0;
+        for (size_t i = 0; i < ld.inputBlobsId.size(); i++)
+        {
+            std::map<int, int>::const_iterator lv = levels.find(ld.inputBlobsId[i].lid);
+            if (lv != levels.end())
+                level = std::max(level, lv->second + 1);
+        }
+        levels[ld.id] = level;
+    }
+
+    std::vector<PlannedBuffer> buffers;
+    std::vector<int> bufferRefs;
+    std::map<LayerPin, int> pinBuffer;
+
+    int pos = 0;
+    for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); ++it, ++pos)
+    {
+        const LayerData& ld = it->second;
+        LayersShapesMap::const_iterator shapesIt = layersShapes.find(ld.id);
+        CV_Assert(shapesIt != layersShapes.end());
+        const LayerShapes& layerShapes = shapesIt->second;
+        const ShapesVec& outShapes = layerShapes.out;
+        const ShapesVec& internalShapes = layerShapes.internal;
+        int dtype = ld.dtype;
+        size_t esz = CV_ELEM_SIZE(dtype);
+        const int level = levels[ld.id];
+
+        bool inPlace = false;
+        int inputBuffer = -1;
+        if (layerShapes.supportInPlace && ld.id != 0 && ld.inputBlobsId.size() == 1)
+        {
+            std::map<LayerPin, int>::const_iterator inpIt = pinBuffer.find(ld.inputBlobsId[0]);
+            if (inpIt != pinBuffer.end())
+            {
+                inputBuffer = inpIt->second;
+                inPlace = bufferRefs[inputBuffer] == 1;
+            }
+        }
+
+        std::vector<LayerPin> internalPins;
+        size_t nshapes = outShapes.size() + internalShapes.size();
+        for (size_t i = 0; i < nshapes; i++)
+        {
+            bool isOutput = i < outShapes.size();
+            const MatShape& shape = isOutput ? outShapes[i] : internalShapes[i - outShapes.size()];
+            if (total(shape) == 0)
+                continue;
+            LayerPin pin(ld.id, (int)i);
+            int refs = 0;
+            if (isOutput)
+            {
+                std::map<LayerPin, int>::const_iterator refIt = pinRefs.find(pin);
+                refs = refIt != pinRefs.end() ? refIt->second : 0;
+            }
+            else
+            {
+                internalPins.push_back(pin);
+                refs = 1;
+            }
+
+            if (isOutput && inPlace)
+            {
+                CV_Assert(buffers[inputBuffer].size >= total(shape) * esz);
+                pinBuffer[pin] = inputBuffer;
+                // an unconsumed output keeps the buffer till the end (see BlobManager::reuse())
+                bufferRefs[inputBuffer] += std::max(refs, 1);
+                continue;
+            }
+
+            PlannedBuffer buf;
+            buf.host = pin;
+            buf.type = dtype;
+            buf.size = alignSize(total(shape) * esz, (int)MEMORY_PLAN_ALIGN);
+            buf.start = pos;
+            // buffers without references are never released (see BlobManager::reuseOrCreate())
+            buf.end = lifetimeEnd;
+            buf.levelStart = level;
+            buf.levelEnd = lifetimeEnd;
+            buf.lastLevel = level;
+            pinBuffer[pin] = (int)buffers.size();
+            buffers.push_back(buf);
+            bufferRefs.push_back(refs);
+        }
+
+        // release the inputs and the internal blobs of the layer
+        std::vector<LayerPin> released(ld.inputBlobsId);
+        released.insert(released.end(), internalPins.begin(), internalPins.end());
+        for (size_t i = 0; i < released.size(); i++)
+        {
+            std::map<LayerPin, int>::const_iterator bufIt = pinBuffer.find(released[i]);
+            if (bufIt == pinBuffer.end())
+                continue;
+            int b = bufIt->second;
+            CV_Assert(bufferRefs[b] > 0);
+            buffers[b].lastLevel = std::max(buffers[b].lastLevel, level);
+            if (--bufferRefs[b] == 0 && reuseMemory)
+            {
+                buffers[b].end = pos;
+                buffers[b].levelEnd = buffers[b].lastLevel;
+            }
+        }
+    }
+
+    // place the buffers into the arenas
+    std::vector<int> order(buffers.size());
+    for (size_t i = 0; i < order.size(); i++)
+        order[i] = (int)i;
+    std::sort(order.begin(), order.end(), PlannedBufferGreater(buffers));
+
+    std::vector<size_t> offsets(buffers.size(), 0);
+    std::vector<int> placed;
+    std::vector<std::pair<size_t, size_t> > busy;  // [offset, offset + size) of the live buffers
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        const PlannedBuffer& buf = buffers[order[i]];
+        if (i > 0 && buffers[order[i - 1]].type != buf.type)
+            placed.clear();
+
+        busy.clear();
+        for (size_t j = 0; j < placed.size(); j++)
+        {
+            const PlannedBuffer& other = buffers[placed[j]];
+            if ((other.start <= buf.end && buf.start <= other.end) ||
+                (useLevels && other.levelStart <= buf.levelEnd && buf.levelStart <= other.levelEnd))
+                busy.push_back(std::make_pair(offsets[placed[j]], offsets[placed[j]] + other.size));
+        }
+        std::sort(busy.begin(), busy.end());
+
+        size_t bestOffset = 0, bestGap = std::numeric_limits<size_t>::max(), top = 0;
+        bool found = false;
+        for (size_t j = 0; j < busy.size(); j++)
+        {
+            if (busy[j].first > top)
+            {
+                size_t gap = busy[j].first - top;
+                if (gap >= buf.size && gap < bestGap)
+                {
+                    bestOffset = top;
+                    bestGap = gap;
+                    found = true;
+                }
+            }
+            top = std::max(top, busy[j].second);
+        }
+        if (!found)
+            bestOffset = top;
+
+        offsets[order[i]] = bestOffset;
+        placed.push_back(order[i]);
+        size_t& arenaSize = plan.arenaSizes[buf.type];
+        arenaSize = std::max(arenaSize, bestOffset + buf.size);
+    }
+
+    for (size_t i = 0; i < buffers.size(); i++)
+        plan.offsets[buffers[i].host] = offsets[i];
+}
+
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
@@ -0,0 +1,103 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include "net_impl.hpp"
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+
+// The plan cache keeps the results of allocateLayers() for the recently used input shapes:
+// shapes of all the layers and the activation memory plan with the allocated arenas. On a cache hit
+// the shapes inference and the memory planning are skipped, the blobs are bound to the arenas of the plan.
+// Layers are finalized and fused again, but the prepacked weights are preserved by the layers
+// (see the convolution, Gemm and MatMul layers), so this pass doesn't depend on the model size.
+void Net::Impl::setPlanCacheLimits(int maxPlans, size_t maxMemory)
+{
+    CV_CheckGE(maxPlans, 0, "");
+    planCacheMaxPlans = maxPlans;
+    planCacheMaxMemory = maxMemory;
+    if (maxPlans == 0)
+    {
+        clearPlanCache();
+        return;
+    }
+
+    size_t memory = 0;
+    int nplans = 0;
+    for (std::list<PlanCacheEntry>::iterator it = planCache.begin(); it != planCache.end(); )
+    {
+        memory += it->memory;
+        nplans++;
+        if (nplans > planCacheMaxPlans || (planCacheMaxMemory > 0 && memory > planCacheMaxMemory))
+            it = planCache.erase(it);
+        else
+            ++it;
+    }
+}
+
+
+void Net::Impl::clearPlanCache()
+{
+    planCache.clear();
+}
+
+
+bool Net::Impl::usePlanCache() const
+{
+    return planCacheMaxPlans > 0 && !executionBase && useMemoryPlanner();
+}
+
+
+const Net::Impl::PlanCacheEntry* Net::Impl::findPlan(const ShapesVec& inputShapes, const std::vector<int>& inputTypes,
+        const std::vector<LayerPin>& blobsToKeep_)
+{
+    for (std::list<PlanCacheEntry>::iterator it = planCache.begin(); it != planCache.end(); ++it)
+    {
+        if (it->inputShapes == inputShapes && it->inputTypes == inputTypes &&
+            it->blobsToKeep == blobsToKeep_ && it->backend == preferableBackend &&
+            it->target == preferableTarget && it->fusion == fusion &&
+            it->interLayerParallelism == interLayerParallelism)
+        {
+            planCache.splice(planCache.begin(), planCache, it);
+            return &planCache.front();
+        }
+    }
+    return NULL;
+}
+
+
+void Net::Impl::storePlan(const ShapesVec& inputShapes, const std::vector<int>& inputTypes,
+        const std::vector<LayerPin>& blobsToKeep_, const LayersShapesMap& layersShapes,
+        const MemoryPlan& memoryPlan, const std::map<int, Mat>& arenas)
+{
+    if (findPlan(inputShapes, inputTypes, blobsToKeep_))
+        planCache.pop_front();
+
+    planCache.push_front(PlanCacheEntry());
+    PlanCacheEntry& entry = planCache.front();
+    entry.inputShapes = inputShapes;
+    entry.inputTypes = inputTypes;
+    entry.blobsToKeep = blobsToKeep_;
+    entry.backend = preferableBackend;
+    entry.target = preferableTarget;
+    entry.fusion = fusion;
+    entry.interLayerParallelism = interLayerParallelism;
+    entry.layersShapes = layersShapes;
+    entry.memoryPlan = memoryPlan;
+    entry.arenas = arenas;
+    entry.memory = 0;
+    for (std::map<int, Mat>::const_iterator it = arenas.begin(); it != arenas.end(); ++it)
+        entry.memory += it->second.total() * it->second.elemSize();
+
+    // evict the least recently used plans
+    setPlanCacheLimits(planCacheMaxPlans, planCacheMaxMemory);
+}
+
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
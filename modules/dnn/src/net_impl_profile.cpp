@@ -0,0 +1,206 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include "net_impl.hpp"
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+
+void Net::Impl::enableProfiling(bool enable)
+{
+    profiling = enable;
+    layersProfile.clear();
+    if (profiling)
+        layersProfile.resize(lastLayerId + 1);
+}
+
+
+void Net::Impl::updateProfile(const LayerData& ld, int64 ticks)
+{
+    // the profile is resized by setUpNet(), so the layers scheduled in parallel don't reallocate it
+    if (ld.id >= (int)layersProfile.size())
+        return;
+    LayerProfile& p = layersProfile[ld.id];
+    p.minTicks = p.calls == 0 ? ticks : std::min(p.minTicks, ticks);
+    p.ticks += ticks;
+    p.calls++;
+}
+
+
+namespace {
+
+struct ProfileRow
+{
+    int id;
+    String name, type, kernel;
+    String fusedInto;            // the layer which computes this skipped layer
+    std::vector<String> fused;   // the skipped layers computed by this layer
+    int calls;
+    double time, minTime;        // in milliseconds
+    double flops;
+    double bytesRead, bytesWritten;
+};
+
+static double bytesOf(const Mat& m)
+{
+    return (double)m.total() * m.elemSize();
+}
+
+static String csvField(const String& s)
+{
+    if (s.find_first_of(",\"\n") == String::npos)
+        return s;
+    String res = "\"";
+    for (size_t i = 0; i < s.size(); i++)
+    {
+        if (s[i] == '"')
+            res += '"';
+        res += s[i];
+    }
+    return res + "\"";
+}
+
+}  // namespace
+
+
+String Net::Impl::dumpProfile(const String& format)
+{
+    CV_TRACE_FUNCTION();
+    if (format != "json" && format != "csv")
+        CV_Error(Error::StsBadArg, "DNN: unsupported profile format '" + format + "', expected 'json' or 'csv'");
+    if (!profiling)
+        CV_Error(Error::StsError, "DNN: profiling is not enabled, see enableProfiling()");
+    if (!netWasAllocated)
+        CV_Error(Error::StsError, "DNN: the network is not initialized, run forward() to collect the profile");
+
+    ShapesVec inputShapes;
+    for (size_t i = 0; i < layers[0].outputBlobs.size(); i++)
+        inputShapes.push_back(shape(layers[0].outputBlobs[i]));
+    LayersShapesMap layersShapes;
+    getLayersShapes(inputShapes, layersShapes);
+
+    const double msPerTick = 1000.0 / getTickFrequency();
+    std::vector<ProfileRow> rows;
+    std::map<int, size_t> rowOfLayer;
+    for (MapIdToLayerData::iterator it = layers.begin(); it != layers.end(); ++it)
+    {
+        LayerData& ld = it->second;
+        if (ld.id == 0 || ld.layerInstance.empty())
+            continue;
+        ProfileRow row;
+        row.id = ld.id;
+        row.name = ld.name;
+        row.type = ld.type;
+        row.kernel = ld.skip ? String() : ld.layerInstance->getKernelName();
+        const LayerProfile p = ld.id < (int)layersProfile.size() ? layersProfile[ld.id] : LayerProfile();
+        row.calls = p.calls;
+        row.time = p.calls > 0 ? p.ticks * msPerTick / p.calls : 0;
+        row.minTime = p.minTicks * msPerTick;
+        LayersShapesMap::const_iterator shapes = layersShapes.find(ld.id);
+        row.flops = shapes != layersShapes.end() ?
+                (double)ld.layerInstance->getFLOPS(shapes->second.in, shapes->second.out) : 0;
+        // the actual tensors, they include the inputs appended by the fusion and the compressed weights
+        row.bytesRead = row.bytesWritten = 0;
+        for (size_t i = 0; i < ld.inputBlobs.size(); i++)
+            row.bytesRead += ld.inputBlobs[i] ? bytesOf(*ld.inputBlobs[i]) : 0;
+        for (size_t i = 0; i < ld.layerInstance->blobs.size(); i++)
+            row.bytesRead += bytesOf(ld.layerInstance->blobs[i]);
+        for (size_t i = 0; i < ld.outputBlobs.size(); i++)
+            row.bytesWritten += bytesOf(ld.outputBlobs[i]);
+        rowOfLayer[ld.id] = rows.size();
+        rows.push_back(row);
+    }
+
+    // A skipped layer is computed by the layer which writes its output (fused activation, batch norm,
+    // residual add) or, if the output is not shared, by its consumer of the same output shape (add + norm).
+    for (size_t r = 0; r < rows.size(); r++)
+    {
+        const LayerData& ld = layers[rows[r].id];
+        if (!ld.skip || ld.outputBlobs.empty())
+            continue;
+        const Mat& out = ld.outputBlobs[0];
+        int host = -1;
+        for (size_t k = 0; k < rows.size() && host < 0; k++)
+        {
+            const LayerData& other = layers[rows[k].id];
+            if (!other.skip && !other.outputBlobs.empty() && other.outputBlobs[0].data == out.data &&
+                shape(other.outputBlobs[0]) == shape(out))
+                host = other.id;
+        }
+        for (size_t c = 0; c < ld.consumers.size() && host < 0; c++)
+        {
+            const LayerData& consumer = layers[ld.consumers[c].lid];
+            if (!consumer.skip && !consumer.outputBlobs.empty() && shape(consumer.outputBlobs[0]) == shape(out))
+                host = consumer.id;
+        }
+        if (host < 0)
+            continue;
+        ProfileRow& hostRow = rows[rowOfLayer[host]];
+        hostRow.fused.push_back(rows[r].name);
+        hostRow.flops += rows[r].flops;
+        rows[r].fusedInto = hostRow.name;
+        rows[r].flops = rows[r].bytesRead = rows[r].bytesWritten = 0;
+    }
+
+    if (format == "csv")
+    {
+        std::ostringstream ss;
+        ss << "id,name,type,kernel,fused_into,fused,calls,time_ms,min_time_ms,flops,bytes_read,bytes_written,"
+              "gflops_per_sec,gbytes_per_sec,flops_per_byte\n";
+        for (size_t r = 0; r < rows.size(); r++)
+        {
+            const ProfileRow& row = rows[r];
+            String fused;
+            for (size_t i = 0; i < row.fused.size(); i++)
+                fused += (i ? ";" : "") + row.fused[i];
+            const double bytes = row.bytesRead + row.bytesWritten;
+            ss << row.id << "," << csvField(row.name) << "," << csvField(row.type) << "," << csvField(row.kernel) << ","
+               << csvField(row.fusedInto) << "," << csvField(fused) << "," << row.calls << ","
+               << row.time << "," << row.minTime << "," << (int64)row.flops << ","
+               << (int64)row.bytesRead << "," << (int64)row.bytesWritten << ","
+               << (row.time > 0 ? row.flops / (row.time * 1e6) : 0) << ","
+               << (row.time > 0 ? bytes / (row.time * 1e6) : 0) << ","
+               << (bytes > 0 ? row.flops / bytes : 0) << "\n";
+        }
+        return ss.str();
+    }
+
+    FileStorage fs(".json", FileStorage::WRITE | FileStorage::MEMORY);
+    double total = 0;
+    for (size_t r = 0; r < rows.size(); r++)
+        total += rows[r].time;
+    fs << "backend" << preferableBackend;
+    fs << "target" << preferableTarget;
+    fs << "time_ms" << total;
+    fs << "layers" << "[";
+    for (size_t r = 0; r < rows.size(); r++)
+    {
+        const ProfileRow& row = rows[r];
+        const double bytes = row.bytesRead + row.bytesWritten;
+        fs << "{";
+        fs << "id" << row.id << "name" << row.name << "type" << row.type;
+        fs << "kernel" << row.kernel;
+        fs << "fused_into" << row.fusedInto;
+        fs << "fused" << "[";
+        for (size_t i = 0; i < row.fused.size(); i++)
+            fs << row.fused[i];
+        fs << "]";
+        fs << "calls" << row.calls << "time_ms" << row.time << "min_time_ms" << row.minTime;
+        fs << "flops" << row.flops << "bytes_read" << row.bytesRead << "bytes_written" << row.bytesWritten;
+        fs << "gflops_per_sec" << (row.time > 0 ? row.flops / (row.time * 1e6) : 0);
+        fs << "gbytes_per_sec" << (row.time > 0 ? bytes / (row.time * 1e6) : 0);
+        fs << "flops_per_byte" << (bytes > 0 ? row.flops / bytes : 0);
+        fs << "}";
+    }
+    fs << "]";
+    return fs.releaseAndGetString();
+}
+
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
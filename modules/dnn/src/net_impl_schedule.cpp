@@ -0,0 +1,152 @@
+// This file is part of OpenCV project.
+// It is subject to the license terms in the LICENSE file found in the top-level directory
+// of this distribution and at http://opencv.org/license.html.
+
+#include "precomp.hpp"
+
+#include "net_impl.hpp"
+
+namespace cv {
+namespace dnn {
+CV__DNN_INLINE_NS_BEGIN
+
+
+void Net::Impl::enableInterLayerParallelism(bool enable)
+{
+    if (interLayerParallelism != enable)
+    {
+        interLayerParallelism = enable;
+        clear();
+    }
+}
+
+
+namespace {
+
+typedef std::pair<const uchar*, const uchar*> MemoryRange;
+
+static void addMemoryRange(const Mat& m, std::vector<MemoryRange>& ranges)
+{
+    if (m.empty())
+        return;
+    const uchar* end = m.data + m.elemSize();
+    for (int i = 0; i < m.dims; i++)
+        end += (m.size[i] - 1) * m.step[i];
+    ranges.push_back(MemoryRange(m.data, end));
+}
+
+static bool intersects(const std::vector<MemoryRange>& a, const std::vector<MemoryRange>& b)
+{
+    for (size_t i = 0; i < a.size(); i++)
+        for (size_t j = 0; j < b.size(); j++)
+            if (a[i].first < b[j].second && b[j].first < a[i].second)
+                return true;
+    return false;
+}
+
+class ForwardLayersInvoker : public ParallelLoopBody
+{
+public:
+    ForwardLayersInvoker(Net::Impl& net_, const std::vector<LayerData*>& layers_)
+        : net(net_), layers(layers_) {}
+
+    void operator()(const Range& range) const CV_OVERRIDE
+    {
+        for (int i = range.start; i < range.end; i++)
+            net.forwardLayer(*layers[i]);
+    }
+
+private:
+    Net::Impl& net;
+    const std::vector<LayerData*>& layers;
+};
+
+}  // namespace
+
+// Layers are grouped into the levels which can run concurrently. A layer goes to the level
+// next to the last level of the layers it depends on: the producers of its inputs and
+// the previous layers (in the order of ids) which access the same memory, if any of them writes it.
+// The memory based dependencies keep the semantics of the sequential execution regardless of
+// the fusion and the memory reuse. The layers of a level don't share their outputs,
+// so the results don't depend on the execution order.
+void Net::Impl::scheduleLayers()
+{
+    CV_TRACE_FUNCTION();
+
+    layersSchedule.clear();
+    if (!interLayerParallelism || !useMemoryPlanner())
+        return;
+
+    std::vector<int> ids;
+    std::vector<std::vector<MemoryRange> > reads, writes;
+    std::map<int, int> levels;
+    for (MapIdToLayerData::const_iterator it = layers.begin(); it != layers.end(); ++it)
+    {
+        const LayerData& ld = it->second;
+        std::vector<MemoryRange> r, w;
+        for (size_t i = 0; i < ld.inputBlobs.size(); i++)
+            if (ld.inputBlobs[i])
+                addMemoryRange(*ld.inputBlobs[i], r);
+        for (size_t i = 0; i < ld.outputBlobs.size(); i++)
+            addMemoryRange(ld.outputBlobs[i], w);
+        for (size_t i = 0; i < ld.internals.size(); i++)
+            addMemoryRange(ld.internals[i], w);
+
+        int level = 0;
+        for (size_t i = 0; i < ld.inputBlobsId.size(); i++)
+        {
+            std::map<int, int>::const_iterator lv = levels.find(ld.inputBlobsId[i].lid);
+            if (lv != levels.end())
+                level = std::max(level, lv->second + 1);
+        }
+        for (size_t j = 0; j < ids.size(); j++)
+        {
+            int prevLevel = levels[ids[j]];
+            if (prevLevel >= level &&
+                (intersects(w, reads[j]) || intersects(w, writes[j]) || intersects(r, writes[j])))
+                level = prevLevel + 1;
+        }
+
+        levels[ld.id] = level;
+        ids.push_back(ld.id);
+        reads.push_back(r);
+        writes.push_back(w);
+        if ((int)layersSchedule.size() <= level)
+            layersSchedule.resize(level + 1);
+        layersSchedule[level].push_back(ld.id);
+    }
+}
+
+
+void Net::Impl::forwardScheduledLayers(const LayerData& lastLayer)
+{
+    CV_TRACE_FUNCTION();
+
+    std::vector<LayerData*> level;
+    for (size_t l = 0; l < layersSchedule.size(); l++)
+    {
+        level.clear();
+        const std::vector<int>& ids = layersSchedule[l];
+        for (size_t i = 0; i < ids.size() && ids[i] <= lastLayer.id; i++)
+        {
+            LayerData& ld = layers[ids[i]];
+            if (ld.flag)
+                continue;
+            if (ld.skip)
+                forwardLayer(ld);  // nothing to compute
+            else
+                level.push_back(&ld);
+        }
+
+        // Layers of the level run in parallel, the nested parallel loops of the layers
+        // are executed sequentially by the worker threads. A single layer gets all the threads.
+        if (level.size() == 1)
+            forwardLayer(*level[0]);
+        else if (!level.empty())
+            parallel_for_(Range(0, (int)level.size()), ForwardLayersInvoker(*this, level), (double)level.size());
+    }
+}
+
+
+CV__DNN_INLINE_NS_END
+}}  // namespace cv::dnn
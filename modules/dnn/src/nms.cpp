@@ -9,6 +9,7 @@
 #include "nms.inl.hpp"
 
 #include <opencv2/imgproc.hpp>
+#include <opencv2/core/hal/intrin.hpp>
 
 namespace cv { namespace dnn {
 CV__DNN_INLINE_NS_BEGIN
@@ -190,6 +191,449 @@ void softNMSBoxes(const std::vector<Rect>& bboxes,
     }
 }
 
+namespace {
+
+// score and row of the box
+typedef std::pair<float, int> ScoreIndex;
+
+static inline bool greaterScore(const ScoreIndex& a, const ScoreIndex& b)
+{
+    return a.first > b.first || (a.first == b.first && a.second < b.second);
+}
+
+// Boxes of the multi-class NMS: axis-aligned boxes (x, y, width, height) or
+// rotated boxes (center x, center y, width, height, angle), one box per row
+struct MultiClassNMSBoxes
+{
+    Mat boxes;
+    Mat scores;
+    bool rotated;
+
+    MultiClassNMSBoxes(InputArray _bboxes, InputArray _scores)
+    {
+        Mat b = _bboxes.getMat(), s = _scores.getMat();
+        // [1 x N x K] outputs of the detection heads are accepted as well
+        if (b.dims == 3 && b.size[0] == 1)
+            b = b.reshape(1, b.size[1]);
+        if (s.dims == 3 && s.size[0] == 1)
+            s = s.reshape(1, s.size[1]);
+        CV_CheckTypeEQ(b.type(), CV_32FC1, "DNN/NMS: boxes must be a CV_32FC1 matrix");
+        CV_CheckEQ(b.dims, 2, "");
+        if (s.empty())
+        {
+            CV_CheckGT(b.cols, 4, "DNN/NMS: boxes must contain the class scores, if the scores are not passed");
+            s = b.colRange(4, b.cols);
+            b = b.colRange(0, 4);
+        }
+        CV_CheckTypeEQ(s.type(), CV_32FC1, "DNN/NMS: scores must be a CV_32FC1 matrix");
+        CV_CheckEQ(s.dims, 2, "");
+        CV_CheckEQ(s.rows, b.rows, "DNN/NMS: number of the boxes and the scores must be equal");
+        CV_Check(b.cols, b.cols == 4 || b.cols == 5, "DNN/NMS: boxes must have 4 (axis-aligned) or 5 (rotated) columns");
+        boxes = b;
+        scores = s;
+        rotated = b.cols == 5;
+    }
+
+    RotatedRect rotatedRect(int i) const
+    {
+        const float* b = boxes.ptr<float>(i);
+        return RotatedRect(Point2f(b[0], b[1]), Size2f(b[2], b[3]), b[4]);
+    }
+};
+
+// Collects the candidates of each class: the boxes with scores above the threshold.
+// The rows are split into stripes, the candidates of a stripe go to its own lists.
+class NMSCandidatesCollector : public ParallelLoopBody
+{
+public:
+    NMSCandidatesCollector(const Mat& _scores, float _threshold, bool _multiLabel, int _nstripes,
+                           std::vector<std::vector<std::vector<ScoreIndex> > >& _candidates)
+        : scores(_scores), threshold(_threshold), multiLabel(_multiLabel), nstripes(_nstripes),
+          candidates(_candidates)
+    {
+        candidates.resize(nstripes);
+    }
+
+    void operator()(const Range& r) const CV_OVERRIDE
+    {
+        int N = scores.rows, C = scores.cols;
+        for (int s = r.start; s < r.end; s++)
+        {
+            std::vector<std::vector<ScoreIndex> >& cand = candidates[s];
+            cand.resize(C);
+            int i0 = (int)((int64)N*s/nstripes), i1 = (int)((int64)N*(s + 1)/nstripes);
+            for (int i = i0; i < i1; i++)
+            {
+                const float* sptr = scores.ptr<float>(i);
+                int j = 0;
+                if (multiLabel)
+                {
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+                    const int vlanes = VTraits<v_float32>::vlanes();
+                    v_float32 vthr = vx_setall_f32(threshold);
+                    for (; j <= C - vlanes; j += vlanes)
+                    {
+                        if (!v_check_any(v_gt(vx_load(sptr + j), vthr)))
+                            continue;
+                        for (int k = j; k < j + vlanes; k++)
+                            if (sptr[k] > threshold)
+                                cand[k].push_back(ScoreIndex(sptr[k], i));
+                    }
+#endif
+                    for (; j < C; j++)
+                        if (sptr[j] > threshold)
+                            cand[j].push_back(ScoreIndex(sptr[j], i));
+                }
+                else
+                {
+                    float maxScore = -FLT_MAX;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+                    const int vlanes = VTraits<v_float32>::vlanes();
+                    if (C >= vlanes)
+                    {
+                        v_float32 vmax = vx_load(sptr);
+                        for (j = vlanes; j <= C - vlanes; j += vlanes)
+                            vmax = v_max(vmax, vx_load(sptr + j));
+                        maxScore = v_reduce_max(vmax);
+                    }
+#endif
+                    for (; j < C; j++)
+                        maxScore = std::max(maxScore, sptr[j]);
+                    // most of the boxes are rejected without searching for the best class
+                    if (maxScore > threshold)
+                    {
+                        int best = (int)(std::find(sptr, sptr + C, maxScore) - sptr);
+                        cand[best].push_back(ScoreIndex(maxScore, i));
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    const Mat& scores;
+    float threshold;
+    bool multiLabel;
+    int nstripes;
+    std::vector<std::vector<std::vector<ScoreIndex> > >& candidates;
+};
+
+// Returns the candidates of each class sorted by score (at most top_k of them if top_k > 0)
+static void collectNMSCandidates(const Mat& scores, float threshold, bool multiLabel, int top_k,
+                                 std::vector<std::vector<ScoreIndex> >& candidates)
+{
+    int C = scores.cols;
+    int nstripes = std::max(std::min(getNumThreads(), (int)(scores.total() / (1 << 14))), 1);
+    std::vector<std::vector<std::vector<ScoreIndex> > > stripeCandidates;
+    parallel_for_(Range(0, nstripes), NMSCandidatesCollector(scores, threshold, multiLabel, nstripes, stripeCandidates));
+
+    candidates.assign(C, std::vector<ScoreIndex>());
+    for (int c = 0; c < C; c++)
+    {
+        std::vector<ScoreIndex>& cand = candidates[c];
+        for (int s = 0; s < nstripes; s++)
+            cand.insert(cand.end(), stripeCandidates[s][c].begin(), stripeCandidates[s][c].end());
+        if (top_k > 0 && (size_t)top_k < cand.size())
+        {
+            std::partial_sort(cand.begin(), cand.begin() + top_k, cand.end(), greaterScore);
+            cand.resize(top_k);
+        }
+        else
+            std::sort(cand.begin(), cand.end(), greaterScore);
+    }
+}
+
+// Boxes in the structure-of-arrays form for the vectorized computation of the overlaps.
+// For the rotated boxes these are the bounding boxes.
+struct NMSBoxesSoA
+{
+    AutoBuffer<float> buf;
+    float *x1, *y1, *x2, *y2, *area;
+    int n;
+
+    explicit NMSBoxesSoA(int capacity) : buf(capacity*5 + 1), n(0)
+    {
+        x1 = buf.data(); y1 = x1 + capacity; x2 = y1 + capacity; y2 = x2 + capacity; area = y2 + capacity;
+    }
+
+    void push_back(const Rect2f& r)
+    {
+        x1[n] = r.x; y1[n] = r.y; x2[n] = r.x + r.width; y2[n] = r.y + r.height;
+        area[n] = r.width*r.height;
+        n++;
+    }
+
+    void swap(int i, int j)
+    {
+        std::swap(x1[i], x1[j]); std::swap(y1[i], y1[j]);
+        std::swap(x2[i], x2[j]); std::swap(y2[i], y2[j]);
+        std::swap(area[i], area[j]);
+    }
+
+    // Computes IoU of the box r with the boxes [start, end). The overlap of empty boxes is 1 as in rectOverlap().
+    void computeIoU(const Rect2f& r, int start, int end, float* iou) const
+    {
+        float rx1 = r.x, ry1 = r.y, rx2 = r.x + r.width, ry2 = r.y + r.height, rarea = r.width*r.height;
+        int j = start;
+#if (CV_SIMD || CV_SIMD_SCALABLE)
+        const int vlanes = VTraits<v_float32>::vlanes();
+        v_float32 vx1 = vx_setall_f32(rx1), vy1 = vx_setall_f32(ry1);
+        v_float32 vx2 = vx_setall_f32(rx2), vy2 = vx_setall_f32(ry2);
+        v_float32 varea = vx_setall_f32(rarea), z = vx_setzero_f32(), one = vx_setall_f32(1.f);
+        v_float32 eps = vx_setall_f32(FLT_EPSILON);
+        for (; j <= end - vlanes; j += vlanes)
+        {
+            v_float32 w = v_max(v_sub(v_min(vx2, vx_load(x2 + j)), v_max(vx1, vx_load(x1 + j))), z);
+            v_float32 h = v_max(v_sub(v_min(vy2, vx_load(y2 + j)), v_max(vy1, vx_load(y1 + j))), z);
+            v_float32 inter = v_mul(w, h);
+            v_float32 sum = v_add(varea, vx_load(area + j));
+            v_float32 res = v_div(inter, v_max(v_sub(sum, inter), eps));
+            v_store(iou + j - start, v_select(v_le(sum, eps), one, res));
+        }
+#endif
+        for (; j < end; j++)
+        {
+            float w = std::max(std::min(rx2, x2[j]) - std::max(rx1, x1[j]), 0.f);
+            float h = std::max(std::min(ry2, y2[j]) - std::max(ry1, y1[j]), 0.f);
+            float inter = w*h, sum = rarea + area[j];
+            iou[j - start] = sum <= FLT_EPSILON ? 1.f : inter / std::max(sum - inter, FLT_EPSILON);
+        }
+    }
+};
+
+// The overlaps with the kept boxes are computed by tiles of this size,
+// so the loop stops soon after the first suppressing box
+enum { NMS_TILE_SIZE = 64 };
+
+// Greedy NMS of the sorted candidates of one class, same as NMSFast_().
+// Returns the positions of the kept candidates.
+static void multiClassNMS_(const MultiClassNMSBoxes& data, const std::vector<ScoreIndex>& cand,
+                           float nms_threshold, float eta, std::vector<int>& keep)
+{
+    int n = (int)cand.size();
+    NMSBoxesSoA kept(n);
+    std::vector<RotatedRect> keptRotated;
+    float iou[NMS_TILE_SIZE];
+    float adaptive_threshold = nms_threshold;
+    keep.clear();
+
+    for (int i = 0; i < n; i++)
+    {
+        int idx = cand[i].second;
+        RotatedRect rr;
+        Rect2f r;
+        if (data.rotated)
+        {
+            rr = data.rotatedRect(idx);
+            r = rr.boundingRect2f();
+        }
+        else
+        {
+            const float* b = data.boxes.ptr<float>(idx);
+            r = Rect2f(b[0], b[1], b[2], b[3]);
+        }
+
+        bool keep_i = true;
+        for (int k0 = 0; k0 < kept.n && keep_i; k0 += NMS_TILE_SIZE)
+        {
+            int k1 = std::min(k0 + NMS_TILE_SIZE, kept.n);
+            kept.computeIoU(r, k0, k1, iou);
+            for (int k = k0; k < k1 && keep_i; k++)
+            {
+                if (!data.rotated)
+                    keep_i = iou[k - k0] <= adaptive_threshold;
+                // for the rotated boxes the exact overlap is computed only if the bounding boxes intersect
+                else if (iou[k - k0] > 0)
+                    keep_i = rotatedRectIOU(rr, keptRotated[k]) <= adaptive_threshold;
+            }
+        }
+        if (keep_i)
+        {
+            keep.push_back(i);
+            kept.push_back(r);
+            if (data.rotated)
+                keptRotated.push_back(rr);
+            if (eta < 1 && adaptive_threshold > 0.5)
+                adaptive_threshold *= eta;
+        }
+    }
+}
+
+// Soft NMS of the candidates of one class, same as softNMSBoxes().
+// Returns the kept candidates with the updated scores.
+static void multiClassSoftNMS_(const MultiClassNMSBoxes& data, const std::vector<ScoreIndex>& cand,
+                               float score_threshold, float nms_threshold, size_t top_k, float sigma,
+                               SoftNMSMethod method, std::vector<ScoreIndex>& result)
+{
+    int n = (int)cand.size();
+    NMSBoxesSoA boxes(n);
+    std::vector<RotatedRect> rotated;
+    std::vector<ScoreIndex> sc(cand);
+    AutoBuffer<float> iou(n + 1);
+    for (int i = 0; i < n; i++)
+    {
+        if (data.rotated)
+        {
+            rotated.push_back(data.rotatedRect(cand[i].second));
+            boxes.push_back(rotated.back().boundingRect2f());
+        }
+        else
+        {
+            const float* b = data.boxes.ptr<float>(cand[i].second);
+            boxes.push_back(Rect2f(b[0], b[1], b[2], b[3]));
+        }
+    }
+
+    result.clear();
+    top_k = top_k == 0 ? (size_t)n : std::min(top_k, (size_t)n);
+    for (int start = 0; result.size() < top_k; start++)
+    {
+        int best = start;
+        for (int i = start + 1; i < n; i++)
+            if (greaterScore(sc[i], sc[best]))
+                best = i;
+        if (sc[best].first < score_threshold)
+            break;
+
+        std::swap(sc[start], sc[best]);
+        boxes.swap(start, best);
+        if (data.rotated)
+            std::swap(rotated[start], rotated[best]);
+        result.push_back(sc[start]);
+
+        Rect2f r(boxes.x1[start], boxes.y1[start], boxes.x2[start] - boxes.x1[start], boxes.y2[start] - boxes.y1[start]);
+        boxes.computeIoU(r, start + 1, n, iou.data());
+        for (int i = start + 1; i < n; i++)
+        {
+            float overlap = iou[i - start - 1];
+            if (overlap <= 0 || sc[i].first < score_threshold)
+                continue;
+            if (data.rotated)
+                overlap = rotatedRectIOU(rotated[start], rotated[i]);
+            if (method == SoftNMSMethod::SOFTNMS_LINEAR)
+            {
+                if (overlap > nms_threshold)
+                    sc[i].first *= 1.f - overlap;
+            }
+            else
+                sc[i].first *= std::exp(-(overlap * overlap) / sigma);
+        }
+    }
+}
+
+class MultiClassNMSInvoker : public ParallelLoopBody
+{
+public:
+    MultiClassNMSInvoker(const MultiClassNMSBoxes& _data, const std::vector<std::vector<ScoreIndex> >& _candidates,
+                         std::vector<std::vector<ScoreIndex> >& _results, bool _soft,
+                         float _score_threshold, float _nms_threshold, float _eta, size_t _top_k,
+                         float _sigma, SoftNMSMethod _method)
+        : data(_data), candidates(_candidates), results(_results), soft(_soft),
+          score_threshold(_score_threshold), nms_threshold(_nms_threshold), eta(_eta), top_k(_top_k),
+          sigma(_sigma), method(_method)
+    {
+        results.assign(candidates.size(), std::vector<ScoreIndex>());
+    }
+
+    void operator()(const Range& r) const CV_OVERRIDE
+    {
+        std::vector<int> keep;
+        for (int c = r.start; c < r.end; c++)
+        {
+            const std::vector<ScoreIndex>& cand = candidates[c];
+            if (cand.empty())
+                continue;
+            if (soft)
+                multiClassSoftNMS_(data, cand, score_threshold, nms_threshold, top_k, sigma, method, results[c]);
+            else
+            {
+                multiClassNMS_(data, cand, nms_threshold, eta, keep);
+                for (size_t i = 0; i < keep.size(); i++)
+                    results[c].push_back(cand[keep[i]]);
+            }
+        }
+    }
+
+private:
+    const MultiClassNMSBoxes& data;
+    const std::vector<std::vector<ScoreIndex> >& candidates;
+    std::vector<std::vector<ScoreIndex> >& results;
+    bool soft;
+    float score_threshold, nms_threshold, eta;
+    size_t top_k;
+    float sigma;
+    SoftNMSMethod method;
+};
+
+static void multiClassNMSImpl(InputArray bboxes, InputArray scores, bool soft,
+                              float score_threshold, float nms_threshold, float eta, size_t top_k,
+                              float sigma, SoftNMSMethod method, bool multi_label,
+                              std::vector<int>& indices, std::vector<int>& class_ids,
+                              std::vector<float>* updated_scores)
+{
+    CV_TRACE_FUNCTION();
+    MultiClassNMSBoxes data(bboxes, scores);
+    CV_CheckLE(top_k, (size_t)INT_MAX, "");
+
+    std::vector<std::vector<ScoreIndex> > candidates, results;
+    collectNMSCandidates(data.scores, score_threshold, multi_label, (int)top_k, candidates);
+
+    // the classes are processed in parallel, the work is balanced by the number of the candidates
+    size_t ncandidates = 0;
+    for (size_t c = 0; c < candidates.size(); c++)
+        ncandidates += candidates[c].size();
+    parallel_for_(Range(0, (int)candidates.size()),
+                  MultiClassNMSInvoker(data, candidates, results, soft, score_threshold,
+                                       nms_threshold, eta, top_k, sigma, method),
+                  ncandidates > 1000 ? (double)candidates.size() : 1.);
+
+    // (score, (class, row))
+    std::vector<std::pair<float, std::pair<int, int> > > kept;
+    for (size_t c = 0; c < results.size(); c++)
+        for (size_t i = 0; i < results[c].size(); i++)
+            kept.push_back(std::make_pair(results[c][i].first, std::make_pair((int)c, results[c][i].second)));
+    std::stable_sort(kept.begin(), kept.end(), SortScorePairDescend<std::pair<int, int> >);
+    if (top_k > 0 && top_k < kept.size())
+        kept.resize(top_k);
+
+    indices.resize(kept.size());
+    class_ids.resize(kept.size());
+    if (updated_scores)
+        updated_scores->resize(kept.size());
+    for (size_t i = 0; i < kept.size(); i++)
+    {
+        indices[i] = kept[i].second.second;
+        class_ids[i] = kept[i].second.first;
+        if (updated_scores)
+            (*updated_scores)[i] = kept[i].first;
+    }
+}
+
+} // namespace
+
+void NMSBoxesMultiClass(InputArray bboxes, InputArray scores,
+                        const float score_threshold, const float nms_threshold,
+                        std::vector<int>& indices, std::vector<int>& class_ids,
+                        const float eta, const int top_k, bool multi_label)
+{
+    CV_Assert_N(score_threshold >= 0, nms_threshold >= 0, eta > 0);
+    multiClassNMSImpl(bboxes, scores, false, score_threshold, nms_threshold, eta, (size_t)std::max(top_k, 0),
+                      0.f, SoftNMSMethod::SOFTNMS_GAUSSIAN, multi_label, indices, class_ids, 0);
+}
+
+void softNMSBoxesMultiClass(InputArray bboxes, InputArray scores,
+                            std::vector<float>& updated_scores,
+                            const float score_threshold, const float nms_threshold,
+                            std::vector<int>& indices, std::vector<int>& class_ids,
+                            size_t top_k, const float sigma, SoftNMSMethod method, bool multi_label)
+{
+    CV_Assert_N(score_threshold >= 0, nms_threshold >= 0, sigma >= 0);
+    CV_Check((int)method, method == SoftNMSMethod::SOFTNMS_LINEAR || method == SoftNMSMethod::SOFTNMS_GAUSSIAN,
+             "Not supported SoftNMS method.");
+    multiClassNMSImpl(bboxes, scores, true, score_threshold, nms_threshold, 1.f, top_k,
+                      sigma, method, multi_label, indices, class_ids, &updated_scores);
+}
+
 CV__DNN_INLINE_NS_END
 }// dnn
 }// cv
@@ -18,6 +18,8 @@
 #include <opencv2/core/utils/logger.hpp>
 
 #include <opencv2/core/utils/configuration.private.hpp>
+#include <opencv2/core/utils/filesystem.hpp>
+#include <opencv2/core/utils/filesystem.private.hpp>
 
 
 #ifdef HAVE_PROTOBUF
@@ -39,6 +41,7 @@
 #pragma GCC diagnostic ignored "-Wsuggest-override"
 #endif
 #include "opencv-onnx.pb.h"
+#include <google/protobuf/unknown_field_set.h>
 #if defined(__GNUC__) && __GNUC__ >= 5
 #pragma GCC diagnostic pop
 #endif
@@ -82,6 +85,7 @@ class ONNXImporter
 
     std::map<std::string, Mat> getGraphTensors(
                                     const opencv_onnx::GraphProto& graph_proto);
+    void loadExternalData(opencv_onnx::GraphProto& graph_proto);
     Mat getBlob(const opencv_onnx::NodeProto& node_proto, int index);
     Mat getBlob(const std::string& input_name);
     TensorInfo getBlobExtraInfo(const opencv_onnx::NodeProto& node_proto, int index);
@@ -119,6 +123,12 @@ protected:
     std::map<std::string, Mat> constBlobs;
     std::map<std::string, TensorInfo> constBlobsExtraInfo;
 
+    // External data of the tensors (see loadExternalData())
+    bool hasModelPath;
+    std::string modelDir;  // the locations of the external data are relative to the model directory
+    std::map<std::string, std::shared_ptr<void> > externalDataFiles;  // mapped files by location
+    std::map<std::string, Mat> externalTensors;  // initializers mapped without copying
+
     std::map<std::string, MatShape> outShapes;  // List of internal blobs shapes.
     bool hasDynamicShapes;  // Whether the model has inputs with dynamic shapes
     typedef std::map<std::string, MatShape>::iterator IterShape_t;
@@ -270,6 +280,8 @@ ONNXImporter::ONNXImporter(Net& net, const char *onnxFile)
     hasDynamicShapes = false;
     CV_Assert(onnxFile);
     CV_LOG_DEBUG(NULL, "DNN/ONNX: processing ONNX model from file: " << onnxFile);
+    hasModelPath = true;
+    modelDir = utils::fs::getParent(onnxFile);
 
     std::fstream input(onnxFile, std::ios::in | std::ios::binary);
     if (!input)
@@ -293,6 +305,7 @@ ONNXImporter::ONNXImporter(Net& net, const char* buffer, size_t sizeBuffer)
 {
     hasDynamicShapes = false;
     CV_LOG_DEBUG(NULL, "DNN/ONNX: processing in-memory ONNX model (" << sizeBuffer << " bytes)");
+    hasModelPath = false;
 
     struct _Buf : public std::streambuf
             {
@@ -417,7 +430,8 @@ std::map<std::string, Mat> ONNXImporter::getGraphTensors(
     {
         const opencv_onnx::TensorProto& tensor_proto = graph_proto.initializer(i);
         dumpTensorProto(i, tensor_proto, "initializer");
-        Mat mat = getMatFromTensor(tensor_proto);
+        std::map<std::string, Mat>::const_iterator external = externalTensors.find(tensor_proto.name());
+        Mat mat = external != externalTensors.end() ? external->second : getMatFromTensor(tensor_proto);
         releaseONNXTensor(const_cast<opencv_onnx::TensorProto&>(tensor_proto));  // drop already loaded data
 
         if (DNN_DIAGNOSTICS_RUN && mat.empty())
@@ -429,6 +443,115 @@ std::map<std::string, Mat> ONNXImporter::getGraphTensors(
     return layers_weights;
 }
 
+// Returns true if the data of the tensor is stored in an external file, fills the external data properties
+// (location, offset, length). The vendored protobuf code was generated from the description without
+// TensorProto.external_data (13) and TensorProto.data_location (14) fields, so they are parsed from the unknown fields.
+static bool getExternalDataInfo(const opencv_onnx::TensorProto& tensor_proto, std::map<std::string, std::string>& info)
+{
+    enum { FIELD_EXTERNAL_DATA = 13, FIELD_DATA_LOCATION = 14, DATA_LOCATION_EXTERNAL = 1 };
+
+    info.clear();
+    bool external = false;
+    const ::google::protobuf::UnknownFieldSet& fields = tensor_proto.GetReflection()->GetUnknownFields(tensor_proto);
+    for (int i = 0; i < fields.field_count(); i++)
+    {
+        const ::google::protobuf::UnknownField& field = fields.field(i);
+        if (field.number() == FIELD_DATA_LOCATION && field.type() == ::google::protobuf::UnknownField::TYPE_VARINT)
+        {
+            external = field.varint() == DATA_LOCATION_EXTERNAL;
+        }
+        else if (field.number() == FIELD_EXTERNAL_DATA && field.type() == ::google::protobuf::UnknownField::TYPE_LENGTH_DELIMITED)
+        {
+            opencv_onnx::StringStringEntryProto entry;
+            if (!entry.ParseFromString(field.length_delimited()))
+                CV_Error(Error::StsUnsupportedFormat, "DNN/ONNX: can't parse external data of tensor: " + tensor_proto.name());
+            info[entry.key()] = entry.value();
+        }
+    }
+    return external;
+}
+
+// Tensors with external data: the data files are memory-mapped (once per file). The tensors of the types
+// stored as is (float, int32, int8) are wrapped into read-only Mats over the mapped memory without copying,
+// the data pages are loaded on demand and shared with the OS page cache. The other tensors
+// (which are converted on loading anyway) and the small ones (constants used by the graph simplifier)
+// get their data copied into raw_data.
+void ONNXImporter::loadExternalData(opencv_onnx::GraphProto& graph_proto)
+{
+    const size_t inlineSizeThreshold = 4096;
+    std::map<std::string, std::string> info;
+    for (int i = 0; i < graph_proto.initializer_size(); i++)
+    {
+        opencv_onnx::TensorProto& tensor_proto = *graph_proto.mutable_initializer(i);
+        if (!getExternalDataInfo(tensor_proto, info))
+            continue;
+
+        const std::string& name = tensor_proto.name();
+        const std::string location = info["location"];
+        if (location.empty())
+            CV_Error(Error::StsUnsupportedFormat, "DNN/ONNX: no location of external data of tensor: " + name);
+        if (!hasModelPath)
+            CV_Error(Error::StsNotImplemented, "DNN/ONNX: external data of tensor '" + name + "' requires the model "
+                                               "to be loaded from file (the location is relative to the model directory)");
+        if (location[0] == '/' || location[0] == '\\' || location.find(':') != std::string::npos ||
+            location.find("..") != std::string::npos)
+            CV_Error(Error::StsBadArg, "DNN/ONNX: invalid location of external data of tensor '" + name + "': " + location);
+
+#if OPENCV_HAVE_FILESYSTEM_SUPPORT
+        std::shared_ptr<void>& owner = externalDataFiles[location];
+        if (!owner)
+        {
+            const std::string path = utils::fs::join(modelDir, location);
+            std::shared_ptr<utils::fs::MappedFile> file = std::make_shared<utils::fs::MappedFile>(path.c_str());
+            if (!file->isOpened())
+                CV_Error(Error::StsError, "DNN/ONNX: can't map external data file: " + path);
+            owner = file;
+        }
+        const utils::fs::MappedFile& file = *std::static_pointer_cast<utils::fs::MappedFile>(owner);
+
+        size_t offset = info.count("offset") ? (size_t)std::stoull(info["offset"]) : 0;
+        CV_CheckLE(offset, file.size(), "DNN/ONNX: external data offset is out of the file");
+        size_t length = info.count("length") ? (size_t)std::stoull(info["length"]) : file.size() - offset;
+        CV_CheckLE(length, file.size() - offset, "DNN/ONNX: external data is out of the file");
+        const uchar* data = file.data() + offset;
+
+        std::vector<int> sizes;
+        size_t total = 1;
+        for (int j = 0; j < tensor_proto.dims_size(); j++)
+        {
+            sizes.push_back((int)tensor_proto.dims(j));
+            total *= (size_t)tensor_proto.dims(j);
+        }
+        if (sizes.empty())
+            sizes.assign(1, 1);
+
+        int type = -1;
+        switch (tensor_proto.data_type())
+        {
+        case opencv_onnx::TensorProto_DataType_FLOAT: type = CV_32F; break;
+        case opencv_onnx::TensorProto_DataType_INT32: type = CV_32S; break;
+        case opencv_onnx::TensorProto_DataType_INT8: type = CV_8S; break;
+        default: break;
+        }
+        if (type >= 0 && length >= inlineSizeThreshold && ((size_t)data % CV_ELEM_SIZE(type)) == 0)
+        {
+            CV_CheckEQ(length, total * CV_ELEM_SIZE(type), "DNN/ONNX: size of external data doesn't match the tensor shape");
+            Mat mat = wrapExternalMemory(owner, data, sizes, type);
+            if (tensor_proto.dims_size() == 0)
+                mat.dims = 1;  // To force 1-dimensional cv::Mat for scalars.
+            externalTensors[name] = mat;
+        }
+        else
+        {
+            tensor_proto.set_raw_data(data, length);
+        }
+        tensor_proto.GetReflection()->MutableUnknownFields(&tensor_proto)->Clear();
+#else
+        CV_Error(Error::StsNotImplemented, "DNN/ONNX: external data is not supported on this platform");
+#endif
+    }
+}
+
 static DictValue parse(const ::google::protobuf::RepeatedField< ::google::protobuf::int64>& src) {
     std::vector<int32_t> dst(src.size());
     convertInt64ToInt32(src, dst, src.size());
@@ -810,6 +933,7 @@ void ONNXImporter::populateNet()
 
     parseOperatorSet();
 
+    loadExternalData(*graph_proto);
     simplifySubgraphs(*graph_proto);
 
     const int layersSize = graph_proto->node_size();
@@ -64,6 +64,9 @@ private:
         bool haveBackendCPU_FP16 = false;
 #if defined(__arm64__) && __arm64__
         haveBackendCPU_FP16 = true;
+#else
+        // FP16 storage of the weights, the conversions to FP32 are fast with F16C
+        haveBackendCPU_FP16 = checkHardwareSupport(CPU_FP16);
 #endif
 
         if (haveBackendOpenVINO && openvino::checkTarget(DNN_TARGET_CPU))
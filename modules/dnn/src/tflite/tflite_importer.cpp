@@ -9,6 +9,9 @@
 #include "builtin_op_data.h"
 #endif
 
+#include <opencv2/core/utils/filesystem.hpp>
+#include <opencv2/core/utils/filesystem.private.hpp>
+
 #include <opencv2/core/utils/logger.defines.hpp>
 #undef CV_LOG_STRIP_LEVEL
 #define CV_LOG_STRIP_LEVEL CV_LOG_LEVEL_VERBOSE + 1
@@ -24,9 +27,12 @@ using namespace opencv_tflite;
 
 class TFLiteImporter {
 public:
-    TFLiteImporter(Net& net, const char* modelBuffer, size_t bufSize);
+    // The constant tensors of the model owned by modelOwner (e.g. a mapped file) are used without copying
+    TFLiteImporter(Net& net, const char* modelBuffer, size_t bufSize,
+                   const std::shared_ptr<void>& modelOwner = std::shared_ptr<void>());
 
 private:
+    std::shared_ptr<void> modelOwner;
     const opencv_tflite::Model* model;
     const flatbuffers::Vector<flatbuffers::Offset<opencv_tflite::Tensor> >* modelTensors;
     std::map<int, Mat> allTensors;
@@ -41,7 +47,8 @@ private:
 
     void populateNet();
 
-    // Wrap TFLite Tensor to OpenCV Mat without data copying
+    // Wrap TFLite Tensor to OpenCV Mat without data copying.
+    // The data is read-only, the returned Mat owns it (Mat::u is set) if the model buffer is owned by modelOwner.
     Mat parseTensor(const Tensor& tensor);
 
     typedef void (TFLiteImporter::*TFLiteImporterNodeParser)(const Operator&, const std::string&, LayerParams&);
@@ -117,11 +124,16 @@ Mat TFLiteImporter::parseTensor(const Tensor& tensor)
     default:
         CV_Error(Error::StsNotImplemented, format("Parse tensor with type %s", EnumNameTensorType(tensor.type())));
     }
-    return shape.empty() ? Mat() : Mat(shape, dtype, const_cast<void*>(data));
+    if (shape.empty())
+        return Mat();
+    if (modelOwner && (size_t)data % CV_ELEM_SIZE(dtype) == 0)
+        return detail::wrapExternalMemory(modelOwner, data, shape, dtype);
+    return Mat(shape, dtype, const_cast<void*>(data));
 }
 
-TFLiteImporter::TFLiteImporter(Net& dstNet, const char* modelBuffer, size_t bufSize)
-    : dstNet(dstNet), dispatch(buildDispatchMap())
+TFLiteImporter::TFLiteImporter(Net& dstNet, const char* modelBuffer, size_t bufSize,
+                               const std::shared_ptr<void>& modelOwner)
+    : modelOwner(modelOwner), dstNet(dstNet), dispatch(buildDispatchMap())
 {
     flatbuffers::Verifier verifier((const uint8_t*)modelBuffer, bufSize);
     if (!VerifyModelBuffer(verifier)) {
@@ -398,7 +410,7 @@ void TFLiteImporter::parseConvolution(const Operator& op, const std::string& opc
     layerParams.blobs.resize(1 + (int)hasBias + (int)isInt8);
     if (hasBias) {
         Mat bias = allTensors[op.inputs()->Get(2)];
-        layerParams.blobs[1] = bias.u ? bias : bias.clone();
+        layerParams.blobs[1] = bias.u && !isInt8 ? bias : bias.clone();  // INT8 bias is modified below
     }
 
     // Reorder filter data from OHWI to OIHW and change shape correspondingly.
@@ -461,7 +473,7 @@ void TFLiteImporter::parseDWConvolution(const Operator& op, const std::string& o
     layerParams.blobs.resize(1 + (int)hasBias + (int)isInt8);
     if (hasBias) {
         Mat bias = allTensors[op.inputs()->Get(2)];
-        layerParams.blobs[1] = bias.u ? bias : bias.clone();
+        layerParams.blobs[1] = bias.u && !isInt8 ? bias : bias.clone();  // INT8 bias is modified below
     }
 
     transposeND(filter, {3, 0, 1, 2}, layerParams.blobs[0]);
@@ -868,11 +880,11 @@ void TFLiteImporter::parseDeconvolution(const Operator& op, const std::string& o
     }
 
     // Reorder filter data from OHWI to IOHW and change shape correspondingly.
-    filter = allTensors[filterIdx] = filter.reshape(1, {ic, oc, kh, kw});
-
+    // The source may be read-only (mapped model file), so the result is written to a new buffer.
     CV_CheckTypeEQ(filter.type(), CV_32F, "");
-    Mat filterCopy = filter.clone();
-    float* data = filterCopy.ptr<float>();
+    const Mat filterSrc = filter;
+    filter = allTensors[filterIdx] = Mat({ic, oc, kh, kw}, CV_32F);
+    const float* data = filterSrc.ptr<float>();
     float* dstData = filter.ptr<float>();
 
     int total = oc * ic * kh * kw;
@@ -1129,6 +1141,17 @@ void TFLiteImporter::getQuantParams(const Operator& op, float& inpScale, int& in
 Net readNetFromTFLite(const String &modelPath) {
     Net net;
 
+#if OPENCV_HAVE_FILESYSTEM_SUPPORT
+    // The flatbuffer is accessed in place: the constant tensors are wrapped into the network
+    // without copying and share the pages of the mapped file.
+    std::shared_ptr<utils::fs::MappedFile> file = std::make_shared<utils::fs::MappedFile>(modelPath.c_str());
+    if (file->isOpened() && file->size() > 0)
+    {
+        TFLiteImporter(net, (const char*)file->data(), file->size(), file);
+        return net;
+    }
+#endif
+
     std::vector<char> content;
 
     const std::ios::openmode mode = std::ios::in | std::ios::binary;
@@ -160,6 +160,68 @@ TEST_P(Test_Int8_layers, Convolution3D)
     testLayer("conv3d_bias", "ONNX", 0.00129, 0.00249);
 }
 
+// Compares the quantized convolutions with the float ones on synthetic data: blocked kernel with incomplete
+// strips of the output channels, several blocks of the input channels, depth-wise kernels of various sizes
+TEST_P(Test_Int8_layers, Convolution_packed)
+{
+    if (backend != DNN_BACKEND_OPENCV)
+        throw SkipTestException("Only OpenCV backend is supported");
+
+    struct ConvParams { int inpCn, outCn, group, kernel, stride, pad, dilation; };
+    const ConvParams configs[] = {
+        {16, 13, 1, 3, 1, 1, 1},
+        {160, 24, 1, 3, 2, 1, 1},
+        {40, 70, 1, 1, 1, 0, 1},
+        {24, 24, 2, 3, 1, 2, 2},
+        {32, 32, 32, 3, 2, 1, 1},
+        {32, 32, 32, 5, 1, 2, 1},
+        {16, 16, 16, 7, 2, 3, 1},
+        {8, 8, 8, 3, 1, 2, 2},
+    };
+    RNG& rng = TS::ptr()->get_rng();
+    for (const ConvParams& cp : configs)
+    {
+        SCOPED_TRACE(cv::format("inpCn=%d outCn=%d group=%d kernel=%d stride=%d pad=%d dilation=%d",
+                                cp.inpCn, cp.outCn, cp.group, cp.kernel, cp.stride, cp.pad, cp.dilation));
+        LayerParams lp;
+        lp.type = "Convolution";
+        lp.name = "conv";
+        lp.set("num_output", cp.outCn);
+        lp.set("group", cp.group);
+        lp.set("kernel_size", cp.kernel);
+        lp.set("stride", cp.stride);
+        lp.set("pad", cp.pad);
+        lp.set("dilation", cp.dilation);
+        lp.set("bias_term", true);
+        int wshape[] = {cp.outCn, cp.inpCn / cp.group, cp.kernel, cp.kernel};
+        Mat weights(4, wshape, CV_32F), bias(1, cp.outCn, CV_32F);
+        rng.fill(weights, RNG::UNIFORM, -1, 1);
+        rng.fill(bias, RNG::UNIFORM, -1, 1);
+        lp.blobs.push_back(weights);
+        lp.blobs.push_back(bias);
+
+        Net net;
+        net.addLayerToPrev(lp.name, lp.type, lp);
+        LayerParams relu;
+        net.addLayerToPrev("relu", "ReLU", relu);
+
+        int ishape[] = {2, cp.inpCn, 19, 23};
+        Mat input(4, ishape, CV_32F);
+        rng.fill(input, RNG::UNIFORM, -1, 1);
+        net.setInput(input);
+        Mat ref = net.forward().clone();
+
+        Net qnet = net.quantize(input, CV_32F, CV_32F);
+        qnet.setPreferableBackend(backend);
+        qnet.setPreferableTarget(target);
+        qnet.setInput(input);
+        Mat out = qnet.forward();
+
+        double maxval = cvtest::norm(ref, NORM_INF);
+        normAssert(ref, out, "", 0.01 * maxval, 0.04 * maxval);
+    }
+}
+
 TEST_P(Test_Int8_layers, Flatten)
 {
     testLayer("flatten", "TensorFlow", 0.0036, 0.0069, 1, 1, false, true, true);
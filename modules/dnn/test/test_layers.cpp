@@ -724,6 +724,227 @@ TEST(Layer_LSTM_Test_Accuracy_, Reverse)
     EXPECT_NEAR(std::tanh(2e-5f), data[1], 1e-10);
 }
 
+static float sigmoidRef(float x) { return 1.f / (1.f + std::exp(-x)); }
+
+TEST(Layer_LSTM_Test_Accuracy_, Bidirectional)
+{
+    const int T = 7, N = 3, I = 11, H = 17, D = 2;
+    RNG& rng = TS::ptr()->get_rng();
+    Mat Wh(D * 4 * H, H, CV_32F), Wx(D * 4 * H, I, CV_32F), b(1, D * 4 * H, CV_32F);
+    Mat h0(D * N, H, CV_32F), c0(D * N, H, CV_32F);
+    int inpShape[] = {T, N, I};
+    Mat inp(3, inpShape, CV_32F);
+    rng.fill(Wh, RNG::UNIFORM, -0.5, 0.5);
+    rng.fill(Wx, RNG::UNIFORM, -0.5, 0.5);
+    rng.fill(b, RNG::UNIFORM, -0.5, 0.5);
+    rng.fill(h0, RNG::UNIFORM, -1, 1);
+    rng.fill(c0, RNG::UNIFORM, -1, 1);
+    rng.fill(inp, RNG::UNIFORM, -1, 1);
+
+    LayerParams lp;
+    lp.set("bidirectional", true);
+    lp.blobs.push_back(Wh);
+    lp.blobs.push_back(Wx);
+    lp.blobs.push_back(b);
+    lp.blobs.push_back(h0);
+    lp.blobs.push_back(c0);
+    Ptr<LSTMLayer> layer = LSTMLayer::create(lp);
+
+    std::vector<Mat> inputs(1, inp), outputs;
+    runLayer(layer, inputs, outputs);
+    ASSERT_EQ(1u, outputs.size());
+    ASSERT_EQ(shape(T, N, D * H), shape(outputs[0]));
+
+    int outShape[] = {T, N, D * H};
+    Mat ref(3, outShape, CV_32F);
+    for (int d = 0; d < D; d++)
+    {
+        Mat h = h0.rowRange(d * N, (d + 1) * N).clone(), c = c0.rowRange(d * N, (d + 1) * N).clone();
+        for (int k = 0; k < T; k++)
+        {
+            int t = d == 0 ? k : T - 1 - k;
+            for (int n = 0; n < N; n++)
+            {
+                Mat x = Mat(1, I, CV_32F, inp.ptr<float>(t, n));
+                Mat gates = x * Wx.rowRange(d * 4 * H, (d + 1) * 4 * H).t()
+                          + h.row(n) * Wh.rowRange(d * 4 * H, (d + 1) * 4 * H).t()
+                          + b.colRange(d * 4 * H, (d + 1) * 4 * H);
+                for (int j = 0; j < H; j++)
+                {
+                    float i_t = sigmoidRef(gates.at<float>(j));
+                    float f_t = sigmoidRef(gates.at<float>(H + j));
+                    float o_t = sigmoidRef(gates.at<float>(2 * H + j));
+                    float g_t = std::tanh(gates.at<float>(3 * H + j));
+                    c.at<float>(n, j) = f_t * c.at<float>(n, j) + i_t * g_t;
+                    h.at<float>(n, j) = o_t * std::tanh(c.at<float>(n, j));
+                    ref.ptr<float>(t, n)[d * H + j] = h.at<float>(n, j);
+                }
+            }
+        }
+    }
+    normAssert(ref, outputs[0], "", 1e-5, 1e-4);
+}
+
+TEST(Layer_GRU_Test_Accuracy_, Bidirectional)
+{
+    const int T = 7, N = 3, I = 11, H = 17, D = 2;
+    RNG& rng = TS::ptr()->get_rng();
+    Mat Wh(D * 3 * H, H, CV_32F), Wx(D * 3 * H, I, CV_32F), b(1, D * 6 * H, CV_32F), h0(D * N, H, CV_32F);
+    int inpShape[] = {T, N, I};
+    Mat inp(3, inpShape, CV_32F);
+    rng.fill(Wh, RNG::UNIFORM, -0.5, 0.5);
+    rng.fill(Wx, RNG::UNIFORM, -0.5, 0.5);
+    rng.fill(b, RNG::UNIFORM, -0.5, 0.5);
+    rng.fill(h0, RNG::UNIFORM, -1, 1);
+    rng.fill(inp, RNG::UNIFORM, -1, 1);
+
+    LayerParams lp;
+    lp.set("bidirectional", true);
+    lp.blobs.push_back(Wh);
+    lp.blobs.push_back(Wx);
+    lp.blobs.push_back(b);
+    lp.blobs.push_back(h0);
+    Ptr<GRULayer> layer = GRULayer::create(lp);
+
+    std::vector<Mat> inputs(1, inp), outputs;
+    runLayer(layer, inputs, outputs);
+    ASSERT_EQ(1u, outputs.size());
+    ASSERT_EQ(shape(T, N, D * H), shape(outputs[0]));
+
+    int outShape[] = {T, N, D * H};
+    Mat ref(3, outShape, CV_32F);
+    for (int d = 0; d < D; d++)
+    {
+        Mat h = h0.rowRange(d * N, (d + 1) * N).clone();
+        const Mat bx = b.colRange(d * 6 * H, d * 6 * H + 3 * H), bh = b.colRange(d * 6 * H + 3 * H, (d + 1) * 6 * H);
+        for (int k = 0; k < T; k++)
+        {
+            int t = d == 0 ? k : T - 1 - k;
+            for (int n = 0; n < N; n++)
+            {
+                Mat x = Mat(1, I, CV_32F, inp.ptr<float>(t, n));
+                Mat gx = x * Wx.rowRange(d * 3 * H, (d + 1) * 3 * H).t() + bx;
+                Mat gh = h.row(n) * Wh.rowRange(d * 3 * H, (d + 1) * 3 * H).t() + bh;
+                for (int j = 0; j < H; j++)
+                {
+                    float z_t = sigmoidRef(gx.at<float>(j) + gh.at<float>(j));
+                    float r_t = sigmoidRef(gx.at<float>(H + j) + gh.at<float>(H + j));
+                    float n_t = std::tanh(gx.at<float>(2 * H + j) + r_t * gh.at<float>(2 * H + j));
+                    h.at<float>(n, j) = z_t * h.at<float>(n, j) + (1.f - z_t) * n_t;
+                    ref.ptr<float>(t, n)[d * H + j] = h.at<float>(n, j);
+                }
+            }
+        }
+    }
+    normAssert(ref, outputs[0], "", 1e-5, 1e-4);
+}
+
+
+// Computes the attention of [B, S, D] input with the naive softmax(Q * K^T / sqrt(H)) * V
+static Mat attentionRef(const Mat& inp, const Mat& weight, const Mat& bias, int numHeads, bool causal)
+{
+    const int B = inp.size[0], S = inp.size[1], D = inp.size[2], hidden = weight.cols / 3, H = hidden / numHeads;
+    int outShape[] = {B, S, hidden};
+    Mat out(3, outShape, CV_32F);
+    for (int b = 0; b < B; b++)
+    {
+        Mat x(S, D, CV_32F, (void*)inp.ptr<float>(b));
+        Mat qkv = x * weight + repeat(bias.reshape(1, 1), S, 1);
+        for (int h = 0; h < numHeads; h++)
+        {
+            Mat q = qkv.colRange(h * H, (h + 1) * H);
+            Mat k = qkv.colRange(hidden + h * H, hidden + (h + 1) * H);
+            Mat v = qkv.colRange(2 * hidden + h * H, 2 * hidden + (h + 1) * H);
+            Mat scores = q * k.t() / std::sqrt((float)H);
+            for (int i = 0; i < S; i++)
+            {
+                float* s = scores.ptr<float>(i);
+                const int len = causal ? i + 1 : S;
+                float m = *std::max_element(s, s + len), sum = 0.f;
+                for (int j = 0; j < S; j++)
+                {
+                    s[j] = j < len ? std::exp(s[j] - m) : 0.f;
+                    sum += s[j];
+                }
+                for (int j = 0; j < S; j++)
+                    s[j] /= sum;
+            }
+            Mat o = scores * v;
+            for (int i = 0; i < S; i++)
+                o.row(i).copyTo(Mat(1, H, CV_32F, out.ptr<float>(b, i) + h * H));
+        }
+    }
+    return out;
+}
+
+typedef testing::TestWithParam<bool> Layer_Attention_Test;
+TEST_P(Layer_Attention_Test, Accuracy)
+{
+    const bool causal = GetParam();
+    // the sequence is longer than a block of the keys
+    const int B = 2, S = 300, D = 32, numHeads = 2;
+    RNG& rng = TS::ptr()->get_rng();
+    int inpShape[] = {B, S, D};
+    Mat inp(3, inpShape, CV_32F), weight(D, 3 * D, CV_32F), bias(1, 3 * D, CV_32F);
+    rng.fill(inp, RNG::UNIFORM, -1, 1);
+    rng.fill(weight, RNG::UNIFORM, -0.5, 0.5);
+    rng.fill(bias, RNG::UNIFORM, -0.5, 0.5);
+
+    LayerParams lp;
+    lp.set("num_heads", numHeads);
+    int qkvHiddenSizes[] = {D, D, D};
+    lp.set("qkv_hidden_sizes", DictValue::arrayInt(qkvHiddenSizes, 3));
+    lp.set("unidirectional", causal ? 1 : 0);
+    lp.blobs.push_back(weight);
+    lp.blobs.push_back(bias.reshape(1, 3 * D));
+    Ptr<AttentionLayer> layer = AttentionLayer::create(lp);
+
+    std::vector<Mat> inputs(1, inp), outputs;
+    runLayer(layer, inputs, outputs);
+    ASSERT_EQ(1u, outputs.size());
+    normAssert(attentionRef(inp, weight, bias, numHeads, causal), outputs[0], "", 1e-5, 1e-4);
+}
+
+INSTANTIATE_TEST_CASE_P(/**/, Layer_Attention_Test, testing::Bool());
+
+TEST(Layer_Attention_Test_, KVCache)
+{
+    const int S = 40, prefix = 13, D = 16, numHeads = 2;
+    RNG& rng = TS::ptr()->get_rng();
+    int inpShape[] = {1, S, D};
+    Mat inp(3, inpShape, CV_32F), weight(D, 3 * D, CV_32F), bias(1, 3 * D, CV_32F);
+    rng.fill(inp, RNG::UNIFORM, -1, 1);
+    rng.fill(weight, RNG::UNIFORM, -0.5, 0.5);
+    rng.fill(bias, RNG::UNIFORM, -0.5, 0.5);
+
+    LayerParams lp;
+    lp.set("num_heads", numHeads);
+    int qkvHiddenSizes[] = {D, D, D};
+    lp.set("qkv_hidden_sizes", DictValue::arrayInt(qkvHiddenSizes, 3));
+    lp.set("unidirectional", 1);
+    lp.blobs.push_back(weight);
+    lp.blobs.push_back(bias.reshape(1, 3 * D));
+    Ptr<AttentionLayer> layer = AttentionLayer::create(lp);
+    layer->setUseKVCache(true);
+
+    // the prefix at once, then token by token
+    Mat ref = attentionRef(inp, weight, bias, numHeads, true);
+    for (int iter = 0; iter < 2; iter++)
+    {
+        layer->resetKVCache();
+        for (int t = 0; t < S; )
+        {
+            const int len = t == 0 ? prefix : 1;
+            std::vector<Mat> inputs(1, inp(std::vector<Range>{Range::all(), Range(t, t + len), Range::all()}).clone()), outputs;
+            runLayer(layer, inputs, outputs);
+            t += len;
+            ASSERT_EQ(t, layer->getKVCacheLength());
+            Mat expected = ref(std::vector<Range>{Range::all(), Range(t - len, t), Range::all()});
+            normAssert(expected, outputs[0], cv::format("token %d", t).c_str(), 1e-5, 1e-4);
+        }
+    }
+}
+
 
 class Layer_RNN_Test : public ::testing::Test
 {
@@ -2788,4 +3009,157 @@ INSTANTIATE_TEST_CASE_P(TestLayerFusion, ConvolutionActivationEltwiseFusion, Com
                         TestLayerFusion::dnnBackendsAndTargetsForFusionTests()
 ));
 
+TEST(TestLayerFusion, MatMulBiasActivationResidual)
+{
+    //                 input
+    //                   |
+    //    -------------------------------
+    //    |                             |
+    //    |                     ----------------
+    //    |                     | matmul, bias |
+    //    |                     ----------------
+    //    |                             |
+    //    |                     ----------------
+    //    |                     |     gelu     |
+    //    |                     ----------------
+    //    |                             |
+    //    |                     ----------------
+    //    |                     | matmul, bias |
+    //    |                     ----------------
+    //    |                             |
+    //    |       ----------------      |
+    //    --------|     add      |-------
+    //            ----------------
+    //                   |
+
+    const int batch_size = 2, seq_len = 10, dim = 32, hidden = 64;
+    int inputShape[] = {batch_size, seq_len, dim};
+    Mat input(3, &inputShape[0], CV_32F);
+    randu(input, -1.0f, 1.0f);
+
+    Mat w1(dim, hidden, CV_32F), b1(hidden, 1, CV_32F), w2(hidden, dim, CV_32F), b2(dim, 1, CV_32F);
+    randu(w1, -0.2f, 0.2f);
+    randu(b1, -0.5f, 0.5f);
+    randu(w2, -0.2f, 0.2f);
+    randu(b2, -0.5f, 0.5f);
+
+    LayerParams fc1Params, geluParams, fc2Params, addParams;
+    fc1Params.set("real_ndims_C", 1);
+    fc1Params.blobs.push_back(w1);
+    fc1Params.blobs.push_back(b1);
+    fc2Params.set("real_ndims_C", 1);
+    fc2Params.blobs.push_back(w2);
+    fc2Params.blobs.push_back(b2);
+    addParams.set("operation", "add");
+
+    Net net;
+    int fc1Id = net.addLayerToPrev("fc1", "MatMul", fc1Params);
+    int geluId = net.addLayerToPrev("gelu", "Gelu", geluParams);
+    int fc2Id = net.addLayerToPrev("fc2", "MatMul", fc2Params);
+    int addId = net.addLayerToPrev("add", "NaryEltwise", addParams);
+    net.connect(0, 0, addId, 1);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(DNN_TARGET_CPU);
+
+    Mat x = input.reshape(1, batch_size * seq_len);
+    Mat h = x * w1 + repeat(b1.t(), x.rows, 1);
+    for (size_t i = 0; i < h.total(); i++)
+    {
+        float& v = h.ptr<float>()[i];
+        v = 0.5f * v * (1.f + std::erf(v * (float)M_SQRT1_2));
+    }
+    Mat ref = h * w2 + repeat(b2.t(), x.rows, 1) + x;
+    ref = ref.reshape(1, 3, &inputShape[0]);
+
+    net.enableFusion(false);
+    net.setInput(input);
+    Mat outputReference = net.forward().clone();
+    normAssert(ref, outputReference, "without fusion", 1e-5, 1e-4);
+
+    net.enableFusion(true);
+    net.setInput(input);
+    Mat outputTest = net.forward().clone();
+    normAssert(ref, outputTest, "with fusion", 1e-5, 1e-4);
+
+    std::vector<double> timings;
+    net.getPerfProfile(timings);
+    EXPECT_NE(timings[fc1Id - 1], 0.0);
+    EXPECT_EQ(timings[geluId - 1], 0.0);  // activation is fused with the first matmul
+    EXPECT_NE(timings[fc2Id - 1], 0.0);
+    EXPECT_EQ(timings[addId - 1], 0.0);  // residual is fused with the second matmul
+}
+
+TEST(TestLayerFusion, ResidualLayerNorm)
+{
+    //                 input
+    //                   |
+    //    -------------------------------
+    //    |                             |
+    //    |                     ----------------
+    //    |                     |   sigmoid    |
+    //    |                     ----------------
+    //    |                             |
+    //    |       ----------------      |
+    //    --------|     add      |-------
+    //            ----------------
+    //                   |
+    //            ----------------
+    //            |  layer norm  |
+    //            ----------------
+    //                   |
+
+    const int batch_size = 2, seq_len = 10, dim = 32;
+    const float epsilon = 1e-5f;
+    int inputShape[] = {batch_size, seq_len, dim};
+    Mat input(3, &inputShape[0], CV_32F);
+    randu(input, -1.0f, 1.0f);
+
+    Mat scale(dim, 1, CV_32F), bias(dim, 1, CV_32F);
+    randu(scale, 0.5f, 1.5f);
+    randu(bias, -0.5f, 0.5f);
+
+    LayerParams sigmoidParams, addParams, normParams;
+    addParams.set("operation", "add");
+    normParams.set("axis", 2);
+    normParams.set("epsilon", epsilon);
+    normParams.blobs.push_back(scale);
+    normParams.blobs.push_back(bias);
+
+    Net net;
+    net.addLayerToPrev("sigmoid", "Sigmoid", sigmoidParams);
+    int addId = net.addLayerToPrev("add", "NaryEltwise", addParams);
+    net.connect(0, 0, addId, 1);
+    int normId = net.addLayerToPrev("norm", "LayerNormalization", normParams);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.setPreferableTarget(DNN_TARGET_CPU);
+
+    Mat x = input.reshape(1, batch_size * seq_len), s;
+    exp(-x, s);
+    s = x + 1.f / (1.f + s);
+    Mat ref(s.size(), CV_32F);
+    for (int i = 0; i < s.rows; i++)
+    {
+        Scalar mean, stddev;
+        meanStdDev(s.row(i), mean, stddev);
+        Mat row = (s.row(i) - mean[0]) / std::sqrt(stddev[0] * stddev[0] + epsilon);
+        ref.row(i) = row.mul(scale.t()) + bias.t();
+    }
+    ref = ref.reshape(1, 3, &inputShape[0]);
+
+    net.enableFusion(false);
+    net.setInput(input);
+    Mat outputReference = net.forward().clone();
+    normAssert(ref, outputReference, "without fusion", 1e-5, 1e-4);
+
+    net.enableFusion(true);
+    net.setInput(input);
+    Mat outputTest = net.forward().clone();
+    normAssert(ref, outputTest, "with fusion", 1e-5, 1e-4);
+
+    std::vector<double> timings;
+    net.getPerfProfile(timings);
+    EXPECT_EQ(timings[addId - 1], 0.0);  // residual is added by layer norm
+    EXPECT_NE(timings[normId - 1], 0.0);
+}
+
 }} // namespace
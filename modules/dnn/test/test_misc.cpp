@@ -615,6 +615,679 @@ TEST(Net, forwardAndRetrieve)
     normAssert(outBlobs[0][1], inp.rowRange(2, 4), "second part");
 }
 
+// data -> conv1 -> relu1 -> conv2 -> (+ relu1) -> pool -> fc -> softmax
+static Net createResidualTestNet(bool withClassifier = true)
+{
+    RNG& rng = theRNG();
+    Net net;
+
+    LayerParams conv1;
+    conv1.name = "conv1";
+    conv1.type = "Convolution";
+    conv1.set("kernel_size", 3);
+    conv1.set("pad", 1);
+    conv1.set("num_output", 8);
+    conv1.set("bias_term", true);
+    int w1sz[] = {8, 3, 3, 3};
+    conv1.blobs.push_back(Mat(4, w1sz, CV_32F));
+    conv1.blobs.push_back(Mat(1, 8, CV_32F));
+    LayerParams conv2 = conv1;
+    conv2.name = "conv2";
+    int w2sz[] = {8, 8, 3, 3};
+    conv2.blobs[0] = Mat(4, w2sz, CV_32F);
+    conv2.blobs[1] = Mat(1, 8, CV_32F);
+    for (int i = 0; i < 2; i++)
+    {
+        rng.fill(conv1.blobs[i], RNG::UNIFORM, -0.5, 0.5);
+        rng.fill(conv2.blobs[i], RNG::UNIFORM, -0.5, 0.5);
+    }
+
+    LayerParams relu1;
+    relu1.name = "relu1";
+    relu1.type = "ReLU";
+
+    LayerParams sum;
+    sum.name = "sum";
+    sum.type = "Eltwise";
+
+    LayerParams pool;
+    pool.name = "pool";
+    pool.type = "Pooling";
+    pool.set("pool", "max");
+    pool.set("kernel_size", 2);
+    pool.set("stride", 2);
+
+    LayerParams fc;
+    fc.name = "fc";
+    fc.type = "InnerProduct";
+    fc.set("num_output", 10);
+    fc.set("bias_term", true);
+    fc.blobs.push_back(Mat(10, 8*16*16, CV_32F));
+    fc.blobs.push_back(Mat(1, 10, CV_32F));
+    rng.fill(fc.blobs[0], RNG::UNIFORM, -0.01, 0.01);
+    rng.fill(fc.blobs[1], RNG::UNIFORM, -0.5, 0.5);
+
+    LayerParams softmax;
+    softmax.name = "softmax";
+    softmax.type = "Softmax";
+
+    int conv1Id = net.addLayerToPrev(conv1.name, conv1.type, conv1);
+    int relu1Id = net.addLayerToPrev(relu1.name, relu1.type, relu1);
+    net.addLayerToPrev(conv2.name, conv2.type, conv2);
+    int sumId = net.addLayerToPrev(sum.name, sum.type, sum);
+    net.connect(relu1Id, 0, sumId, 1);
+    net.addLayerToPrev(pool.name, pool.type, pool);
+    if (withClassifier)
+    {
+        net.addLayerToPrev(fc.name, fc.type, fc);
+        net.addLayerToPrev(softmax.name, softmax.type, softmax);
+    }
+    CV_Assert(conv1Id > 0);
+    return net;
+}
+
+TEST(Net, execution_contexts)
+{
+    const int N = 4;
+    Net net = createResidualTestNet();
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    int inpsz[] = {1, 3, 32, 32};
+    std::vector<Mat> inputs(N), refs(N), outs(N);
+    for (int i = 0; i < N; i++)
+    {
+        inputs[i].create(4, inpsz, CV_32F);
+        randu(inputs[i], -1, 1);
+        net.setInput(inputs[i]);
+        refs[i] = net.forward().clone();
+    }
+
+    std::vector<Net> contexts(N);
+    for (int i = 0; i < N; i++)
+        contexts[i] = net.createExecutionContext();
+
+    parallel_for_(Range(0, N), [&](const Range& r)
+    {
+        for (int i = r.start; i < r.end; i++)
+        {
+            for (int iter = 0; iter < 10; iter++)
+            {
+                contexts[i].setInput(inputs[(i + iter) % N]);
+                outs[(i + iter) % N] = contexts[i].forward().clone();
+            }
+        }
+    }, N);
+    for (int i = 0; i < N; i++)
+        normAssert(refs[i], outs[i], format("context %d", i).c_str());
+
+    // the base network is not affected by the contexts
+    net.setInput(inputs[1]);
+    normAssert(refs[1], net.forward(), "base network");
+
+    // a context of a context shares the base network
+    Net ctx2 = contexts[0].createExecutionContext();
+    ctx2.setInput(inputs[2]);
+    normAssert(refs[2], ctx2.forward(), "nested context");
+
+    int othersz[] = {1, 3, 16, 16};
+    Mat other(4, othersz, CV_32F, Scalar(0));
+    EXPECT_THROW(contexts[0].setInput(other), cv::Exception);
+    EXPECT_THROW(contexts[0].setPreferableTarget(DNN_TARGET_CPU_FP16), cv::Exception);
+    EXPECT_THROW(contexts[0].forward("conv2"), cv::Exception);
+}
+
+TEST(Net, save_compiled)
+{
+    Net net = createResidualTestNet();
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    int inpsz[] = {1, 3, 32, 32};
+    Mat input(4, inpsz, CV_32F);
+    randu(input, -1, 1);
+
+    // before forward() the weights are not packed yet
+    const std::string unpackedPath = cv::tempfile(".ocvnet");
+    net.save(unpackedPath);
+    net.setInput(input);
+    Mat ref = net.forward().clone();
+    const std::string path = cv::tempfile(".ocvnet");
+    net.save(path);
+
+    const std::string paths[] = {unpackedPath, path};
+    for (int i = 0; i < 2; i++)
+    {
+        SCOPED_TRACE(paths[i]);
+        {
+            Net loaded = readNetFromCompiled(paths[i]);
+            ASSERT_FALSE(loaded.empty());
+            EXPECT_EQ(net.getLayerNames(), loaded.getLayerNames());
+            for (int iter = 0; iter < 2; iter++)
+            {
+                loaded.setInput(input);
+                EXPECT_EQ(0, cvtest::norm(ref, loaded.forward(), NORM_INF));
+            }
+        }
+        EXPECT_EQ(0, remove(paths[i].c_str()));
+    }
+
+    {
+        std::ofstream f(path.c_str(), std::ios::binary);
+        f << "OCVDNNCN";
+    }
+    EXPECT_THROW(readNetFromCompiled(path), cv::Exception);
+    EXPECT_EQ(0, remove(path.c_str()));
+}
+
+TEST(Net, plan_cache)
+{
+    Net net = createResidualTestNet(false);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    const int N = 3;
+    int inpsz[N][4] = { {1, 3, 32, 32}, {1, 3, 24, 40}, {2, 3, 16, 16} };
+    std::vector<Mat> inputs(N), refs(N);
+    for (int i = 0; i < N; i++)
+    {
+        inputs[i].create(4, inpsz[i], CV_32F);
+        randu(inputs[i], -1, 1);
+        net.setInput(inputs[i]);
+        refs[i] = net.forward().clone();
+    }
+
+    const int sequence[] = {0, 1, 0, 1, 2, 0, 2, 1, 1, 0};
+    const int nsteps = sizeof(sequence)/sizeof(sequence[0]);
+
+    net.setPlanCacheLimits(2);
+    std::vector<const uchar*> outData(N, (const uchar*)0);
+    for (int step = 0; step < nsteps; step++)
+    {
+        int i = sequence[step];
+        net.setInput(inputs[i]);
+        Mat out = net.forward();
+        normAssert(refs[i], out, format("step %d", step).c_str());
+        // the plan of the previous shape is still cached
+        if (step >= 2 && i == sequence[step - 2])
+        {
+            EXPECT_EQ(outData[i], out.data) << "step " << step;
+        }
+        outData[i] = out.data;
+    }
+
+    // nothing fits into the memory limit
+    net.setPlanCacheLimits(2, 1);
+    for (int step = 0; step < nsteps; step++)
+    {
+        int i = sequence[step];
+        net.setInput(inputs[i]);
+        normAssert(refs[i], net.forward(), format("step %d (memory limit)", step).c_str());
+    }
+
+    EXPECT_THROW(net.setPlanCacheLimits(-1), cv::Exception);
+}
+
+TEST(Net, memory_planner)
+{
+    // A chain of layers with the different output sizes: each blob lives
+    // only till its consumer, so the activations share one arena.
+    RNG& rng = theRNG();
+    Net net;
+    int inpCn = 3;
+    const int channels[] = {16, 32, 64, 8};
+    for (int i = 0; i < 4; i++)
+    {
+        LayerParams conv;
+        conv.name = format("conv%d", i);
+        conv.type = "Convolution";
+        conv.set("kernel_size", 3);
+        conv.set("pad", 1);
+        conv.set("num_output", channels[i]);
+        conv.set("bias_term", false);
+        int wsz[] = {channels[i], inpCn, 3, 3};
+        conv.blobs.push_back(Mat(4, wsz, CV_32F));
+        rng.fill(conv.blobs[0], RNG::UNIFORM, -0.3, 0.3);
+        net.addLayerToPrev(conv.name, conv.type, conv);
+        inpCn = channels[i];
+
+        LayerParams relu;
+        relu.name = format("relu%d", i);
+        relu.type = "ReLU";
+        net.addLayerToPrev(relu.name, relu.type, relu);
+
+        if (i < 3)
+        {
+            LayerParams pool;
+            pool.name = format("pool%d", i);
+            pool.type = "Pooling";
+            pool.set("pool", "max");
+            pool.set("kernel_size", 2);
+            pool.set("stride", 2);
+            net.addLayerToPrev(pool.name, pool.type, pool);
+        }
+    }
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    MatShape inpShape = {1, 3, 64, 64};
+    size_t weights = 0, planned = 0;
+    net.getMemoryConsumption(inpShape, weights, planned);
+    std::vector<int> layerIds;
+    std::vector<size_t> layerWeights, layerBlobs;
+    net.getMemoryConsumption(inpShape, layerIds, layerWeights, layerBlobs);
+    size_t allBlobs = 0, maxBlob = 0;
+    for (size_t i = 0; i < layerBlobs.size(); i++)
+    {
+        allBlobs += layerBlobs[i];
+        maxBlob = std::max(maxBlob, layerBlobs[i]);
+    }
+    EXPECT_GE(planned, maxBlob);
+    EXPECT_LT(planned, allBlobs * 7 / 10) << "all blobs: " << allBlobs;
+
+    Mat inp(inpShape, CV_32F);
+    randu(inp, -1, 1);
+    net.setInput(inp);
+    Mat out = net.forward().clone();
+
+    // reference: all the intermediate blobs are kept
+    std::vector<String> names = net.getLayerNames();
+    std::vector<Mat> outs;
+    net.setInput(inp);
+    net.forward(outs, names);
+    normAssert(outs.back(), out);
+}
+
+TEST(Net, forwardAsync_CPU)
+{
+    Net net = createResidualTestNet(false);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    const int N = 7;
+    std::vector<Mat> inputs(N), refs(N);
+    for (int i = 0; i < N; i++)
+    {
+        // the last requests change the input shape
+        int inpsz[] = {1, 3, i < 5 ? 32 : 24, 32};
+        inputs[i].create(4, inpsz, CV_32F);
+        randu(inputs[i], -1, 1);
+        net.setInput(inputs[i]);
+        refs[i] = net.forward().clone();
+    }
+
+    net.setAsyncQueueDepth(3);
+    std::vector<AsyncArray> futures(N);
+    for (int i = 0; i < N; i++)
+    {
+        net.setInput(inputs[i]);
+        futures[i] = net.forwardAsync();
+    }
+    for (int i = 0; i < N; i++)
+    {
+        Mat out;
+        futures[i].get(out);
+        normAssert(refs[i], out, format("request %d", i).c_str());
+    }
+
+    // the synchronous forward is not affected by the requests
+    net.setInput(inputs[6]);
+    AsyncArray future = net.forwardAsync();
+    net.setInput(inputs[5]);
+    normAssert(refs[5], net.forward(), "forward");
+    Mat out;
+    future.get(out);
+    normAssert(refs[6], out, "forwardAsync");
+
+    EXPECT_THROW(net.setAsyncQueueDepth(0), cv::Exception);
+}
+
+// Inception-like block: four branches of the different depth joined by concat
+static Net createBranchyTestNet()
+{
+    RNG& rng = theRNG();
+    Net net;
+    const int kernels[] = {1, 3, 5, 1};
+    const int channels[] = {8, 8, 4, 4};
+    std::vector<int> branchIds;
+    for (int b = 0; b < 4; b++)
+    {
+        int prevId = 0;
+        if (b == 3)
+        {
+            LayerParams pool;
+            pool.name = "b3_pool";
+            pool.type = "Pooling";
+            pool.set("pool", "max");
+            pool.set("kernel_size", 3);
+            pool.set("stride", 1);
+            pool.set("pad", 1);
+            prevId = net.addLayer(pool.name, pool.type, pool);
+            net.connect(0, 0, prevId, 0);
+        }
+        for (int i = 0; i < (b == 1 ? 2 : 1); i++)
+        {
+            int inpCn = i == 0 ? 3 : channels[b];
+            LayerParams conv;
+            conv.name = format("b%d_conv%d", b, i);
+            conv.type = "Convolution";
+            conv.set("kernel_size", kernels[b]);
+            conv.set("pad", kernels[b] / 2);
+            conv.set("num_output", channels[b]);
+            conv.set("bias_term", true);
+            int wsz[] = {channels[b], inpCn, kernels[b], kernels[b]};
+            conv.blobs.push_back(Mat(4, wsz, CV_32F));
+            conv.blobs.push_back(Mat(1, channels[b], CV_32F));
+            rng.fill(conv.blobs[0], RNG::UNIFORM, -0.3, 0.3);
+            rng.fill(conv.blobs[1], RNG::UNIFORM, -0.3, 0.3);
+            int convId = net.addLayer(conv.name, conv.type, conv);
+            net.connect(prevId, 0, convId, 0);
+
+            LayerParams relu;
+            relu.name = format("b%d_relu%d", b, i);
+            relu.type = "ReLU";
+            prevId = net.addLayerToPrev(relu.name, relu.type, relu);
+        }
+        branchIds.push_back(prevId);
+    }
+
+    LayerParams concat;
+    concat.name = "concat";
+    concat.type = "Concat";
+    concat.set("axis", 1);
+    int concatId = net.addLayer(concat.name, concat.type, concat);
+    for (int b = 0; b < 4; b++)
+        net.connect(branchIds[b], 0, concatId, b);
+
+    LayerParams conv;
+    conv.name = "out_conv";
+    conv.type = "Convolution";
+    conv.set("kernel_size", 1);
+    conv.set("num_output", 6);
+    conv.set("bias_term", false);
+    int wsz[] = {6, 24, 1, 1};
+    conv.blobs.push_back(Mat(4, wsz, CV_32F));
+    rng.fill(conv.blobs[0], RNG::UNIFORM, -0.3, 0.3);
+    net.addLayerToPrev(conv.name, conv.type, conv);
+    return net;
+}
+
+TEST(Net, inter_layer_parallelism)
+{
+    Net net = createBranchyTestNet();
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    const int N = 3;
+    std::vector<Mat> inputs(N), refs(N);
+    std::vector<std::vector<Mat> > refBranches(N);
+    std::vector<String> branchNames = {"b1_relu1", "b3_relu0", "out_conv"};
+    for (int i = 0; i < N; i++)
+    {
+        int inpsz[] = {1, 3, 24 + 8 * i, 32};
+        inputs[i].create(4, inpsz, CV_32F);
+        randu(inputs[i], -1, 1);
+        net.setInput(inputs[i]);
+        refs[i] = net.forward().clone();
+        net.setInput(inputs[i]);
+        net.forward(refBranches[i], branchNames);
+        for (size_t j = 0; j < refBranches[i].size(); j++)
+            refBranches[i][j] = refBranches[i][j].clone();  // the outputs share the memory of the network
+    }
+
+    net.enableInterLayerParallelism(true);
+    for (int iter = 0; iter < 2; iter++)
+    {
+        for (int i = 0; i < N; i++)
+        {
+            SCOPED_TRACE(cv::format("iter=%d input=%d", iter, i));
+            net.setInput(inputs[i]);
+            Mat out = net.forward();
+            EXPECT_EQ(0, cvtest::norm(refs[i], out, NORM_INF));
+
+            std::vector<Mat> branches;
+            net.setInput(inputs[i]);
+            net.forward(branches, branchNames);
+            ASSERT_EQ(refBranches[i].size(), branches.size());
+            for (size_t j = 0; j < branches.size(); j++)
+                EXPECT_EQ(0, cvtest::norm(refBranches[i][j], branches[j], NORM_INF)) << branchNames[j];
+        }
+    }
+
+    net.enableInterLayerParallelism(false);
+    net.setInput(inputs[0]);
+    EXPECT_EQ(0, cvtest::norm(refs[0], net.forward(), NORM_INF));
+}
+
+// data -> fc (+ relu) -> gemm (constant transposed B) -> matmul (constant batched B)
+TEST(Net, weights_compression)
+{
+    RNG& rng = theRNG();
+    Net net;
+
+    LayerParams fc;
+    fc.set("num_output", 70);
+    fc.set("bias_term", true);
+    fc.blobs.push_back(Mat(70, 300, CV_32F));
+    fc.blobs.push_back(Mat(1, 70, CV_32F));
+    rng.fill(fc.blobs[0], RNG::UNIFORM, -0.1, 0.1);
+    rng.fill(fc.blobs[1], RNG::UNIFORM, -0.5, 0.5);
+
+    LayerParams gemm;
+    gemm.set("transB", true);
+    gemm.set("constB", true);
+    gemm.blobs.push_back(Mat(40, 70, CV_32F));
+    rng.fill(gemm.blobs[0], RNG::UNIFORM, -0.5, 0.5);
+
+    LayerParams matmul;
+    int bsz[] = {2, 40, 30};
+    matmul.blobs.push_back(Mat(3, bsz, CV_32F));
+    rng.fill(matmul.blobs[0], RNG::UNIFORM, -0.5, 0.5);
+
+    LayerParams relu;
+    net.addLayerToPrev("fc", "InnerProduct", fc);
+    net.addLayerToPrev("relu", "ReLU", relu);
+    net.addLayerToPrev("gemm", "Gemm", gemm);
+    net.addLayerToPrev("matmul", "MatMul", matmul);
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+
+    Mat inp(5, 300, CV_32F);
+    randu(inp, -1, 1);
+    net.setInput(inp);
+    Mat ref = net.forward().clone();
+    ASSERT_EQ(3, ref.dims);
+    const double refNorm = cvtest::norm(ref, NORM_INF);
+
+    const int types[] = {CV_16F, CV_8S};
+    const double tolerances[] = {1e-3, 2e-2};  // relative to the max output
+    for (int i = 0; i < 2; i++)
+    {
+        SCOPED_TRACE(types[i] == CV_8S ? "CV_8S" : "CV_16F");
+        net.setWeightsCompression(types[i]);
+        for (int iter = 0; iter < 2; iter++)
+        {
+            net.setInput(inp);
+            Mat out = net.forward();
+            ASSERT_EQ(ref.size, out.size);
+            EXPECT_LE(cvtest::norm(ref, out, NORM_INF), tolerances[i] * refNorm);
+            EXPECT_GT(cvtest::norm(ref, out, NORM_INF), 0);  // the weights are really compressed
+        }
+    }
+
+    net.setWeightsCompression(CV_32F);
+    net.setInput(inp);
+    EXPECT_EQ(0, cvtest::norm(ref, net.forward(), NORM_INF));
+    EXPECT_ANY_THROW(net.setWeightsCompression(CV_8U));
+}
+
+TEST(Net, cpu_fp16_target)
+{
+    Net net = createResidualTestNet();
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    net.enableWinograd(false);  // the generic convolution branch
+
+    int inpsz[] = {2, 3, 32, 32};
+    Mat inp(4, inpsz, CV_32F);
+    randu(inp, -1, 1);
+    std::vector<String> outNames = {"pool", "fc"};
+    std::vector<Mat> refs, outs;
+    net.setInput(inp);
+    net.forward(refs, outNames);
+
+    net.setPreferableTarget(DNN_TARGET_CPU_FP16);
+    net.setInput(inp);
+    net.forward(outs, outNames);
+    ASSERT_EQ(refs.size(), outs.size());
+    for (size_t i = 0; i < refs.size(); i++)
+    {
+        normAssert(refs[i], outs[i], outNames[i].c_str(), 1e-3, 1e-2);
+#if !defined(__arm64__) || !__arm64__
+        // FP16 weights and FP32 arithmetic, still not the same results
+        EXPECT_GT(cvtest::norm(refs[i], outs[i], NORM_INF), 0) << outNames[i];
+#endif
+    }
+
+    // the explicit compression of the FC weights takes the priority
+    net.setWeightsCompression(CV_8S);
+    net.setInput(inp);
+    net.forward(outs, outNames);
+    normAssert(refs[0], outs[0], "pool", 1e-3, 1e-2);
+    normAssert(refs[1], outs[1], "fc", 1e-2, 5e-2);
+}
+
+TEST(Net, profiling)
+{
+    Net net = createResidualTestNet();
+    net.setPreferableBackend(DNN_BACKEND_OPENCV);
+    EXPECT_ANY_THROW(net.dumpProfile());
+
+    int inpsz[] = {1, 3, 32, 32};
+    Mat inp(4, inpsz, CV_32F);
+    randu(inp, -1, 1);
+    net.setInput(inp);
+    net.enableProfiling(true);
+    const int numRuns = 3;
+    for (int i = 0; i < numRuns; i++)
+        net.forward();
+
+    FileStorage fs(net.dumpProfile("json"), FileStorage::READ | FileStorage::MEMORY | FileStorage::FORMAT_JSON);
+    FileNode layers = fs["layers"];
+    ASSERT_EQ(7u, layers.size());
+    std::map<std::string, FileNode> byName;
+    for (FileNodeIterator it = layers.begin(); it != layers.end(); ++it)
+        byName[(std::string)(*it)["name"]] = *it;
+
+    // ReLU is fused into the convolution, which accounts its FLOPs
+    FileNode relu = byName["relu1"], conv = byName["conv1"];
+    EXPECT_EQ("conv1", (std::string)relu["fused_into"]);
+    EXPECT_EQ(0, (int)relu["calls"]);
+    EXPECT_EQ(0, (double)relu["flops"]);
+    ASSERT_EQ(1u, conv["fused"].size());
+    EXPECT_EQ("relu1", (std::string)conv["fused"][0]);
+    EXPECT_FALSE(((std::string)conv["kernel"]).empty());
+    EXPECT_EQ(numRuns, (int)conv["calls"]);
+    EXPECT_EQ(2 * 32 * 32 * 8 * 27 + 32 * 32 * 8, (double)conv["flops"] - 32 * 32 * 8 /*ReLU*/);
+    EXPECT_EQ(32 * 32 * (3 + 8) * 4 + (8 * 27 + 8) * 4, (double)conv["bytes_read"] + (double)conv["bytes_written"]);
+    EXPECT_GT((double)conv["time_ms"], 0);
+    EXPECT_LE((double)conv["min_time_ms"], (double)conv["time_ms"]);
+    EXPECT_GT((double)conv["gflops_per_sec"], 0);
+    EXPECT_GT((double)conv["flops_per_byte"], 0);
+
+    std::string csv = net.dumpProfile("csv");
+    EXPECT_EQ(0u, csv.find("id,name,type,kernel,fused_into,fused,calls,"));
+    EXPECT_EQ(8, (int)std::count(csv.begin(), csv.end(), '\n'));
+    EXPECT_ANY_THROW(net.dumpProfile("xml"));
+
+    // enableProfiling() resets the profile
+    net.enableProfiling(true);
+    net.forward();
+    fs.open(net.dumpProfile(), FileStorage::READ | FileStorage::MEMORY | FileStorage::FORMAT_JSON);
+    EXPECT_EQ(1, (int)fs["layers"][0]["calls"]);
+}
+
+TEST(BatchingModel, classify)
+{
+    const int N = 16;
+    ClassificationModel model(createResidualTestNet());
+    model.setPreferableBackend(DNN_BACKEND_OPENCV);
+    model.setInputParams(1.0 / 255, Size(32, 32));
+
+    std::vector<Mat> frames(N);
+    std::vector<std::pair<int, float> > refs(N);
+    for (int i = 0; i < N; i++)
+    {
+        frames[i].create(32 + i % 3 * 8, 32 + i % 2 * 8, CV_8UC3);  // resized to the input size
+        randu(frames[i], 0, 256);
+        refs[i] = model.classify(frames[i]);
+    }
+
+    BatchingModel::Params params;
+    params.maxBatchSize = 4;
+    params.maxDelay = 50;
+    BatchingModel batching(model, params);
+
+    const int numStreams = 4;
+    std::vector<std::future<std::pair<int, float> > > results(N);
+    parallel_for_(Range(0, numStreams), [&](const Range& r)
+    {
+        for (int stream = r.start; stream < r.end; stream++)
+            for (int i = stream; i < N; i += numStreams)
+                results[i] = batching.classify(frames[i]);
+    }, numStreams);
+
+    for (int i = 0; i < N; i++)
+    {
+        std::pair<int, float> res = results[i].get();
+        EXPECT_EQ(refs[i].first, res.first) << i;
+        EXPECT_NEAR(refs[i].second, res.second, 1e-5) << i;
+    }
+
+    BatchingModel::Statistics stats = batching.getStatistics();
+    EXPECT_EQ((size_t)N, stats.numRequests);
+    EXPECT_GE(stats.numBatches, (size_t)N / params.maxBatchSize);
+    EXPECT_LE(stats.avgBatchSize, (double)params.maxBatchSize);
+    EXPECT_EQ((size_t)0, stats.queueDepth);
+    EXPECT_GE(stats.maxQueueDepth, (size_t)1);
+    EXPECT_GE(stats.avgLatency, stats.avgQueueWait);
+    EXPECT_GE(stats.maxLatency, stats.avgLatency);
+
+    batching.resetStatistics();
+    EXPECT_EQ((size_t)0, batching.getStatistics().numRequests);
+
+    // the postprocessing of the other models is not available
+    EXPECT_ANY_THROW(batching.detect(frames[0]));
+}
+
+TEST(BatchingModel, predict_padBatch)
+{
+    const int N = 5;
+    Model model(createResidualTestNet(false));
+    model.setPreferableBackend(DNN_BACKEND_OPENCV);
+    model.setInputParams(1.0 / 255, Size(32, 32), Scalar(), true);
+
+    std::vector<Mat> frames(N), refs(N);
+    for (int i = 0; i < N; i++)
+    {
+        frames[i].create(32, 32, CV_8UC3);
+        randu(frames[i], 0, 256);
+        std::vector<Mat> outs;
+        model.predict(frames[i], outs);
+        ASSERT_EQ((size_t)1, outs.size());
+        refs[i] = outs[0].clone();
+    }
+
+    BatchingModel::Params params;
+    params.maxBatchSize = 3;
+    params.maxDelay = 10;
+    params.padBatch = true;
+    BatchingModel batching(model, params);
+
+    std::vector<std::future<std::vector<Mat> > > results;
+    for (int i = 0; i < N; i++)
+        results.push_back(batching.predict(frames[i]));
+    for (int i = 0; i < N; i++)
+    {
+        std::vector<Mat> outs = results[i].get();
+        ASSERT_EQ((size_t)1, outs.size());
+        EXPECT_TRUE(refs[i].size == outs[0].size) << i;
+        normAssert(refs[i], outs[0], format("frame %d", i).c_str());
+    }
+}
+
 #ifdef HAVE_INF_ENGINE
 static const std::chrono::milliseconds async_timeout(10000);
 
@@ -104,4 +104,150 @@ TEST(SoftNMS, Accuracy)
     }
 }
 
+static void generateNMSData(RNG& rng, int N, int C, Mat& boxes, Mat& scores, std::vector<Rect2d>& rects)
+{
+    boxes.create(N, 4, CV_32F);
+    scores.create(N, C, CV_32F);
+    rects.resize(N);
+    for (int i = 0; i < N; i++)
+    {
+        // integer coordinates, so the overlaps are computed exactly both in float and in double
+        int x = rng.uniform(0, 300), y = rng.uniform(0, 300);
+        int w = rng.uniform(10, 60), h = rng.uniform(10, 60);
+        rects[i] = Rect2d(x, y, w, h);
+        float* b = boxes.ptr<float>(i);
+        b[0] = (float)x; b[1] = (float)y; b[2] = (float)w; b[3] = (float)h;
+    }
+    rng.fill(scores, RNG::UNIFORM, 0.f, 1.f);
+}
+
+typedef std::vector<std::pair<int, int> > ClassIndices;
+
+static ClassIndices sortedPairs(const std::vector<int>& class_ids, const std::vector<int>& indices)
+{
+    ClassIndices res;
+    for (size_t i = 0; i < indices.size(); i++)
+        res.push_back(std::make_pair(class_ids[i], indices[i]));
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+TEST(MultiClassNMS, Accuracy)
+{
+    RNG& rng = TS::ptr()->get_rng();
+    const int N = 1500, C = 7;
+    const float score_thresh = .3f, nms_thresh = .5f;
+    Mat boxes, scores;
+    std::vector<Rect2d> rects;
+    generateNMSData(rng, N, C, boxes, scores, rects);
+
+    // the best class of each box
+    std::vector<float> best_scores(N);
+    std::vector<int> best_ids(N);
+    for (int i = 0; i < N; i++)
+    {
+        Point maxLoc;
+        double maxVal;
+        minMaxLoc(scores.row(i), 0, &maxVal, 0, &maxLoc);
+        best_scores[i] = (float)maxVal;
+        best_ids[i] = maxLoc.x;
+    }
+    std::vector<int> ref_indices, ref_class_ids;
+    cv::dnn::NMSBoxesBatched(rects, best_scores, best_ids, score_thresh, nms_thresh, ref_indices);
+    for (size_t i = 0; i < ref_indices.size(); i++)
+        ref_class_ids.push_back(best_ids[ref_indices[i]]);
+
+    std::vector<int> indices, class_ids;
+    cv::dnn::NMSBoxesMultiClass(boxes, scores, score_thresh, nms_thresh, indices, class_ids);
+    ASSERT_EQ(indices.size(), class_ids.size());
+    EXPECT_EQ(sortedPairs(ref_class_ids, ref_indices), sortedPairs(class_ids, indices));
+    for (size_t i = 1; i < indices.size(); i++)
+        EXPECT_GE(scores.at<float>(indices[i - 1], class_ids[i - 1]), scores.at<float>(indices[i], class_ids[i]));
+
+    // boxes followed by the scores in one [1 x N x (4+C)] blob
+    Mat blob;
+    hconcat(boxes, scores, blob);
+    int blobShape[] = {1, N, 4 + C};
+    std::vector<int> indices2, class_ids2;
+    cv::dnn::NMSBoxesMultiClass(blob.reshape(1, 3, blobShape), noArray(), score_thresh, nms_thresh, indices2, class_ids2);
+    EXPECT_EQ(indices, indices2);
+    EXPECT_EQ(class_ids, class_ids2);
+
+    // each class separately
+    ref_indices.clear();
+    ref_class_ids.clear();
+    for (int c = 0; c < C; c++)
+    {
+        std::vector<float> class_scores;
+        scores.col(c).copyTo(class_scores);
+        std::vector<int> idx;
+        cv::dnn::NMSBoxes(rects, class_scores, score_thresh, nms_thresh, idx);
+        ref_indices.insert(ref_indices.end(), idx.begin(), idx.end());
+        ref_class_ids.resize(ref_indices.size(), c);
+    }
+    cv::dnn::NMSBoxesMultiClass(boxes, scores, score_thresh, nms_thresh, indices, class_ids, 1.f, 0, true);
+    EXPECT_EQ(sortedPairs(ref_class_ids, ref_indices), sortedPairs(class_ids, indices));
+}
+
+TEST(MultiClassNMS, Rotated)
+{
+    RNG& rng = TS::ptr()->get_rng();
+    const int N = 500, C = 3;
+    const float score_thresh = .2f, nms_thresh = .4f;
+    Mat boxes(N, 5, CV_32F), scores(N, C, CV_32F);
+    std::vector<RotatedRect> rects(N);
+    for (int i = 0; i < N; i++)
+    {
+        rects[i] = RotatedRect(Point2f(rng.uniform(0.f, 200.f), rng.uniform(0.f, 200.f)),
+                               Size2f(rng.uniform(10.f, 50.f), rng.uniform(10.f, 50.f)), rng.uniform(-90.f, 90.f));
+        float* b = boxes.ptr<float>(i);
+        b[0] = rects[i].center.x; b[1] = rects[i].center.y;
+        b[2] = rects[i].size.width; b[3] = rects[i].size.height; b[4] = rects[i].angle;
+    }
+    rng.fill(scores, RNG::UNIFORM, 0.f, 1.f);
+
+    std::vector<int> ref_indices, ref_class_ids;
+    for (int c = 0; c < C; c++)
+    {
+        std::vector<float> class_scores;
+        scores.col(c).copyTo(class_scores);
+        std::vector<int> idx;
+        cv::dnn::NMSBoxes(rects, class_scores, score_thresh, nms_thresh, idx);
+        ref_indices.insert(ref_indices.end(), idx.begin(), idx.end());
+        ref_class_ids.resize(ref_indices.size(), c);
+    }
+    std::vector<int> indices, class_ids;
+    cv::dnn::NMSBoxesMultiClass(boxes, scores, score_thresh, nms_thresh, indices, class_ids, 1.f, 0, true);
+    EXPECT_EQ(sortedPairs(ref_class_ids, ref_indices), sortedPairs(class_ids, indices));
+}
+
+TEST(MultiClassNMS, Soft)
+{
+    RNG& rng = TS::ptr()->get_rng();
+    const int N = 300;
+    const float score_thresh = .1f, nms_thresh = .5f, sigma = .5f;
+    Mat boxes, scores;
+    std::vector<Rect2d> rects2d;
+    generateNMSData(rng, N, 1, boxes, scores, rects2d);
+    std::vector<Rect> rects(rects2d.begin(), rects2d.end());
+    std::vector<float> scores_vec;
+    scores.copyTo(scores_vec);
+
+    for (int method = 1; method <= 2; method++)
+    {
+        SCOPED_TRACE(method);
+        std::vector<int> ref_indices, indices, class_ids;
+        std::vector<float> ref_scores, updated_scores;
+        cv::dnn::softNMSBoxes(rects, scores_vec, ref_scores, score_thresh, nms_thresh, ref_indices,
+                              0, sigma, (cv::dnn::SoftNMSMethod)method);
+        cv::dnn::softNMSBoxesMultiClass(boxes, scores, updated_scores, score_thresh, nms_thresh, indices, class_ids,
+                                        0, sigma, (cv::dnn::SoftNMSMethod)method);
+        EXPECT_EQ(ref_indices, indices);
+        ASSERT_EQ(ref_scores.size(), updated_scores.size());
+        for (size_t i = 0; i < updated_scores.size(); i++)
+            EXPECT_NEAR(ref_scores[i], updated_scores[i], 1e-5);
+        EXPECT_EQ(std::vector<int>(indices.size(), 0), class_ids);
+    }
+}
+
 }} // namespace
@@ -3108,4 +3108,130 @@ TEST_P(Test_ONNX_layers, ClipDivSharedConstant) {
 
 INSTANTIATE_TEST_CASE_P(/**/, Test_ONNX_nets, dnnBackendsAndTargets());
 
+// Protobuf wire format writer for the models built in the tests
+static void pbVarint(std::string& s, uint64_t v)
+{
+    for (; v >= 0x80; v >>= 7)
+        s += (char)(v | 0x80);
+    s += (char)v;
+}
+static void pbField(std::string& s, int field, uint64_t v)
+{
+    pbVarint(s, (uint64_t)field << 3);
+    pbVarint(s, v);
+}
+static void pbField(std::string& s, int field, const std::string& bytes)
+{
+    pbVarint(s, ((uint64_t)field << 3) | 2);
+    pbVarint(s, bytes.size());
+    s += bytes;
+}
+
+static std::string onnxValueInfo(const std::string& name, const std::vector<int>& shape)
+{
+    std::string dims, tensorType, type, info;
+    for (size_t i = 0; i < shape.size(); i++)
+    {
+        std::string dim;
+        pbField(dim, 1, (uint64_t)shape[i]);  // dim_value
+        pbField(dims, 1, dim);
+    }
+    pbField(tensorType, 1, (uint64_t)1);  // elem_type = FLOAT
+    pbField(tensorType, 2, dims);  // shape
+    pbField(type, 1, tensorType);
+    pbField(info, 1, name);
+    pbField(info, 2, type);
+    return info;
+}
+
+static std::string onnxExternalTensor(const std::string& name, const std::vector<int>& shape,
+                                      const std::string& location, size_t offset, size_t length)
+{
+    std::string tensor;
+    for (size_t i = 0; i < shape.size(); i++)
+        pbField(tensor, 1, (uint64_t)shape[i]);  // dims
+    pbField(tensor, 2, (uint64_t)1);  // data_type = FLOAT
+    pbField(tensor, 8, name);
+    const char* keys[] = {"location", "offset", "length"};
+    const std::string values[] = {location, std::to_string(offset), std::to_string(length)};
+    for (int i = 0; i < 3; i++)
+    {
+        std::string entry;
+        pbField(entry, 1, std::string(keys[i]));
+        pbField(entry, 2, values[i]);
+        pbField(tensor, 13, entry);  // external_data
+    }
+    pbField(tensor, 14, (uint64_t)1);  // data_location = EXTERNAL
+    return tensor;
+}
+
+static std::string onnxNode(const std::string& type, const std::vector<std::string>& inputs, const std::string& output)
+{
+    std::string node;
+    for (size_t i = 0; i < inputs.size(); i++)
+        pbField(node, 1, inputs[i]);
+    pbField(node, 2, output);
+    pbField(node, 3, output);
+    pbField(node, 4, type);
+    return node;
+}
+
+TEST(Test_ONNX_importer, external_data)
+{
+    // Y = X * W + B, W and B are stored in the external data file
+    const int K = 64, N = 32;
+    Mat x(2, K, CV_32F), w(K, N, CV_32F), b(1, N, CV_32F);
+    randu(x, -1, 1);
+    randu(w, -1, 1);
+    randu(b, -1, 1);
+
+    const std::string modelPath = cv::tempfile(".onnx");
+    const std::string dataPath = modelPath + ".data";
+    const std::string location = dataPath.substr(dataPath.find_last_of("/\\") + 1);
+
+    const size_t wOffset = 16, wSize = w.total() * w.elemSize();
+    const size_t bOffset = wOffset + wSize, bSize = b.total() * b.elemSize();
+    {
+        std::ofstream data(dataPath.c_str(), std::ios::binary);
+        data.write(std::string(wOffset, '\0').data(), wOffset);
+        data.write((const char*)w.data, wSize);
+        data.write((const char*)b.data, bSize);
+        ASSERT_TRUE(data.good());
+    }
+
+    std::string graph, opset, model;
+    pbField(graph, 1, onnxNode("MatMul", {"x", "w"}, "xw"));
+    pbField(graph, 1, onnxNode("Add", {"xw", "b"}, "y"));
+    pbField(graph, 2, std::string("external_data"));
+    pbField(graph, 5, onnxExternalTensor("w", {K, N}, location, wOffset, wSize));
+    pbField(graph, 5, onnxExternalTensor("b", {N}, location, bOffset, bSize));
+    pbField(graph, 11, onnxValueInfo("x", {2, K}));
+    pbField(graph, 12, onnxValueInfo("y", {2, N}));
+    pbField(opset, 2, (uint64_t)13);
+    pbField(model, 1, (uint64_t)7);  // ir_version
+    pbField(model, 7, graph);
+    pbField(model, 8, opset);
+    {
+        std::ofstream f(modelPath.c_str(), std::ios::binary);
+        f.write(model.data(), model.size());
+        ASSERT_TRUE(f.good());
+    }
+
+    Mat ref = x * w + repeat(b, 2, 1);
+    {
+        Net net = readNetFromONNX(modelPath);
+        net.setPreferableBackend(DNN_BACKEND_OPENCV);
+        net.setInput(x);
+        Mat out = net.forward();
+        normAssert(ref, out.reshape(1, 2), "", 1e-5, 1e-4);
+    }
+
+    // the location is relative to the model file
+    std::vector<uchar> buffer(model.begin(), model.end());
+    EXPECT_THROW(readNetFromONNX(buffer), cv::Exception);
+
+    EXPECT_EQ(0, remove(modelPath.c_str()));
+    EXPECT_EQ(0, remove(dataPath.c_str()));
+}
+
 }} // namespace
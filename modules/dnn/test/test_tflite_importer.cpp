@@ -251,6 +251,35 @@ TEST_P(Test_TFLite, fully_connected) {
     testLayer("fully_connected");
 }
 
+// The model file is mapped and the weights are shared with it, the result must match the model read to memory
+TEST_P(Test_TFLite, read_from_file_and_buffer) {
+    if (backend == DNN_BACKEND_VKCOM)
+        applyTestTag(CV_TEST_TAG_DNN_SKIP_VULKAN);
+    const std::string modelPath = findDataFile("dnn/tflite/fully_connected.tflite");
+    std::vector<uchar> buffer;
+    {
+        std::ifstream ifs(modelPath.c_str(), std::ios::in | std::ios::binary);
+        ASSERT_TRUE(ifs.is_open());
+        buffer.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+    }
+    Mat input = blobFromNPY(findDataFile("dnn/tflite/fully_connected_inp.npy"));
+
+    Net netFile = readNetFromTFLite(modelPath);
+    netFile.setPreferableBackend(backend);
+    netFile.setPreferableTarget(target);
+    netFile.setInput(input);
+    Mat outFile = netFile.forward();
+
+    Net netBuffer = readNetFromTFLite(buffer);
+    buffer.assign(buffer.size(), 0);  // the network must not refer to the buffer
+    netBuffer.setPreferableBackend(backend);
+    netBuffer.setPreferableTarget(target);
+    netBuffer.setInput(input);
+    Mat outBuffer = netBuffer.forward();
+
+    normAssert(outBuffer, outFile, "", 0, 0);
+}
+
 TEST_P(Test_TFLite, permute) {
     testLayer("permutation_3d");
     // Temporarily disabled as TFLiteConverter produces a incorrect graph in this case